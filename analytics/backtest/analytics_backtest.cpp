@@ -0,0 +1,122 @@
+// Replays recorded pool history through the production decision path and
+// reports the alerts it would have sent.
+//
+//   ./analytics_backtest                       last 7 days, summary on stdout
+//   ./analytics_backtest --days=30 --threads=16
+//   ./analytics_backtest --until-ms=<epoch ms> replay the days before this instant
+//   ./analytics_backtest --out=alerts.jsonl    one alert per line, with forward returns
+//   ./analytics_backtest --scoring-config=candidate.json
+//                                              score under a SCORING_CONFIG_PATH document
+//
+// Thresholds, cooldowns and the regime interval come from the service's own
+// environment (ACTIONABLE_BASE_THRESHOLD, COOLDOWN_*_HOURS, ...), so a
+// candidate configuration is evaluated by exporting it before the run.
+#include "backtest.hpp"
+#include "config.hpp"
+#include "pg_store.hpp"
+#include "util.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <fstream>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace {
+
+// Parallel COPY streams for loading history
+constexpr size_t kLoadConnections = 8;
+
+bool flag_value(const std::string& arg, const std::string& name, std::string& value) {
+    std::string prefix = "--" + name + "=";
+    if (arg.rfind(prefix, 0) != 0) return false;
+    value = arg.substr(prefix.size());
+    return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+    spdlog::set_level(spdlog::level::warn);
+
+    int days = 7;
+    int64_t until_ms = util::current_timestamp_ms();
+    size_t threads = std::max(1u, std::thread::hardware_concurrency());
+    std::string out_path;
+    std::string scoring_path;
+    try {
+        for (int i = 1; i < argc; i++) {
+            std::string arg = argv[i];
+            std::string value;
+            if (flag_value(arg, "days", value)) {
+                days = std::max(1, std::stoi(value));
+            } else if (flag_value(arg, "until-ms", value)) {
+                until_ms = std::stoll(value);
+            } else if (flag_value(arg, "threads", value)) {
+                threads = static_cast<size_t>(std::max(1, std::stoi(value)));
+            } else if (flag_value(arg, "out", value)) {
+                out_path = value;
+            } else if (flag_value(arg, "scoring-config", value)) {
+                scoring_path = value;
+            } else {
+                std::cerr << "Unknown argument: " << arg << "\n";
+                return 1;
+            }
+        }
+    } catch (const std::exception& e) {
+        std::cerr << "Invalid argument: " << e.what() << "\n";
+        return 1;
+    }
+
+    try {
+        Config config = Config::from_env();
+        config.validate();
+        auto scoring = ScoringConfig::from_config(config);
+        if (!scoring_path.empty()) {
+            auto text = ScoringConfigSource::read_file(scoring_path);
+            if (!text) {
+                spdlog::error("Failed to read {}", scoring_path);
+                return 1;
+            }
+            scoring = ScoringConfig::parse(*text, *scoring);
+        }
+
+        PostgresStore pg(config.pg_dsn);
+        std::vector<PoolInfo> pools;
+        std::vector<PoolStatRow> rows;
+        int64_t since_ms = until_ms - days * 24LL * 3600 * 1000;
+        if (!pg.load_pool_stats(since_ms, until_ms, std::min(threads, kLoadConnections), pools, rows)) {
+            spdlog::error("Failed to load pool history");
+            return 1;
+        }
+        spdlog::warn("Loaded {} pool stats rows over {} pools ({} to {})", rows.size(), pools.size(),
+                     util::iso8601(since_ms), util::iso8601(until_ms));
+
+        Backtester backtester(config, scoring, threads);
+        auto report = backtester.run(pools, rows);
+
+        if (!out_path.empty()) {
+            std::ofstream out(out_path);
+            for (const auto& a : report.alerts) {
+                nlohmann::json line = a.alert;
+                nlohmann::json returns = nlohmann::json::object();
+                for (size_t h = 0; h < report.horizons_ms.size(); h++) {
+                    returns[horizon_label(report.horizons_ms[h])] =
+                        a.returns[h] ? nlohmann::json(*a.returns[h]) : nlohmann::json();
+                }
+                line["forward_return_pct"] = returns;
+                out << line.dump() << "\n";
+            }
+            if (!out) {
+                spdlog::error("Failed to write {}", out_path);
+                return 1;
+            }
+        }
+
+        std::cout << report.summary().dump(2) << std::endl;
+    } catch (const std::exception& e) {
+        spdlog::error("Backtest failed: {}", e.what());
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,326 @@
+#include "backtest.hpp"
+#include "decision.hpp"
+#include "regime.hpp"
+#include "throttles.hpp"
+#include "util.hpp"
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+namespace {
+
+// Mints handed to a thread at a time within a step; the updated ones are
+// scored as one batch, at most as large as a service worker's
+constexpr size_t kStepChunk = ScoringPool::kScoreBatch;
+
+// Runs one task on every thread and waits for all of them. The helpers are
+// started once and reused, since a month replays in thousands of steps.
+class ForkJoin {
+public:
+    explicit ForkJoin(size_t threads) {
+        for (size_t t = 1; t < threads; t++) {
+            helpers_.emplace_back([this, t]() { loop(t); });
+        }
+    }
+
+    ~ForkJoin() {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            stop_ = true;
+            generation_++;
+        }
+        start_cv_.notify_all();
+        for (auto& helper : helpers_) {
+            helper.join();
+        }
+    }
+
+    // task(i) runs once on each of the threads, i = 0 on the caller
+    void run(const std::function<void(size_t)>& task) {
+        {
+            std::lock_guard<std::mutex> lock(mutex_);
+            task_ = &task;
+            pending_ = helpers_.size();
+            generation_++;
+        }
+        start_cv_.notify_all();
+        task(0);
+        std::unique_lock<std::mutex> lock(mutex_);
+        done_cv_.wait(lock, [this]() { return pending_ == 0; });
+    }
+
+private:
+    void loop(size_t index) {
+        uint64_t seen = 0;
+        while (true) {
+            const std::function<void(size_t)>* task;
+            {
+                std::unique_lock<std::mutex> lock(mutex_);
+                start_cv_.wait(lock, [&]() { return generation_ != seen; });
+                seen = generation_;
+                if (stop_) return;
+                task = task_;
+            }
+            (*task)(index);
+            std::lock_guard<std::mutex> lock(mutex_);
+            if (--pending_ == 0) done_cv_.notify_one();
+        }
+    }
+
+    std::vector<std::thread> helpers_;
+    std::mutex mutex_;
+    std::condition_variable start_cv_;
+    std::condition_variable done_cv_;
+    const std::function<void(size_t)>* task_ = nullptr;
+    uint64_t generation_ = 0;
+    size_t pending_ = 0;
+    bool stop_ = false;
+};
+
+// One mint's replay state. Only the thread that took the mint in the current
+// step touches it, and the main thread between steps.
+struct MintSlot {
+    MintConsolidator* source;
+    std::unique_ptr<TokenState> token;   // null until priced, and again once stale
+    bool updated = false;
+    size_t updates = 0;
+    ScoringResult result;
+    std::vector<size_t> open;            // alerts with unresolved horizons
+};
+
+const char* gate_name(AlertGate gate) {
+    switch (gate) {
+        case AlertGate::Cooldown: return "cooldown";
+        case AlertGate::ReentryGuard: return "reentry_guard";
+        case AlertGate::GlobalLimit: return "global_limit";
+        case AlertGate::Pass: break;
+    }
+    return "pass";
+}
+
+} // namespace
+
+std::string horizon_label(int64_t ms) {
+    if (ms % 3600000 == 0) return fmt::format("{}h", ms / 3600000);
+    return fmt::format("{}m", ms / 60000);
+}
+
+Backtester::Backtester(const Config& config, size_t threads,
+                       std::vector<int64_t> horizons_ms, int64_t step_ms)
+    : Backtester(config, ScoringConfig::from_config(config), threads, std::move(horizons_ms), step_ms) {}
+
+Backtester::Backtester(const Config& config, std::shared_ptr<const ScoringConfig> scoring,
+                       size_t threads, std::vector<int64_t> horizons_ms, int64_t step_ms)
+    : config_(config),
+      scoring_(std::move(scoring)),
+      threads_(std::max<size_t>(1, threads)),
+      horizons_ms_(std::move(horizons_ms)),
+      step_ms_(std::max<int64_t>(1, step_ms)) {}
+
+BacktestReport Backtester::run(const std::vector<PoolInfo>& pools,
+                               const std::vector<PoolStatRow>& rows) {
+    auto started = std::chrono::steady_clock::now();
+    BacktestReport report;
+    report.horizons_ms = horizons_ms_;
+
+    QuotePrices quotes;
+    auto mints = split_by_mint(pools, rows, threads_, quotes);
+    std::vector<MintSlot> slots(mints.size());
+    int64_t first_ts = std::numeric_limits<int64_t>::max();
+    int64_t last_ts = std::numeric_limits<int64_t>::min();
+    for (size_t i = 0; i < mints.size(); i++) {
+        slots[i].source = &mints[i];
+        first_ts = std::min(first_ts, mints[i].next_ts(rows));
+    }
+    for (const auto& row : rows) {
+        last_ts = std::max(last_ts, row.ts_ms);
+    }
+    report.mints = slots.size();
+    if (slots.empty()) return report;
+
+    RegimeDetector regime(config_.regime_refresh_sec * 1000LL);
+    int64_t now_ms = first_ts;
+    ThrottleManager throttles([&now_ms]() { return now_ms; });
+    auto& alerts = report.alerts;
+
+    std::atomic<size_t> next{0};
+    std::shared_ptr<const RegimeAssessment> assessment;
+    int64_t step_end = 0;
+
+    // Applies each mint's updates for the step, resolves the forward returns
+    // of its earlier alerts against them, then scores the updated mints of
+    // each chunk as one batch
+    auto step = [&](size_t) {
+        MarketData md;
+        std::vector<const TokenState*> batch;
+        std::vector<size_t> batch_slots;
+        std::vector<ScoringResult> scored;
+        for (size_t begin = next.fetch_add(kStepChunk); begin < slots.size();
+             begin = next.fetch_add(kStepChunk)) {
+            size_t end = std::min(begin + kStepChunk, slots.size());
+            batch.clear();
+            batch_slots.clear();
+            for (size_t i = begin; i < end; i++) {
+                auto& slot = slots[i];
+                slot.updated = false;
+                while (slot.source->next_ts(rows) < step_end) {
+                    if (!slot.source->next(pools, rows, quotes, md)) continue;
+                    if (!slot.token) {
+                        slot.token = std::make_unique<TokenState>();
+                        slot.token->mint = slot.source->mint();
+                        slot.token->symbol = slot.source->mint().substr(0, 8);
+                    }
+                    slot.token->update(md);
+                    slot.updated = true;
+                    slot.updates++;
+
+                    for (size_t k = 0; k < slot.open.size();) {
+                        auto& a = alerts[slot.open[k]];
+                        bool pending = false;
+                        for (size_t h = 0; h < horizons_ms_.size(); h++) {
+                            if (a.returns[h]) continue;
+                            if (md.ts_ms >= a.ts_ms + horizons_ms_[h]) {
+                                a.returns[h] = (md.price / a.price - 1.0) * 100.0;
+                            } else {
+                                pending = true;
+                            }
+                        }
+                        if (pending) {
+                            k++;
+                        } else {
+                            slot.open[k] = slot.open.back();
+                            slot.open.pop_back();
+                        }
+                    }
+                }
+                if (slot.updated) {
+                    batch.push_back(slot.token.get());
+                    batch_slots.push_back(i);
+                }
+            }
+            if (batch.empty()) continue;
+
+            try {
+                score_tokens(batch, *assessment, scoring_, scored);
+            } catch (const std::exception& e) {
+                spdlog::error("Scoring a batch of {} failed: {}", batch.size(), e.what());
+                scored.assign(batch.size(), ScoringResult{});
+                for (auto& r : scored) {
+                    r.band = "none";
+                }
+            }
+            for (size_t b = 0; b < batch_slots.size(); b++) {
+                auto& slot = slots[batch_slots[b]];
+                slot.result = std::move(scored[b]);
+                slot.result.mint = slot.source->mint();
+            }
+        }
+    };
+
+    ForkJoin workers(threads_);
+    int64_t last_cleanup_ms = first_ts;
+    for (int64_t t = first_ts - first_ts % step_ms_; t <= last_ts; t += step_ms_) {
+        step_end = t + step_ms_;
+        assessment = regime.current();
+        next = 0;
+        workers.run(step);
+        report.steps++;
+
+        // The step's batch is decided at its end, one mint at a time in a
+        // fixed order, as the service's single publisher does
+        now_ms = step_end - 1;
+        for (auto& slot : slots) {
+            if (!slot.updated) continue;
+            const auto& r = slot.result;
+            regime.observe(*slot.token);
+            report.scored[r.band]++;
+            if (r.band == "none") continue;
+
+            AlertGate gate = check_alert_gates(r, throttles);
+            if (gate != AlertGate::Pass) {
+                report.gated[gate_name(gate)]++;
+                continue;
+            }
+            record_sent_alert(r, throttles);
+
+            BacktestAlert a;
+            a.ts_ms = slot.token->latest.ts_ms;
+            a.mint = r.mint;
+            a.band = r.band;
+            a.confidence = r.confidence;
+            a.price = slot.token->latest.price;
+            a.returns.resize(horizons_ms_.size());
+            a.alert = render_alert(r, *slot.token);
+            a.alert["ts"] = util::iso8601(a.ts_ms);
+            slot.open.push_back(alerts.size());
+            alerts.push_back(std::move(a));
+        }
+
+        if (now_ms - last_cleanup_ms >= kStaleCleanupIntervalMs) {
+            int64_t cutoff_ms = now_ms - kStaleTokenHours * 3600LL * 1000;
+            for (auto& slot : slots) {
+                if (slot.token && slot.token->latest.ts_ms < cutoff_ms) {
+                    regime.forget(slot.token->mint);
+                    slot.token.reset();
+                }
+            }
+            throttles.cleanup_old_records(throttle_retention_hours(*scoring_));
+            last_cleanup_ms = now_ms;
+        }
+        regime.refresh(now_ms);
+    }
+
+    for (const auto& slot : slots) {
+        report.updates += slot.updates;
+    }
+    report.elapsed_sec = std::chrono::duration<double>(
+        std::chrono::steady_clock::now() - started).count();
+    return report;
+}
+
+nlohmann::json BacktestReport::summary() const {
+    nlohmann::json bands = nlohmann::json::object();
+    std::map<std::string, std::vector<const BacktestAlert*>> by_band;
+    for (const auto& a : alerts) {
+        by_band[a.band].push_back(&a);
+    }
+    for (const auto& [band, list] : by_band) {
+        nlohmann::json entry = {{"alerts", list.size()}};
+        for (size_t h = 0; h < horizons_ms.size(); h++) {
+            size_t resolved = 0;
+            size_t hits = 0;
+            double sum = 0.0;
+            for (const auto* a : list) {
+                if (!a->returns[h]) continue;
+                resolved++;
+                if (*a->returns[h] > 0) hits++;
+                sum += *a->returns[h];
+            }
+            entry[horizon_label(horizons_ms[h])] = {
+                {"resolved", resolved},
+                {"hit_rate", resolved ? static_cast<double>(hits) / resolved : 0.0},
+                {"mean_return_pct", resolved ? sum / resolved : 0.0}
+            };
+        }
+        bands[band] = entry;
+    }
+
+    return {
+        {"mints", mints},
+        {"updates", updates},
+        {"steps", steps},
+        {"elapsed_sec", elapsed_sec},
+        {"updates_per_sec", elapsed_sec > 0 ? updates / elapsed_sec : 0.0},
+        {"scored", scored},
+        {"gated", gated},
+        {"bands", bands}
+    };
+}
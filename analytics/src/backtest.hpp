@@ -0,0 +1,69 @@
+#pragma once
+
+#include "config.hpp"
+#include "scoring_config.hpp"
+#include "warm_start.hpp"
+#include <cstdint>
+#include <map>
+#include <optional>
+#include <string>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+// "1h", "4h", "90m": the key of a horizon in reports
+std::string horizon_label(int64_t ms);
+
+// An alert that passed the throttles during a replay
+struct BacktestAlert {
+    int64_t ts_ms;
+    std::string mint;
+    std::string band;
+    double confidence;
+    double price;
+    // Per horizon: percent change to the first price at or after ts + horizon;
+    // empty when the history ends first
+    std::vector<std::optional<double>> returns;
+    nlohmann::json alert;
+};
+
+struct BacktestReport {
+    std::vector<int64_t> horizons_ms;
+    size_t mints = 0;
+    size_t updates = 0;
+    size_t steps = 0;
+    double elapsed_sec = 0.0;
+    std::map<std::string, size_t> scored;    // per band, before throttles
+    std::map<std::string, size_t> gated;     // per throttle that held an alert back
+    std::vector<BacktestAlert> alerts;
+
+    // Counts, throughput and per band and horizon: resolved alerts, hit rate
+    // (share with a positive return) and mean return
+    nlohmann::json summary() const;
+};
+
+// Replays pool history through the service's decision path under a simulated
+// clock. Time advances in steps of step_ms; within a step each mint's updates
+// are applied and the mint is scored once, as the service does for one stream
+// batch, with mints spread over `threads` threads. Between steps a single
+// thread feeds the regime tallies and runs the throttles in a fixed mint
+// order, so the result does not depend on the thread count.
+class Backtester {
+public:
+    // Scores under the environment's scoring config
+    Backtester(const Config& config, size_t threads,
+               std::vector<int64_t> horizons_ms = {3600000LL, 4 * 3600000LL, 24 * 3600000LL},
+               int64_t step_ms = 300000);
+    // Scores under a candidate scoring config
+    Backtester(const Config& config, std::shared_ptr<const ScoringConfig> scoring, size_t threads,
+               std::vector<int64_t> horizons_ms = {3600000LL, 4 * 3600000LL, 24 * 3600000LL},
+               int64_t step_ms = 300000);
+
+    BacktestReport run(const std::vector<PoolInfo>& pools, const std::vector<PoolStatRow>& rows);
+
+private:
+    Config config_;
+    std::shared_ptr<const ScoringConfig> scoring_;
+    size_t threads_;
+    std::vector<int64_t> horizons_ms_;
+    int64_t step_ms_;
+};
@@ -0,0 +1,205 @@
+#include "batch_scorer.hpp"
+#include <algorithm>
+#include <sstream>
+#include <stdexcept>
+
+const char* band_name(Band band) {
+    switch (band) {
+        case Band::HeadsUp: return "heads_up";
+        case Band::Actionable: return "actionable";
+        case Band::HighConviction: return "high_conviction";
+        case Band::None: break;
+    }
+    return "none";
+}
+
+Band parse_band(const std::string& name) {
+    if (name == "heads_up") return Band::HeadsUp;
+    if (name == "actionable") return Band::Actionable;
+    if (name == "high_conviction") return Band::HighConviction;
+    return Band::None;
+}
+
+std::vector<ScoringProfile> parse_weight_profiles(const std::string& spec) {
+    std::vector<ScoringProfile> profiles;
+    std::stringstream entries(spec);
+    std::string entry;
+    while (std::getline(entries, entry, ';')) {
+        if (entry.empty()) continue;
+        auto eq = entry.find('=');
+        if (eq == std::string::npos || eq == 0) {
+            throw std::runtime_error("Weight profile '" + entry + "' is not name=w1,...,w10");
+        }
+
+        std::vector<double> w;
+        std::stringstream values(entry.substr(eq + 1));
+        std::string value;
+        while (std::getline(values, value, ',')) {
+            try {
+                w.push_back(std::stod(value));
+            } catch (const std::exception&) {
+                throw std::runtime_error("Weight profile '" + entry.substr(0, eq) +
+                                         "' has a bad weight '" + value + "'");
+            }
+        }
+        if (w.size() != SignalBatch::kSignals) {
+            throw std::runtime_error("Weight profile '" + entry.substr(0, eq) + "' needs 10 weights");
+        }
+
+        ScoringProfile profile;
+        profile.name = entry.substr(0, eq);
+        profile.weights = ScoringWeights{w[0], w[1], w[2], w[3], w[4], w[5], w[6], w[7], w[8], w[9]};
+        profiles.push_back(std::move(profile));
+    }
+    if (profiles.size() > kMaxShadowProfiles) {
+        throw std::runtime_error("At most " + std::to_string(kMaxShadowProfiles) + " weight profiles");
+    }
+    return profiles;
+}
+
+void SignalBatch::clear() {
+    for (auto& column : s) {
+        column.clear();
+    }
+    n1.clear();
+    age_hours.clear();
+    spread_pct.clear();
+    impact_pct.clear();
+    bar_5m_v.clear();
+    bar_15m_v.clear();
+    degraded.clear();
+}
+
+void SignalBatch::add(const TokenState& token, const SignalScores& signals) {
+    const double values[kSignals] = {signals.S1, signals.S2, signals.S3, signals.S4, signals.S5,
+                                     signals.S6, signals.S7, signals.S8, signals.S9, signals.S10};
+    for (size_t j = 0; j < kSignals; j++) {
+        s[j].push_back(values[j]);
+    }
+    n1.push_back(signals.N1);
+    age_hours.push_back(token.latest.age_hours);
+    spread_pct.push_back(token.latest.spread_pct);
+    impact_pct.push_back(token.latest.impact_1pct_pct);
+    bar_5m_v.push_back(token.latest.bar_5m.v_usd);
+    bar_15m_v.push_back(token.latest.bar_15m.v_usd);
+    degraded.push_back(token.latest.dq == "degraded" ? 1.0 : 0.0);
+}
+
+ConfidenceResult BatchScores::result(size_t profile, size_t row, const SignalBatch& batch) const {
+    ConfidenceResult r;
+    r.raw_score = raw[profile * rows + row];
+    r.data_quality = data_quality[row];
+    r.penalties = penalties[row];
+    r.final_confidence = confidence[profile * rows + row];
+    r.young_and_risky = young_and_risky[row] != 0;
+    r.rug_cap_applied = rug_cap_applied[row] != 0;
+    r.dq_forced_headsup = dq_forced_headsup[row] != 0;
+    if (batch.n1[row] < 1.0) {
+        r.reasons.add(Reason::NotOnMirroredLists);
+    }
+    return r;
+}
+
+BatchScorer::BatchScorer(std::vector<ScoringWeights> profiles) {
+    if (profiles.empty()) profiles.emplace_back();
+    for (const auto& w : profiles) {
+        weights_.push_back({w.w_S1, w.w_S2, w.w_S3, w.w_S4, w.w_S5,
+                            w.w_S6, w.w_S7, w.w_S8, w.w_S9, w.w_S10});
+    }
+}
+
+void BatchScorer::score(const SignalBatch& batch, int regime_adjusted_threshold,
+                        BatchScores& out) const {
+    const size_t n = batch.size();
+    const size_t k_count = weights_.size();
+    out.rows = n;
+    out.raw.assign(k_count * n, 0.0);
+    out.confidence.resize(k_count * n);
+    out.band.resize(k_count * n);
+    out.data_quality.resize(n);
+    out.penalties.resize(n);
+    out.young_and_risky.resize(n);
+    out.rug_cap_applied.resize(n);
+    out.dq_forced_headsup.resize(n);
+
+    const double* s1 = batch.s[0].data();
+    const double* s2 = batch.s[1].data();
+    const double* s4 = batch.s[3].data();
+    const double* s7 = batch.s[6].data();
+    const double* s9 = batch.s[8].data();
+    const double* age = batch.age_hours.data();
+    const double* v5 = batch.bar_5m_v.data();
+    const double* v15 = batch.bar_15m_v.data();
+    const double* degraded = batch.degraded.data();
+    const double* spread = batch.spread_pct.data();
+    const double* impact = batch.impact_pct.data();
+    const double* n1 = batch.n1.data();
+
+    // Data quality: one deduction per missing input, subtracted in the scalar
+    // order so the result is bit-identical
+    double* dq = out.data_quality.data();
+    for (size_t i = 0; i < n; i++) {
+        double d = 1.0;
+        d -= (s1[i] < 0.1) * 0.08;
+        d -= (s2[i] < 0.1) * 0.08;
+        d -= (s4[i] < 0.1) * 0.08;
+        d -= (v5[i] == 0) * 0.08;
+        d -= (v15[i] == 0) * 0.08;
+        d -= (degraded[i] != 0) * 0.08;
+        dq[i] = std::max(0.0, d);
+    }
+
+    // Penalties: age, execution cost, volume consistency, list hygiene
+    double* pen = out.penalties.data();
+    for (size_t i = 0; i < n; i++) {
+        double p = 0.0;
+        p += age[i] < 24.0 ? 15.0 : (age[i] < 48.0 ? 5.0 : 0.0);
+        p += spread[i] > 1.5 ? 5.0 : 0.0;
+        p += impact[i] > 1.0 ? 5.0 : 0.0;
+        p += s9[i] < 0.5 ? 3.0 : 0.0;
+        p += n1[i] < 1.0 ? 10.0 : 0.0;
+        pen[i] = p;
+    }
+
+    uint8_t* young = out.young_and_risky.data();
+    uint8_t* rug = out.rug_cap_applied.data();
+    uint8_t* forced = out.dq_forced_headsup.data();
+    for (size_t i = 0; i < n; i++) {
+        young[i] = (age[i] < 72.0) & (s7[i] < 0.6);
+        rug[i] = s7[i] < 0.3;
+        forced[i] = dq[i] < 0.7;
+    }
+
+    const double threshold = regime_adjusted_threshold;
+    for (size_t k = 0; k < k_count; k++) {
+        double* raw = out.raw.data() + k * n;
+        double* conf = out.confidence.data() + k * n;
+        Band* band = out.band.data() + k * n;
+
+        // R = W_k . S, one signal column at a time
+        for (size_t j = 0; j < SignalBatch::kSignals; j++) {
+            const double w = weights_[k][j];
+            const double* col = batch.s[j].data();
+            for (size_t i = 0; i < n; i++) {
+                raw[i] += col[i] * w;
+            }
+        }
+
+        for (size_t i = 0; i < n; i++) {
+            double r = raw[i] * 100.0;
+            r = rug[i] ? std::min(r, 55.0) : r;
+            raw[i] = r;
+            conf[i] = std::max(0.0, r - pen[i]);
+        }
+
+        // Highest band whose gate passes; the DQ gate overrides the rest
+        for (size_t i = 0; i < n; i++) {
+            const double c = conf[i];
+            uint8_t b = c >= 60.0 ? 1 : 0;
+            b = c >= threshold ? 2 : b;
+            b = ((c >= 85.0) & !rug[i] & !young[i]) ? 3 : b;
+            b = forced[i] ? 1 : b;
+            band[i] = static_cast<Band>(b);
+        }
+    }
+}
@@ -0,0 +1,90 @@
+#pragma once
+
+#include "scoring.hpp"
+#include <array>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+enum class Band : uint8_t {
+    None,
+    HeadsUp,
+    Actionable,
+    HighConviction
+};
+
+// "none", "heads_up", "actionable", "high_conviction"
+const char* band_name(Band band);
+// Inverse of band_name; Band::None for anything else
+Band parse_band(const std::string& name);
+
+// A named weight set scored alongside the production weights
+struct ScoringProfile {
+    std::string name;
+    ScoringWeights weights;
+};
+
+// Shadow profiles a config may carry; results hold their bands inline
+constexpr size_t kMaxShadowProfiles = 8;
+
+// "name=w1,...,w10;name2=..." with weights in S1..S10 order; empty gives none.
+// Throws std::runtime_error on a malformed spec or more than
+// kMaxShadowProfiles profiles.
+std::vector<ScoringProfile> parse_weight_profiles(const std::string& spec);
+
+// Signals and the penalty and gate inputs of a batch of tokens, one column
+// per input so every stage of BatchScorer runs down contiguous arrays
+struct SignalBatch {
+    static constexpr size_t kSignals = 10;
+
+    std::array<std::vector<double>, kSignals> s;   // s[j][i] = S(j+1) of row i
+    std::vector<double> n1;
+    std::vector<double> age_hours;
+    std::vector<double> spread_pct;
+    std::vector<double> impact_pct;
+    std::vector<double> bar_5m_v;
+    std::vector<double> bar_15m_v;
+    std::vector<double> degraded;                  // 1.0 when the data is degraded
+
+    size_t size() const { return n1.size(); }
+    void clear();
+    void add(const TokenState& token, const SignalScores& signals);
+};
+
+// Output of BatchScorer::score. Per-profile columns are profile-major:
+// entry k * rows + i is row i under profile k.
+struct BatchScores {
+    size_t rows = 0;
+    std::vector<double> raw;             // R after the rug cap
+    std::vector<double> confidence;      // C = max(0, R - P)
+    std::vector<Band> band;
+    // Profile-independent
+    std::vector<double> data_quality;
+    std::vector<double> penalties;       // P, list hygiene included
+    std::vector<uint8_t> young_and_risky;
+    std::vector<uint8_t> rug_cap_applied;
+    std::vector<uint8_t> dq_forced_headsup;
+
+    double confidence_at(size_t profile, size_t row) const { return confidence[profile * rows + row]; }
+    Band band_at(size_t profile, size_t row) const { return band[profile * rows + row]; }
+    // What ConfidenceScorer::compute_confidence returns for the row and profile
+    ConfidenceResult result(size_t profile, size_t row, const SignalBatch& batch) const;
+};
+
+// ConfidenceScorer::compute_confidence and determine_band for a whole batch
+// and several weight profiles at once. R for K profiles is a K x 10 by
+// 10 x N product accumulated one signal column at a time; penalties, caps and
+// bands are selects instead of branches, so each stage is a straight loop the
+// compiler vectorizes. Results match the scalar scorer exactly: every term is
+// added in the same order.
+class BatchScorer {
+public:
+    // Profile 0 is the production weights; the rest are shadows
+    explicit BatchScorer(std::vector<ScoringWeights> profiles = {ScoringWeights()});
+
+    size_t profiles() const { return weights_.size(); }
+    void score(const SignalBatch& batch, int regime_adjusted_threshold, BatchScores& out) const;
+
+private:
+    std::vector<std::array<double, SignalBatch::kSignals>> weights_;
+};
@@ -1,6 +1,8 @@
 #include "config.hpp"
+#include "batch_scorer.hpp"
 #include <spdlog/spdlog.h>
 #include <stdexcept>
+#include <algorithm>
 
 std::string Config::get_env(const char* name, const std::string& default_val) {
     const char* val = std::getenv(name);
@@ -23,9 +25,17 @@ Config Config::from_env() {
     
     cfg.redis_url = get_env("REDIS_URL", "redis://localhost:6379");
     cfg.stream_market = get_env("STREAM_MARKET", "soul.market.updates");
+    cfg.stream_mint = get_env("STREAM_MINT", "soul.market.mints");
     cfg.stream_alerts = get_env("STREAM_ALERTS", "soul.alerts");
     cfg.stream_req = get_env("STREAM_REQ", "soul.cmd.requests");
     cfg.stream_rep = get_env("STREAM_REP", "soul.cmd.replies");
+    cfg.priority_mints_key = get_env("PRIORITY_MINTS_KEY", "soul.priority.mints");
+    cfg.stream_batch_count = get_env_int("STREAM_BATCH_COUNT", 1000);
+    cfg.stream_block_ms = get_env_int("STREAM_BLOCK_MS", 1000);
+    
+    cfg.mint_stream_partitions = std::max(1, get_env_int("MINT_STREAM_PARTITIONS", 1));
+    cfg.partition_lease_ms = get_env_int("PARTITION_LEASE_MS", 15000);
+    cfg.partition_lease_key = get_env("PARTITION_LEASE_KEY", "soul.analytics.partitions");
     
     cfg.pg_dsn = get_env("PG_DSN");
     
@@ -34,16 +44,34 @@ Config Config::from_env() {
     cfg.risk_on_adj = get_env_int("RISK_ON_ADJ", -10);
     cfg.risk_off_adj = get_env_int("RISK_OFF_ADJ", 10);
     cfg.global_actionable_max_per_hour = get_env_int("GLOBAL_ACTIONABLE_MAX_PER_HOUR", 5);
+    cfg.regime_refresh_sec = get_env_int("REGIME_REFRESH_SEC", 60);
+    
+    cfg.scoring_workers = get_env_int("SCORING_WORKERS", 0);
+    cfg.scoring_queue_capacity = get_env_int("SCORING_QUEUE_CAPACITY", 1024);
+    cfg.shadow_weights = get_env("SHADOW_WEIGHTS");
+    cfg.scoring_config_path = get_env("SCORING_CONFIG_PATH");
+    cfg.scoring_config_key = get_env("SCORING_CONFIG_KEY");
+    cfg.scoring_config_reload_sec = std::max(1, get_env_int("SCORING_CONFIG_RELOAD_SEC", 30));
+    
+    cfg.snapshot_path = get_env("SNAPSHOT_PATH", "state/analytics.snap");
+    cfg.snapshot_interval_sec = std::max(10, get_env_int("SNAPSHOT_INTERVAL_SEC", 300));
+    cfg.warm_start_hours = std::clamp(get_env_int("WARM_START_HOURS", 24), 0, 24);
     
     cfg.cooldown_actionable_hours = get_env_int("COOLDOWN_ACTIONABLE_HOURS", 6);
     cfg.cooldown_headsup_hours = get_env_int("COOLDOWN_HEADSUP_HOURS", 1);
     cfg.watch_window_min = get_env_int("WATCH_WINDOW_MIN", 120);
     cfg.reentry_guard_hours = get_env_int("REENTRY_GUARD_HOURS", 12);
+    cfg.throttle_backend = get_env("THROTTLE_BACKEND", "memory");
+    cfg.throttle_key_prefix = get_env("THROTTLE_KEY_PREFIX", "soul.analytics.throttle");
     
     cfg.listen_addr = get_env("LISTEN_ADDR", "0.0.0.0");
     cfg.listen_port = get_env_int("LISTEN_PORT", 8083);
+    cfg.health_probe_sec = get_env_int("HEALTH_PROBE_SEC", 10);
     
     cfg.service_name = get_env("SERVICE_NAME", "analytics");
+    std::string host = get_env("HOSTNAME");
+    cfg.instance_id = get_env("INSTANCE_ID",
+                              host.empty() ? cfg.service_name : cfg.service_name + "-" + host);
     cfg.log_level = get_env("LOG_LEVEL", "info");
     
     return cfg;
@@ -53,10 +81,25 @@ void Config::validate() const {
     if (pg_dsn.empty()) {
         throw std::runtime_error("PG_DSN is required");
     }
+    if (partition_lease_ms < 3 * stream_block_ms) {
+        throw std::runtime_error("PARTITION_LEASE_MS must be at least 3x STREAM_BLOCK_MS");
+    }
+    if (!scoring_config_path.empty() && !scoring_config_key.empty()) {
+        throw std::runtime_error("Set SCORING_CONFIG_PATH or SCORING_CONFIG_KEY, not both");
+    }
+    if (throttle_backend != "memory" && throttle_backend != "redis") {
+        throw std::runtime_error("THROTTLE_BACKEND must be memory or redis");
+    }
+    auto shadows = parse_weight_profiles(shadow_weights);
     
     spdlog::info("Configuration validated successfully");
     spdlog::info("  Actionable threshold: {}", actionable_base_threshold);
     spdlog::info("  Risk adjustments: on={}, off={}", risk_on_adj, risk_off_adj);
+    spdlog::info("  Instance {}: {} mint stream partition(s)", instance_id, mint_stream_partitions);
     spdlog::info("  Cooldowns: actionable={}h, headsup={}h", 
                  cooldown_actionable_hours, cooldown_headsup_hours);
+    spdlog::info("  Throttles: {}", throttle_backend);
+    for (const auto& profile : shadows) {
+        spdlog::info("  Shadow weight profile: {}", profile.name);
+    }
 }
\ No newline at end of file
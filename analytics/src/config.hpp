@@ -7,9 +7,19 @@ struct Config {
     // Redis
     std::string redis_url;
     std::string stream_market;
+    std::string stream_mint;
     std::string stream_alerts;
     std::string stream_req;
     std::string stream_rep;
+    std::string priority_mints_key;
+    int stream_batch_count;     // XREADGROUP COUNT
+    int stream_block_ms;        // XREADGROUP BLOCK
+    
+    // Partitioned per-mint stream (STREAM_MINT.<n>) shared between replicas
+    int mint_stream_partitions;
+    int partition_lease_ms;
+    std::string partition_lease_key;
+    std::string instance_id;    // consumer name and lease owner; unique per replica
     
     // Postgres
     std::string pg_dsn;
@@ -19,16 +29,37 @@ struct Config {
     int risk_on_adj;
     int risk_off_adj;
     int global_actionable_max_per_hour;
+    int regime_refresh_sec;
+    
+    // Scoring workers (0 = one per core, less the reader)
+    int scoring_workers;
+    int scoring_queue_capacity;
+    // Extra weight profiles scored next to production, "name=w1,...,w10;..."
+    std::string shadow_weights;
+    // Versioned JSON overriding the weights, thresholds and cooldowns, polled
+    // from a file or a Redis key (both empty disables)
+    std::string scoring_config_path;
+    std::string scoring_config_key;
+    int scoring_config_reload_sec;
+    
+    // State snapshots (empty path disables)
+    std::string snapshot_path;
+    int snapshot_interval_sec;
+    int warm_start_hours;       // Postgres warm start without a snapshot (0 disables)
     
     // Cooldowns (hours)
     int cooldown_actionable_hours;
     int cooldown_headsup_hours;
     int watch_window_min;
     int reentry_guard_hours;
+    // "memory" keeps throttles per process; "redis" shares them between replicas
+    std::string throttle_backend;
+    std::string throttle_key_prefix;
     
     // HTTP
     std::string listen_addr;
     int listen_port;
+    int health_probe_sec;
     
     // Service
     std::string service_name;
@@ -0,0 +1,163 @@
+#include "decision.hpp"
+#include "entry_exit.hpp"
+#include "signals.hpp"
+#include "util.hpp"
+#include <fmt/format.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+
+namespace {
+
+std::string format_usd(double usd) {
+    if (usd >= 1e6) return fmt::format("${:.1f}M", usd / 1e6);
+    if (usd >= 1e3) return fmt::format("${:.0f}k", usd / 1e3);
+    return fmt::format("${:.0f}", usd);
+}
+
+// Columns score_tokens fills for each batch. clear() keeps their capacity,
+// so once a worker has seen its largest batch nothing is allocated.
+struct ScoringScratch {
+    SignalBatch batch;
+    BatchScores scores;
+};
+
+} // namespace
+
+void score_tokens(const std::vector<const TokenState*>& tokens, const RegimeAssessment& regime,
+                  const std::shared_ptr<const ScoringConfig>& scoring,
+                  std::vector<ScoringResult>& out) {
+    const ScoringConfig& config = *scoring;
+    const BatchScorer& scorer = config.scorer;
+    int regime_adj = 0;
+    if (regime.regime == MarketRegime::RiskOn) regime_adj = config.risk_on_adj;
+    else if (regime.regime == MarketRegime::RiskOff) regime_adj = config.risk_off_adj;
+    int threshold = config.actionable_base_threshold + regime_adj;
+
+    thread_local ScoringScratch scratch;
+    SignalBatch& batch = scratch.batch;
+    BatchScores& scores = scratch.scores;
+    batch.clear();
+    for (const TokenState* token : tokens) {
+        batch.add(*token, SignalCalculator::compute_signals(*token));
+    }
+    scorer.score(batch, threshold, scores);
+
+    out.clear();
+    out.resize(tokens.size());
+    for (size_t i = 0; i < tokens.size(); i++) {
+        const TokenState& token = *tokens[i];
+        ScoringResult& result = out[i];
+        result.scoring = scoring;
+        Band band = scores.band_at(0, i);
+
+        bool any_confirmable = false;
+        for (size_t k = 0; k < scorer.profiles(); k++) {
+            Band b = scores.band_at(k, i);
+            any_confirmable |= b == Band::Actionable || b == Band::HighConviction;
+        }
+
+        // Entry confirmation and net edge can only downgrade to Heads-up,
+        // under the shadow profiles as much as the production one
+        bool downgrade = false;
+        if (band != Band::None || any_confirmable) {
+            auto entry = EntryExitLogic::check_entry_confirmation(token);
+            auto edge = EntryExitLogic::check_net_edge(token);
+            downgrade = !entry.confirmed || !edge.passes;
+            if (downgrade && (band == Band::Actionable || band == Band::HighConviction)) {
+                spdlog::debug("Downgrading {}: {}", token.symbol,
+                              entry.confirmed ? edge.reason : entry.reason);
+                band = Band::HeadsUp;
+            }
+        }
+
+        result.band = band_name(band);
+        result.confidence = scores.confidence_at(0, i);
+        result.near_alert = result.confidence >= threshold - kAlertProximityPoints;
+        result.shadow_count = std::min(scorer.profiles() - 1, kMaxShadowProfiles);
+        for (size_t k = 0; k < result.shadow_count; k++) {
+            Band b = scores.band_at(k + 1, i);
+            if (downgrade && (b == Band::Actionable || b == Band::HighConviction)) b = Band::HeadsUp;
+            result.shadow_bands[k] = b;
+        }
+        if (band != Band::None) {
+            result.reasons = scores.result(0, i, batch).reasons;
+        }
+    }
+}
+
+nlohmann::json render_alert(const ScoringResult& r, const TokenState& token) {
+    const auto& md = token.latest;
+    // A pure function of the token, so this is the confirmation it was scored with
+    auto entry = EntryExitLogic::check_entry_confirmation(token);
+
+    std::vector<std::string> lines = {
+        fmt::format("Liq {}; Vol24h {}; m1h {:+.1f}%; m24h {:+.0f}%",
+                    format_usd(md.liq_usd), format_usd(md.vol24h_usd),
+                    token.compute_m1h(), token.compute_m24h()),
+        entry.reason,
+        fmt::format("Age {:.0f}h; {} pools, cross-DEX spread {:.2f}%",
+                    md.age_hours, md.pool_count, md.xdex_spread_pct),
+        fmt::format("Route {} hops dev {:.1f}%", md.route.hops, md.route.dev_pct)
+    };
+    r.reasons.for_each([&lines](Reason reason) { lines.push_back(reason_text(reason)); });
+
+    return {
+        {"severity", r.band},
+        {"symbol", token.symbol},
+        {"mint", token.mint},
+        {"pool", md.pool},
+        {"price", md.price},
+        {"confidence", static_cast<int>(r.confidence)},
+        {"lines", lines},
+        {"plan", EntryExitLogic::build_exit_plan(token)},
+        {"est_impact_pct", md.impact_1pct_pct},
+        {"config_version", r.scoring->version},
+        {"ts", util::current_iso8601()}
+    };
+}
+
+ThrottleCheck throttle_check(const ScoringResult& r) {
+    const ScoringConfig& config = *r.scoring;
+    bool heads_up = r.band == "heads_up";
+    ThrottleCheck c;
+    c.symbol = r.mint;
+    c.band = r.band;
+    c.reason_hash = r.reasons.key();
+    c.cooldown_hours = heads_up ? config.cooldown_headsup_hours : config.cooldown_actionable_hours;
+    c.reentry_guard_hours = r.band != "high_conviction" ? config.reentry_guard_hours : 0;
+    c.global_max_per_hour = heads_up ? -1 : config.global_actionable_max_per_hour;
+    return c;
+}
+
+AlertGate check_alert_gates(const ThrottleCheck& c, ThrottleManager& throttles) {
+    if (!throttles.check_token_cooldown(c.symbol, c.band, c.cooldown_hours) ||
+        throttles.is_duplicate(c.symbol, c.reason_hash, c.cooldown_hours)) {
+        return AlertGate::Cooldown;
+    }
+    if (c.reentry_guard_hours > 0 &&
+        !throttles.check_reentry_guard(c.symbol, c.reentry_guard_hours)) {
+        return AlertGate::ReentryGuard;
+    }
+    if (c.global_max_per_hour >= 0 && !throttles.check_global_limit(c.global_max_per_hour)) {
+        return AlertGate::GlobalLimit;
+    }
+    return AlertGate::Pass;
+}
+
+AlertGate check_alert_gates(const ScoringResult& r, ThrottleManager& throttles) {
+    return check_alert_gates(throttle_check(r), throttles);
+}
+
+void record_sent_alert(const ThrottleCheck& c, ThrottleManager& throttles) {
+    throttles.record_alert(c.symbol, c.band, c.reason_hash);
+    if (c.global_max_per_hour >= 0) throttles.record_global_alert();
+}
+
+void record_sent_alert(const ScoringResult& r, ThrottleManager& throttles) {
+    record_sent_alert(throttle_check(r), throttles);
+}
+
+int throttle_retention_hours(const ScoringConfig& scoring) {
+    return std::max({scoring.cooldown_actionable_hours, scoring.cooldown_headsup_hours,
+                     scoring.reentry_guard_hours});
+}
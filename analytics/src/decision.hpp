@@ -0,0 +1,55 @@
+#pragma once
+
+#include "batch_scorer.hpp"
+#include "config.hpp"
+#include "regime.hpp"
+#include "scoring_config.hpp"
+#include "scoring_pool.hpp"
+#include "state.hpp"
+#include "throttles.hpp"
+#include <nlohmann/json.hpp>
+
+// Mints scoring within this many points of the actionable threshold get
+// refresh priority in the ingestor's request budget
+constexpr double kAlertProximityPoints = 15.0;
+
+// Mints without an update for a day are dropped from state and the regime
+constexpr int kStaleTokenHours = 24;
+constexpr int64_t kStaleCleanupIntervalMs = 60LL * 60 * 1000;
+
+// The per-token decision shared by the service and the backtest, for a batch
+// of tokens: signals, then confidence and band against the regime-adjusted
+// threshold under every profile of the scoring config in one pass,
+// downgraded to Heads-up when entry confirmation or net edge fails. Records
+// reason codes for any production band other than "none"; the payload itself
+// waits for render_alert. Column buffers are kept per thread and reused, so
+// steady-state scoring does not allocate. out[i] is tokens[i].
+void score_tokens(const std::vector<const TokenState*>& tokens, const RegimeAssessment& regime,
+                  const std::shared_ptr<const ScoringConfig>& scoring,
+                  std::vector<ScoringResult>& out);
+
+// The alert payload for a scored mint from the token it was scored on,
+// stamped with the config version it was scored under. Built only for alerts
+// that cleared the gates.
+nlohmann::json render_alert(const ScoringResult& r, const TokenState& token);
+
+// Values are the codes RedisBus::check_and_record_alerts returns
+enum class AlertGate {
+    Pass,
+    Cooldown,        // per-mint band cooldown or duplicate reasons
+    ReentryGuard,
+    GlobalLimit
+};
+
+// The gates that apply to a scored mint's alert under the version it was
+// scored with
+ThrottleCheck throttle_check(const ScoringResult& r);
+// Cooldowns, the re-entry guard and the global actionable cap, in that order;
+// the in-process rules the shared throttle script mirrors
+AlertGate check_alert_gates(const ThrottleCheck& c, ThrottleManager& throttles);
+AlertGate check_alert_gates(const ScoringResult& r, ThrottleManager& throttles);
+// Records a sent alert against the gates above
+void record_sent_alert(const ThrottleCheck& c, ThrottleManager& throttles);
+void record_sent_alert(const ScoringResult& r, ThrottleManager& throttles);
+// Longest any gate looks back; throttle records older than this are dropped
+int throttle_retention_hours(const ScoringConfig& scoring);
@@ -40,23 +40,13 @@ EntryConfirmation EntryExitLogic::check_entry_confirmation(const TokenState& sta
 bool EntryExitLogic::check_retest_hold(const TokenState& state) {
     // Retest and hold: 5m close back above prior breakout
     
-    if (state.history_24h.size() < 20) return false;
+    if (state.history.size() < RollingStats::kRetestWindow) return false;
     
     // Find recent high
-    double recent_high = 0.0;
-    for (size_t i = state.history_24h.size() - 20; i < state.history_24h.size() - 5; i++) {
-        if (i < state.history_24h.size()) {
-            recent_high = std::max(recent_high, state.history_24h[i].price);
-        }
-    }
+    double recent_high = std::max(0.0, state.stats.high_retest.value());
     
     // Check if pulled back and then closed above
-    double pullback_low = state.latest.price;
-    for (size_t i = state.history_24h.size() - 5; i < state.history_24h.size(); i++) {
-        if (i < state.history_24h.size()) {
-            pullback_low = std::min(pullback_low, state.history_24h[i].price);
-        }
-    }
+    double pullback_low = std::min(state.latest.price, state.stats.low_retest.value());
     
     // Confirm: pulled back below high, then 5m close back above
     if (pullback_low < recent_high * 0.98 && 
@@ -70,21 +60,10 @@ bool EntryExitLogic::check_retest_hold(const TokenState& state) {
 bool EntryExitLogic::check_quick_pullback(const TokenState& state) {
     // Quick pullback 2-5%, then 15m VWAP-proxy close above
     
-    if (state.history_24h.size() < 30) return false;
-    
-    double recent_high = 0.0;
-    for (size_t i = state.history_24h.size() - 30; i < state.history_24h.size() - 15; i++) {
-        if (i < state.history_24h.size()) {
-            recent_high = std::max(recent_high, state.history_24h[i].price);
-        }
-    }
+    if (state.history.size() < RollingStats::kQuickPullbackWindow) return false;
     
-    double pullback_low = state.latest.price;
-    for (size_t i = state.history_24h.size() - 15; i < state.history_24h.size(); i++) {
-        if (i < state.history_24h.size()) {
-            pullback_low = std::min(pullback_low, state.history_24h[i].price);
-        }
-    }
+    double recent_high = std::max(0.0, state.stats.high_pullback.value());
+    double pullback_low = std::min(state.latest.price, state.stats.low_pullback.value());
     
     double pullback_pct = ((recent_high - pullback_low) / recent_high) * 100.0;
     
@@ -98,12 +77,9 @@ bool EntryExitLogic::check_quick_pullback(const TokenState& state) {
 }
 
 double EntryExitLogic::estimate_24h_swing_high(const TokenState& state) {
-    if (state.history_24h.empty()) return state.latest.price * 1.15;
+    if (state.history.empty()) return state.latest.price * 1.15;
     
-    double swing_high = state.latest.price;
-    for (const auto& md : state.history_24h) {
-        swing_high = std::max(swing_high, md.price);
-    }
+    double swing_high = std::max(state.latest.price, state.stats.high_24h.value());
     
     // Cap at +15% from current
     return std::min(swing_high, state.latest.price * 1.15);
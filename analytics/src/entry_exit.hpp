@@ -5,15 +5,15 @@
 
 struct EntryConfirmation {
     bool confirmed;
-    std::string method; // "retest_hold", "quick_pullback", "none"
-    std::string reason;
+    const char* method = "none";   // "retest_hold", "quick_pullback", "not_required"
+    const char* reason = "";
 };
 
 struct NetEdgeCheck {
     bool passes;
     double upside_pct;    // U to 24h swing high
     double downside_pct;  // K = spread + impact + lag
-    std::string reason;
+    const char* reason = "";
 };
 
 struct SizingSuggestion {
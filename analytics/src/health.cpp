@@ -1,23 +1,36 @@
-
 #include "health.hpp"
 #include "util.hpp"
 
 HealthCheck::HealthCheck(std::shared_ptr<RedisBus> redis, std::shared_ptr<PostgresStore> pg)
-    : redis_(redis), pg_(pg) {}
+    : redis_(redis), pg_(pg)
+    , redis_ok_(false), pg_ok_(false)
+    , last_probe_ms_(0), last_decision_ms_(0) {}
+
+void HealthCheck::probe() {
+    redis_ok_ = redis_->ping();
+    pg_ok_ = pg_->ping();
+    last_probe_ms_ = util::current_timestamp_ms();
+}
 
-nlohmann::json HealthCheck::get_status() {
-    bool redis_ok = redis_->ping();
-    bool pg_ok = pg_->ping();
+void HealthCheck::mark_decision() {
+    last_decision_ms_ = util::current_timestamp_ms();
+}
+
+nlohmann::json HealthCheck::get_status() const {
+    bool redis_ok = redis_ok_;
+    bool pg_ok = pg_ok_;
+    int64_t last_decision_ms = last_decision_ms_;
     
     return {
         {"ok", redis_ok && pg_ok},
         {"redis", redis_ok},
         {"postgres", pg_ok},
         {"loop", "running"},
-        {"last_decision_ts", util::current_iso8601()}
+        {"last_probe_ts", util::iso8601(last_probe_ms_)},
+        {"last_decision_ts", last_decision_ms > 0 ? util::iso8601(last_decision_ms) : ""}
     };
 }
 
 bool HealthCheck::is_healthy() const {
-    return redis_->ping() && pg_->ping();
-}
\ No newline at end of file
+    return redis_ok_ && pg_ok_;
+}
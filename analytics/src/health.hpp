@@ -2,15 +2,28 @@
 #include "redis_bus.hpp"
 #include "pg_store.hpp"
 #include <nlohmann/json.hpp>
+#include <atomic>
+#include <cstdint>
 #include <memory>
 
+// Redis and Postgres are probed on their own timer (probe()); /health only
+// reads the cached results, so a request never opens a connection.
 class HealthCheck {
 public:
     HealthCheck(std::shared_ptr<RedisBus> redis, std::shared_ptr<PostgresStore> pg);
-    nlohmann::json get_status();
+    
+    void probe();
+    void mark_decision();
+    
+    nlohmann::json get_status() const;
     bool is_healthy() const;
     
 private:
     std::shared_ptr<RedisBus> redis_;
     std::shared_ptr<PostgresStore> pg_;
-};
\ No newline at end of file
+    
+    std::atomic<bool> redis_ok_;
+    std::atomic<bool> pg_ok_;
+    std::atomic<int64_t> last_probe_ms_;
+    std::atomic<int64_t> last_decision_ms_;
+};
@@ -7,19 +7,45 @@
 #include "entry_exit.hpp"
 #include "throttles.hpp"
 #include "regime.hpp"
-#include "api_signals.hpp"
+#include "scoring_pool.hpp"
+#include "scoring_config.hpp"
+#include "decision.hpp"
+#include "partition_leases.hpp"
+#include "snapshot.hpp"
 #include "health.hpp"
 #include "util.hpp"
 #include <httplib.h>
+#include <fmt/format.h>
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <signal.h>
+#include <algorithm>
+#include <array>
 #include <atomic>
+#include <map>
+#include <optional>
+#include <mutex>
+#include <set>
 #include <thread>
 #include <chrono>
+#include <unordered_map>
+#include <unordered_set>
 
 std::atomic<bool> shutdown_requested{false};
 
+// Near-alert mints keep ingestor refresh priority this long
+constexpr int64_t kAlertProximityTtlMs = 30LL * 60 * 1000;
+
+// A newly owned partition's state is rebuilt from this much of its stream
+constexpr int64_t kReplayWindowMs = 24LL * 3600 * 1000;
+
+// Parallel COPY streams for the Postgres warm start
+constexpr size_t kWarmStartConnections = 4;
+
+// Publisher, health probe and partition leases. The two blocking stream
+// readers each have a bus of their own, so nothing queues behind a BLOCK.
+constexpr size_t kSharedRedisConnections = 3;
+
 void signal_handler(int signal) {
     spdlog::info("Received signal {}, initiating shutdown", signal);
     shutdown_requested = true;
@@ -28,7 +54,7 @@ void signal_handler(int signal) {
 void setup_logging(const std::string& log_level) {
     auto console_sink = std::make_shared<spdlog::sinks::stdout_color_sink_mt>();
     auto logger = std::make_shared<spdlog::logger>("soulscout", console_sink);
-    
+
     if (log_level == "debug") {
         logger->set_level(spdlog::level::debug);
     } else if (log_level == "warn") {
@@ -38,207 +64,695 @@ void setup_logging(const std::string& log_level) {
     } else {
         logger->set_level(spdlog::level::info);
     }
-    
+
     spdlog::set_default_logger(logger);
     spdlog::info("Logging initialized at level: {}", log_level);
 }
 
+// Latest decision per mint, served to /signals requests
+struct ScoredMint {
+    std::string symbol;
+    double confidence;
+    std::string band;
+    std::string ts;
+};
+
+// Stream IDs are "<ms>-<seq>"; history is timed by when the ingestor
+// published, so replayed and live updates line up
+int64_t stream_id_ms(const std::string& id) {
+    try {
+        return std::stoll(id.substr(0, id.find('-')));
+    } catch (const std::exception&) {
+        return util::current_timestamp_ms();
+    }
+}
+
+// One job per mint per batch, in message order, so each touched mint is
+// scored once. Undecodable messages are collected per stream for acking.
+std::vector<ScoringJob> build_jobs(const std::vector<StreamMessage>& messages, bool replay,
+                                   std::map<std::string, std::vector<std::string>>& rejected) {
+    std::vector<ScoringJob> jobs;
+    std::unordered_map<std::string, size_t> job_index;
+    for (const auto& msg : messages) {
+        try {
+            MarketData md = MarketData::from_json(msg.data);
+            if (md.mint_base.empty()) {
+                rejected[msg.stream].push_back(msg.id);
+                continue;
+            }
+            md.ts_ms = stream_id_ms(msg.id);
+            auto [it, inserted] = job_index.try_emplace(md.mint_base, jobs.size());
+            if (inserted) {
+                ScoringJob job;
+                job.mint = md.mint_base;
+                job.stream = msg.stream;
+                job.replay = replay;
+                jobs.push_back(std::move(job));
+            }
+            ScoringJob& job = jobs[it->second];
+            job.updates.push_back(std::move(md));
+            if (!replay) job.msg_ids.push_back(msg.id);
+        } catch (const std::exception& e) {
+            spdlog::error("Bad mint update {}: {}", msg.id, e.what());
+            rejected[msg.stream].push_back(msg.id);
+        }
+    }
+    return jobs;
+}
+
+// Renders and publishes a scored mint's alert if it cleared the gates, and
+// records it in the in-process throttles
+void publish_gated_alert(const ScoringResult& r, AlertGate gate, const Config& config,
+                         ThrottleManager& throttles, RedisBus& redis) {
+    const std::string& symbol = r.token ? r.token->symbol : r.mint;
+    switch (gate) {
+        case AlertGate::Cooldown:
+            spdlog::debug("Alert for {} in cooldown", symbol);
+            return;
+        case AlertGate::ReentryGuard:
+            spdlog::debug("Alert for {} blocked by re-entry guard", symbol);
+            return;
+        case AlertGate::GlobalLimit:
+            spdlog::info("Global actionable limit reached, suppressing {}", symbol);
+            return;
+        case AlertGate::Pass:
+            break;
+    }
+
+    redis.publish_alert(config.stream_alerts, render_alert(r, *r.token));
+    record_sent_alert(r, throttles);
+
+    spdlog::info("Published {} alert for {} (C={})", r.band, symbol, static_cast<int>(r.confidence));
+}
+
+// Applies cooldowns, the re-entry guard and the global cap to a pass's
+// alerts in order, then publishes those that clear them. With the Redis
+// backend every replica checks and records against the same keys, in one
+// round trip per pass; the in-process throttles gate any alert Redis did not
+// answer.
+void publish_scored_alerts(const std::vector<const ScoringResult*>& alerts, const Config& config,
+                           ThrottleManager& throttles, RedisBus& redis) {
+    if (alerts.empty()) return;
+
+    std::vector<int> shared_gates;
+    if (config.throttle_backend == "redis") {
+        int retention_hours = 0;
+        std::vector<ThrottleCheck> checks;
+        for (const auto* r : alerts) {
+            checks.push_back(throttle_check(*r));
+            retention_hours = std::max(retention_hours, throttle_retention_hours(*r->scoring));
+        }
+        shared_gates = redis.check_and_record_alerts(config.throttle_key_prefix, checks,
+                                                     util::current_timestamp_ms(),
+                                                     retention_hours * 3600LL * 1000);
+    }
+
+    for (size_t i = 0; i < alerts.size(); i++) {
+        const ScoringResult& r = *alerts[i];
+        AlertGate gate = i < shared_gates.size() && shared_gates[i] >= 0
+                             ? static_cast<AlertGate>(shared_gates[i])
+                             : check_alert_gates(r, throttles);
+        publish_gated_alert(r, gate, config, throttles, redis);
+    }
+}
+
+nlohmann::json build_signals_reply(const nlohmann::json& req,
+                                   const std::map<std::string, ScoredMint>& scored) {
+    std::vector<std::pair<std::string, const ScoredMint*>> ranked;
+    for (const auto& [mint, s] : scored) {
+        ranked.emplace_back(mint, &s);
+    }
+    std::sort(ranked.begin(), ranked.end(), [](const auto& a, const auto& b) {
+        return a.second->confidence > b.second->confidence;
+    });
+
+    nlohmann::json top = nlohmann::json::array();
+    for (size_t i = 0; i < ranked.size() && i < 10; i++) {
+        const auto& s = *ranked[i].second;
+        top.push_back({
+            {"mint", ranked[i].first},
+            {"symbol", s.symbol},
+            {"confidence", static_cast<int>(s.confidence)},
+            {"band", s.band},
+            {"ts", s.ts}
+        });
+    }
+
+    return {
+        {"corr_id", req.value("corr_id", "")},
+        {"cmd", "signals"},
+        {"ok", true},
+        {"signals", top},
+        {"ts", util::current_iso8601()}
+    };
+}
+
 int main() {
     try {
         // Load configuration
-        Config config = Config::load_from_env();
+        Config config = Config::from_env();
         setup_logging(config.log_level);
-        
-        spdlog::info("Starting {} on {}:{}", 
+        config.validate();
+
+        spdlog::info("Starting {} on {}:{}",
                      config.service_name, config.listen_addr, config.listen_port);
-        
+
         // Initialize components
-        RedisBus redis(config.redis_url);
-        PgStore pgstore(config.pg_dsn);
-        MarketState state;
-        Throttles throttles(config, redis);
-        RegimeFilter regime;
-        HealthMonitor health;
-        
+        auto redis = std::make_shared<RedisBus>(config.redis_url, kSharedRedisConnections);
+        RedisBus stream_redis(config.redis_url);    // reader thread
+        RedisBus command_redis(config.redis_url);   // command thread
+        auto pg = std::make_shared<PostgresStore>(config.pg_dsn);
+        HealthCheck health(redis, pg);
+        // Weights and thresholds from the environment until a version of the
+        // scoring config file or key replaces them
+        ScoringConfigSource::Fetch fetch_scoring;
+        if (!config.scoring_config_path.empty()) {
+            fetch_scoring = [path = config.scoring_config_path]() {
+                return ScoringConfigSource::read_file(path);
+            };
+        } else if (!config.scoring_config_key.empty()) {
+            fetch_scoring = [redis, key = config.scoring_config_key]() { return redis->get_value(key); };
+        }
+        ScoringConfigSource scoring_source(ScoringConfig::from_config(config), fetch_scoring);
+        scoring_source.reload();
+        RegimeDetector regime_detector(config.regime_refresh_sec * 1000LL);
+
+        // Publisher thread only
+        ThrottleManager throttles;
+        // Written by the publisher, read by the command thread
+        std::map<std::string, ScoredMint> scored;
+        std::mutex scored_mutex;
+        // Mints dropped with a released partition, forgotten by the publisher
+        std::vector<std::string> dropped;
+        std::mutex dropped_mutex;
+
         // Test connections
-        if (!redis.ping()) {
+        if (!redis->ping()) {
             spdlog::error("Failed to connect to Redis");
             return 1;
         }
-        if (!pgstore.ping()) {
-            spdlog::error("Failed to connect to Postgres");
-            return 1;
+        pg->init_schema();
+
+        const std::string group = "analytics_group";
+        const std::string consumer = config.instance_id;
+        const std::string cmd_group = "analytics_cmd_group";
+        for (int p = 0; p < config.mint_stream_partitions; p++) {
+            redis->create_consumer_group(
+                util::partition_stream(config.stream_mint, p, config.mint_stream_partitions), group);
         }
-        
-        health.set_redis(true);
-        health.set_postgres(true);
-        health.set_loop_status("idle");
-        
+        redis->create_consumer_group(config.stream_req, cmd_group);
+
         // Setup HTTP server for /health endpoint
         httplib::Server http_server;
-        
+
         http_server.Get("/health", [&health](const httplib::Request&, httplib::Response& res) {
-            auto health_json = health.to_json();
-            res.set_content(health_json, "application/json");
-            res.status = health.is_ok() ? 200 : 503;
+            res.set_content(health.get_status().dump(), "application/json");
+            res.status = health.is_healthy() ? 200 : 503;
         });
-        
+
         // Start HTTP server in background thread
         std::thread http_thread([&]() {
-            spdlog::info("HTTP server listening on {}:{}", 
+            spdlog::info("HTTP server listening on {}:{}",
                          config.listen_addr, config.listen_port);
             http_server.listen(config.listen_addr.c_str(), config.listen_port);
         });
-        
+
         // Register signal handlers
         signal(SIGTERM, signal_handler);
         signal(SIGINT, signal_handler);
-        
-        // Main processing loop
-        spdlog::info("Entering main loop");
-        health.set_loop_status("running");
-        
-        while (!shutdown_requested) {
-            try {
-                // 1. Consume market updates
-                auto market_updates = redis.consume_stream(
-                    config.stream_market, 
-                    "analytics_group", 
-                    "analytics_consumer",
-                    100  // timeout ms
-                );
-                
-                for (const auto& update : market_updates) {
-                    try {
-                        // Update market state
-                        state.update(update);
-                        
-                        // Extract token/pool identifiers
-                        std::string symbol = update["symbol"].get<std::string>();
-                        std::string pool = update["pool"].get<std::string>();
-                        
-                        // Compute signals S1-S10, N1
-                        SignalResult signals = compute_signals(update, state, pgstore);
-                        
-                        // Apply DQ gate
-                        if (signals.data_quality < 0.7) {
-                            spdlog::debug("DQ gate: {} below 0.7, forcing heads_up", 
-                                          signals.data_quality);
-                            signals.force_heads_up = true;
+
+        // Runs on the scoring workers: everything here is per-token except the
+        // regime snapshot, which is one atomic load per batch
+        auto score = [&](const std::vector<const TokenState*>& tokens,
+                         std::vector<ScoringResult>& out) {
+            score_tokens(tokens, *regime_detector.current(), scoring_source.current(), out);
+        };
+
+        // Warm start: throttles resume at once; each partition's tokens are
+        // installed when this replica takes that partition over
+        std::optional<SnapshotStore> snapshots;
+        std::map<std::string, std::vector<std::shared_ptr<TokenState>>> restored;
+        std::map<std::string, std::string> restored_ids;
+        if (!config.snapshot_path.empty()) {
+            snapshots.emplace(config.snapshot_path);
+            int64_t started_ms = util::current_timestamp_ms();
+            auto snap = snapshots->load();
+            if (snap && started_ms - snap->created_ms < kReplayWindowMs) {
+                throttles.import_state(snap->throttles);
+                restored_ids = snap->stream_ids;
+                for (auto& token : snap->tokens) {
+                    int p = util::mint_partition(token->mint, config.mint_stream_partitions);
+                    restored[util::partition_stream(config.stream_mint, p, config.mint_stream_partitions)]
+                        .push_back(std::move(token));
+                }
+                spdlog::info("Loaded snapshot from {} ({} tokens, {} s old) in {} ms",
+                             util::iso8601(snap->created_ms), snap->tokens.size(),
+                             (started_ms - snap->created_ms) / 1000,
+                             util::current_timestamp_ms() - started_ms);
+            } else if (snap) {
+                spdlog::warn("Snapshot from {} is older than the replay window, ignoring it",
+                             util::iso8601(snap->created_ms));
+            }
+        }
+
+        // Cold start: rebuild histories from the ingestor's persisted 5m pool
+        // stats; each partition then replays its stream after the newest row
+        if (restored_ids.empty() && config.warm_start_hours > 0) {
+            int64_t started_ms = util::current_timestamp_ms();
+            size_t threads = std::max(1u, std::thread::hardware_concurrency());
+            std::vector<PoolInfo> pools;
+            std::vector<PoolStatRow> rows;
+            if (pg->load_pool_stats(started_ms - config.warm_start_hours * 3600LL * 1000, started_ms,
+                                    std::min<size_t>(threads, kWarmStartConnections), pools, rows)) {
+                size_t row_count = rows.size();
+                auto tokens = build_histories(pools, rows, threads);
+                rows = {};
+                for (auto& token : tokens) {
+                    int p = util::mint_partition(token->mint, config.mint_stream_partitions);
+                    std::string stream = util::partition_stream(config.stream_mint, p,
+                                                                config.mint_stream_partitions);
+                    std::string last = std::to_string(token->history.ts(token->history.size() - 1)) + "-0";
+                    auto& id = restored_ids[stream];
+                    if (util::stream_id_less(id, last)) id = last;
+                    restored[stream].push_back(std::move(token));
+                }
+                spdlog::info("Warm start: {} tokens from {} pool stat rows in {} ms",
+                             tokens.size(), row_count, util::current_timestamp_ms() - started_ms);
+            }
+        }
+
+        size_t workers = config.scoring_workers > 0
+            ? static_cast<size_t>(config.scoring_workers)
+            : std::max(2u, std::thread::hardware_concurrency()) - 1;
+        ScoringPool pool(workers, static_cast<size_t>(config.scoring_queue_capacity), score);
+        pool.start();
+
+        // Single publisher: regime tallies, throttles, alerts, acks and /signals
+        std::atomic<bool> reader_done{false};
+        std::thread publisher_thread([&]() {
+            std::vector<ScoringResult> results;
+            std::vector<std::string> near_alert;
+            std::vector<const ScoringResult*> alerting;
+            std::map<std::string, std::vector<std::string>> acks;
+            std::vector<std::string> forget;
+            int64_t last_cleanup_ms = util::current_timestamp_ms();
+            // Last time the scoring config file was checked for changes
+            int64_t last_reload_ms = last_cleanup_ms;
+            // Bands per profile of one scoring version since the last report,
+            // production first
+            auto counted = scoring_source.current();
+            std::vector<std::array<size_t, 4>> band_counts(1 + counted->shadows.size());
+            auto report_shadows = [&]() {
+                const auto& p = band_counts[0];
+                for (size_t k = 1; k < band_counts.size(); k++) {
+                    const auto& c = band_counts[k];
+                    spdlog::info("Shadow {}: {} high conviction, {} actionable, {} heads-up "
+                                 "(production {}, {}, {}, config {})",
+                                 counted->shadows[k - 1].name, c[3], c[2], c[1], p[3], p[2], p[1],
+                                 counted->version);
+                }
+                std::fill(band_counts.begin(), band_counts.end(), std::array<size_t, 4>{});
+            };
+
+            while (true) {
+                try {
+                    results.clear();
+                    near_alert.clear();
+                    alerting.clear();
+                    acks.clear();
+                    pool.poll(results, static_cast<size_t>(config.stream_batch_count));
+
+                    if (!results.empty()) {
+                        std::string ts = util::current_iso8601();
+                        std::lock_guard<std::mutex> lock(scored_mutex);
+                        for (const auto& r : results) {
+                            if (!r.token) continue;
+                            // Assigned field by field so a known mint's strings
+                            // keep their buffers
+                            ScoredMint& m = scored[r.mint];
+                            m.symbol = r.token->symbol;
+                            m.confidence = r.confidence;
+                            m.band = r.band;
+                            m.ts = ts;
                         }
-                        
-                        // Compute confidence score with penalties
-                        double confidence = compute_confidence(signals, update, state);
-                        
-                        // Apply risk regime filter (adjusts thresholds, not C)
-                        auto regime_adj = regime.assess(state);
-                        int threshold = config.actionable_base_threshold + regime_adj.threshold_adj;
-                        
-                        // Apply entry confirmations and net-edge check
-                        EntryContext entry_ctx = check_entry_conditions(update, state, signals);
-                        
-                        if (!entry_ctx.confirmed) {
-                            spdlog::debug("Entry not confirmed for {}, blocking actionable", symbol);
+                    }
+
+                    for (const auto& r : results) {
+                        if (r.token) {
+                            regime_detector.observe(*r.token);
+                            if (r.near_alert) near_alert.push_back(r.mint);
+                            if (r.scoring == counted) {
+                                band_counts[0][static_cast<size_t>(parse_band(r.band))]++;
+                                for (size_t k = 0; k < r.shadow_count; k++) {
+                                    band_counts[k + 1][static_cast<size_t>(r.shadow_bands[k])]++;
+                                }
+                            }
                         }
-                        
-                        double net_edge = calculate_net_edge(update, state);
-                        if (net_edge < 0) {
-                            spdlog::debug("Net edge negative for {}, forcing heads_up", symbol);
-                            entry_ctx.confirmed = false;
+                        if (r.band != "none") alerting.push_back(&r);
+                        auto& stream_acks = acks[r.stream];
+                        stream_acks.insert(stream_acks.end(), r.msg_ids.begin(), r.msg_ids.end());
+                    }
+
+                    publish_scored_alerts(alerting, config, throttles, *redis);
+
+                    // One round trip per stream acks everything this pass handled
+                    for (const auto& [stream, ids] : acks) {
+                        redis->ack_messages(stream, group, ids);
+                    }
+                    redis->mark_priority_mints(config.priority_mints_key, near_alert,
+                                               kAlertProximityTtlMs);
+                    if (!results.empty()) health.mark_decision();
+
+                    {
+                        std::lock_guard<std::mutex> lock(dropped_mutex);
+                        forget.swap(dropped);
+                    }
+                    if (!forget.empty()) {
+                        std::lock_guard<std::mutex> lock(scored_mutex);
+                        for (const auto& mint : forget) {
+                            regime_detector.forget(mint);
+                            scored.erase(mint);
                         }
-                        
-                        // Determine alert band
-                        std::string band = "none";
-                        if (signals.force_heads_up || !entry_ctx.confirmed) {
-                            if (confidence >= 60) {
-                                band = "heads_up";
-                            }
-                        } else if (confidence >= 85 && !signals.has_risk_flags) {
-                            band = "high_conviction";
-                        } else if (confidence >= threshold) {
-                            band = "actionable";
-                        } else if (confidence >= 60) {
-                            band = "heads_up";
+                        forget.clear();
+                    }
+
+                    int64_t now_ms = util::current_timestamp_ms();
+                    if (now_ms - last_cleanup_ms >= kStaleCleanupIntervalMs) {
+                        auto removed = pool.cleanup_stale(kStaleTokenHours);
+                        throttles.cleanup_old_records(throttle_retention_hours(*scoring_source.current()));
+                        std::lock_guard<std::mutex> lock(scored_mutex);
+                        for (const auto& mint : removed) {
+                            regime_detector.forget(mint);
+                            scored.erase(mint);
                         }
-                        
-                        // Apply throttles and cooldowns
-                        if (band != "none") {
-                            auto throttle_result = throttles.check_and_update(
-                                symbol, band, confidence, signals.reasons
-                            );
-                            
-                            if (throttle_result.suppressed) {
-                                spdlog::debug("Alert suppressed for {}: {}", 
-                                              symbol, throttle_result.reason);
-                                continue;
-                            }
-                            
-                            // Build and publish alert
-                            nlohmann::json alert = build_alert(
-                                band, symbol, update, confidence, 
-                                signals.reasons, entry_ctx, regime_adj, state, pgstore
-                            );
-                            
-                            redis.publish_to_stream(config.stream_alerts, alert);
-                            health.update_last_decision();
-                            
-                            spdlog::info("Published {} alert for {} (C={})", 
-                                         band, symbol, static_cast<int>(confidence));
+                        last_cleanup_ms = now_ms;
+                        report_shadows();
+                    }
+                    // A new version scores every batch after the swap; shadow
+                    // tallies restart with its profiles
+                    if (now_ms - last_reload_ms >= config.scoring_config_reload_sec * 1000LL) {
+                        if (scoring_source.reload()) {
+                            report_shadows();
+                            counted = scoring_source.current();
+                            band_counts.assign(1 + counted->shadows.size(), std::array<size_t, 4>{});
                         }
-                        
-                    } catch (const std::exception& e) {
-                        spdlog::error("Error processing market update: {}", e.what());
+                        last_reload_ms = now_ms;
+                    }
+                    regime_detector.refresh(now_ms);
+
+                    if (results.empty()) {
+                        if (reader_done && pool.drained()) break;
+                        std::this_thread::sleep_for(std::chrono::milliseconds(1));
                     }
+                } catch (const std::exception& e) {
+                    spdlog::error("Error in publisher: {}", e.what());
+                    std::this_thread::sleep_for(std::chrono::seconds(1));
                 }
-                
-                // 2. Handle /signals command requests
-                auto cmd_requests = redis.consume_stream(
-                    config.stream_req,
-                    "analytics_cmd_group",
-                    "analytics_cmd_consumer",
-                    100  // timeout ms
-                );
-                
-                for (const auto& req : cmd_requests) {
+            }
+        });
+
+        // /signals requests block on their own stream instead of being polled
+        std::thread command_thread([&]() {
+            while (!shutdown_requested) {
+                auto cmd_requests = command_redis.read_market_updates(
+                    config.stream_req, cmd_group, consumer, 10, config.stream_block_ms);
+
+                std::vector<std::string> acks;
+                for (const auto& [msg_id, req] : cmd_requests) {
                     try {
-                        if (req["cmd"].get<std::string>() == "signals") {
-                            auto reply = handle_signals_command(req, state, throttles);
-                            redis.publish_to_stream(config.stream_rep, reply);
+                        if (req.value("cmd", "") == "signals") {
+                            nlohmann::json reply;
+                            {
+                                std::lock_guard<std::mutex> lock(scored_mutex);
+                                reply = build_signals_reply(req, scored);
+                            }
+                            command_redis.publish_alert(config.stream_rep, reply);
                             spdlog::debug("Replied to /signals command");
                         }
                     } catch (const std::exception& e) {
                         spdlog::error("Error handling command: {}", e.what());
                     }
+                    acks.push_back(msg_id);
                 }
-                
-                // Update health
-                health.set_redis(redis.ping());
-                health.set_postgres(pgstore.ping());
-                
-                // Small sleep to prevent tight loop
-                std::this_thread::sleep_for(std::chrono::milliseconds(50));
-                
+                command_redis.ack_messages(config.stream_req, cmd_group, acks);
+            }
+        });
+
+        // Health probes run on their own timer, never on the data path
+        std::thread probe_thread([&]() {
+            while (!shutdown_requested) {
+                health.probe();
+                for (int i = 0; i < config.health_probe_sec * 10 && !shutdown_requested; i++) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                }
+            }
+        });
+
+        // Reader thread only: newest entry submitted per owned stream, which
+        // is what a snapshot taken once the pool is idle reflects
+        std::map<std::string, std::string> last_read;
+
+        // rescore: the entries are already in state (restored from a snapshot)
+        // and are only scored and acked, not applied again
+        auto submit_batch = [&](const std::vector<StreamMessage>& messages, bool replay,
+                                bool rescore = false) {
+            std::map<std::string, std::vector<std::string>> rejected;
+            auto jobs = build_jobs(messages, replay, rejected);
+            if (!replay) {
+                for (const auto& [stream, ids] : rejected) {
+                    stream_redis.ack_messages(stream, group, ids);
+                }
+            }
+            for (const auto& msg : messages) {
+                auto& last = last_read[msg.stream];
+                if (util::stream_id_less(last, msg.id)) last = msg.id;
+            }
+            for (auto& job : jobs) {
+                if (rescore) job.updates.clear();
+                pool.submit(std::move(job));
+            }
+        };
+
+        std::thread snapshot_thread;
+        std::atomic<bool> snapshot_running{false};
+        int64_t last_snapshot_ms = util::current_timestamp_ms();
+
+        // Waits for the workers to apply everything read, so the tokens and
+        // stream IDs form one consistent cut; the file is written off-thread
+        // unless sync. Workers copy a token before changing it while the
+        // snapshot still holds it.
+        auto take_snapshot = [&](bool sync) {
+            if (!snapshots || snapshot_running) return;
+            if (snapshot_thread.joinable()) snapshot_thread.join();
+            pool.wait_idle();
+
+            int64_t created_ms = util::current_timestamp_ms();
+            auto tokens = pool.snapshot();
+            auto throttle_state = throttles.export_state();
+            snapshot_running = true;
+            auto write = [&snapshots, &snapshot_running, created_ms, ids = last_read,
+                          tokens = std::move(tokens), throttle_state = std::move(throttle_state)]() {
+                if (snapshots->save(created_ms, ids, tokens, throttle_state)) {
+                    spdlog::info("Wrote snapshot of {} tokens in {} ms", tokens.size(),
+                                 util::current_timestamp_ms() - created_ms);
+                }
+                snapshot_running = false;
+            };
+            if (sync) write();
+            else snapshot_thread = std::thread(write);
+        };
+
+        // Taking over a partition: claim the previous owner's pending entries,
+        // rebuild state from what it had already processed, then score the
+        // claimed entries. New entries follow through ">" reads, so each
+        // mint's updates stay in stream order.
+        auto take_over = [&](int partition, int64_t now_ms) {
+            std::string stream = util::partition_stream(config.stream_mint, partition,
+                                                        config.mint_stream_partitions);
+            stream_redis.create_consumer_group(stream, group);
+
+            // With a snapshot (or warm start) of this partition only the entries after it replay
+            std::string start = std::to_string(now_ms - kReplayWindowMs) + "-0";
+            std::string applied;
+            auto snap_id = restored_ids.find(stream);
+            if (snap_id != restored_ids.end()) {
+                applied = snap_id->second;
+                start = "(" + applied;
+                for (auto& token : restored[stream]) {
+                    pool.restore(std::move(token));
+                }
+                spdlog::info("Restored {} tokens of {} up to {}", restored[stream].size(), stream, applied);
+                restored.erase(stream);
+                restored_ids.erase(snap_id);
+                last_read[stream] = applied;
+            }
+
+            auto pending = stream_redis.autoclaim(stream, group, consumer, 0, config.stream_batch_count);
+            std::unordered_set<std::string> pending_ids;
+            std::vector<StreamMessage> pending_applied, pending_new;
+            for (auto& msg : pending) {
+                pending_ids.insert(msg.id);
+                bool in_snapshot = !applied.empty() && !util::stream_id_less(applied, msg.id);
+                (in_snapshot ? pending_applied : pending_new).push_back(std::move(msg));
+            }
+
+            size_t replayed = 0;
+            std::string end = stream_redis.last_delivered_id(stream, group);
+            if (!end.empty() && end != "0-0") {
+                while (true) {
+                    auto chunk = stream_redis.read_range(stream, start, end, config.stream_batch_count);
+                    if (chunk.empty()) break;
+                    start = "(" + chunk.back().id;
+                    bool last = chunk.size() < static_cast<size_t>(config.stream_batch_count);
+
+                    chunk.erase(std::remove_if(chunk.begin(), chunk.end(),
+                                               [&](const StreamMessage& m) {
+                                                   return pending_ids.count(m.id) > 0;
+                                               }),
+                                chunk.end());
+                    replayed += chunk.size();
+                    submit_batch(chunk, true);
+                    if (last) break;
+                }
+            }
+
+            submit_batch(pending_applied, false, true);
+            submit_batch(pending_new, false);
+            spdlog::info("Took over {}: replayed {} updates, claimed {} pending",
+                         stream, replayed, pending_ids.size());
+        };
+
+        PartitionLeases leases(redis, config.partition_lease_key, consumer,
+                               config.mint_stream_partitions, config.partition_lease_ms);
+        // Lease changes in the order they happened, true for acquired; queued
+        // by the lease thread and applied by the reader between reads
+        std::vector<std::pair<int, bool>> lease_events;
+        bool leases_rebalanced = false;
+        std::mutex lease_mutex;
+        std::atomic<bool> leases_done{false};
+
+        // Leases are renewed on their own timer, so a long takeover replay or
+        // a full scoring queue on the reader cannot let them expire. It keeps
+        // renewing through the shutdown drain, until the leases are released.
+        std::thread lease_thread([&]() {
+            while (!leases_done) {
+                try {
+                    auto changes = leases.rebalance(util::current_timestamp_ms());
+                    std::lock_guard<std::mutex> lock(lease_mutex);
+                    for (int p : changes.released) lease_events.emplace_back(p, false);
+                    for (int p : changes.acquired) lease_events.emplace_back(p, true);
+                    leases_rebalanced = true;
+                } catch (const std::exception& e) {
+                    spdlog::error("Error rebalancing partitions: {}", e.what());
+                }
+                for (int64_t waited = 0; waited < config.partition_lease_ms / 3 && !leases_done;
+                     waited += 100) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(100));
+                }
+            }
+        });
+
+        // Reader thread only: the partitions it reads, as of the last lease
+        // events it applied
+        std::set<int> reading;
+        std::vector<std::string> streams;
+
+        // Reader loop: block until data arrives, then route each mint to its worker
+        spdlog::info("Entering main loop");
+
+        while (!shutdown_requested) {
+            try {
+                int64_t now_ms = util::current_timestamp_ms();
+                std::vector<std::pair<int, bool>> events;
+                bool rebalanced;
+                {
+                    std::lock_guard<std::mutex> lock(lease_mutex);
+                    events.swap(lease_events);
+                    rebalanced = leases_rebalanced;
+                }
+
+                for (auto [p, acquired] : events) {
+                    if (acquired) {
+                        take_over(p, now_ms);
+                        reading.insert(p);
+                        continue;
+                    }
+                    int partitions = config.mint_stream_partitions;
+                    auto removed = pool.remove_if([p, partitions](const TokenState& token) {
+                        return util::mint_partition(token.mint, partitions) == p;
+                    });
+                    last_read.erase(util::partition_stream(config.stream_mint, p, partitions));
+                    reading.erase(p);
+                    std::lock_guard<std::mutex> lock(dropped_mutex);
+                    dropped.insert(dropped.end(), removed.begin(), removed.end());
+                }
+                if (rebalanced) {
+                    // Snapshot partitions not taken over at startup go stale
+                    restored.clear();
+                    restored_ids.clear();
+                }
+                if (!events.empty()) {
+                    streams.clear();
+                    for (int p : reading) {
+                        streams.push_back(util::partition_stream(config.stream_mint, p,
+                                                                 config.mint_stream_partitions));
+                    }
+                }
+
+                if (now_ms - last_snapshot_ms >= config.snapshot_interval_sec * 1000LL) {
+                    last_snapshot_ms = now_ms;
+                    take_snapshot(false);
+                }
+
+                if (streams.empty()) {
+                    std::this_thread::sleep_for(std::chrono::milliseconds(config.stream_block_ms));
+                    continue;
+                }
+
+                // Consume consolidated per-mint updates (one per mint per ingest tick)
+                auto messages = stream_redis.read_streams(group, consumer, streams,
+                                                    config.stream_batch_count,
+                                                    config.stream_block_ms);
+                submit_batch(messages, false);
+
             } catch (const std::exception& e) {
                 spdlog::error("Error in main loop: {}", e.what());
-                health.set_loop_status("error");
                 std::this_thread::sleep_for(std::chrono::seconds(1));
-                health.set_loop_status("running");
             }
         }
-        
+
+        // Workers finish queued jobs, then the publisher drains their results
+        pool.stop();
+        reader_done = true;
+        if (publisher_thread.joinable()) {
+            publisher_thread.join();
+        }
+        if (command_thread.joinable()) {
+            command_thread.join();
+        }
+        if (probe_thread.joinable()) {
+            probe_thread.join();
+        }
+        // Final snapshot after the drain so a restart resumes exactly here
+        if (snapshot_thread.joinable()) snapshot_thread.join();
+        take_snapshot(true);
+        // Everything read has been acked, so a successor starts clean
+        leases_done = true;
+        if (lease_thread.joinable()) lease_thread.join();
+        leases.release_all();
+
         // Graceful shutdown
         spdlog::info("Shutting down gracefully");
-        health.set_loop_status("shutdown");
         http_server.stop();
         if (http_thread.joinable()) {
             http_thread.join();
         }
-        
+
         spdlog::info("Shutdown complete");
         return 0;
-        
+
     } catch (const std::exception& e) {
         spdlog::error("Fatal error: {}", e.what());
         return 1;
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,88 @@
+#include "partition_leases.hpp"
+#include "util.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+
+PartitionLeases::PartitionLeases(std::shared_ptr<RedisBus> redis, const std::string& key_prefix,
+                                 const std::string& owner, int partitions, int64_t lease_ms)
+    : redis_(redis)
+    , key_prefix_(key_prefix)
+    , owner_(owner)
+    , partitions_(std::max(1, partitions))
+    , lease_ms_(lease_ms)
+{}
+
+std::string PartitionLeases::lease_key(int partition) const {
+    return key_prefix_ + "." + std::to_string(partition);
+}
+
+int PartitionLeases::fair_share(int partitions, int live_replicas) {
+    live_replicas = std::max(1, live_replicas);
+    return std::max(1, (partitions + live_replicas - 1) / live_replicas);
+}
+
+std::vector<int> PartitionLeases::claim_order(const std::string& owner, int partitions) {
+    std::vector<int> order;
+    int start = static_cast<int>(util::fnv1a_64(owner) % static_cast<uint64_t>(partitions));
+    for (int i = 0; i < partitions; i++) {
+        order.push_back((start + i) % partitions);
+    }
+    return order;
+}
+
+std::vector<int> PartitionLeases::surplus(const std::set<int>& owned, int share) {
+    std::vector<int> extra;
+    for (auto it = owned.rbegin();
+         it != owned.rend() && owned.size() - extra.size() > static_cast<size_t>(share); ++it) {
+        extra.push_back(*it);
+    }
+    return extra;
+}
+
+PartitionLeases::Changes PartitionLeases::rebalance(int64_t now_ms) {
+    Changes changes;
+
+    int live = redis_->heartbeat(key_prefix_ + ".members", owner_, now_ms, lease_ms_);
+
+    // Renew what we hold; a failed renewal means the lease expired and may
+    // already belong to another replica
+    for (auto it = owned_.begin(); it != owned_.end();) {
+        if (redis_->acquire_lease(lease_key(*it), owner_, lease_ms_)) {
+            ++it;
+        } else {
+            spdlog::warn("Lost lease on partition {}", *it);
+            changes.released.push_back(*it);
+            it = owned_.erase(it);
+        }
+    }
+
+    int share = fair_share(partitions_, live);
+    for (int p : surplus(owned_, share)) {
+        redis_->release_lease(lease_key(p), owner_);
+        owned_.erase(p);
+        changes.released.push_back(p);
+    }
+
+    for (int p : claim_order(owner_, partitions_)) {
+        if (static_cast<int>(owned_.size()) >= share) break;
+        if (owned_.count(p)) continue;
+        if (redis_->acquire_lease(lease_key(p), owner_, lease_ms_)) {
+            owned_.insert(p);
+            changes.acquired.push_back(p);
+        }
+    }
+
+    if (!changes.acquired.empty() || !changes.released.empty()) {
+        spdlog::info("Partitions: {} owned of {} ({} live replicas, +{} -{})",
+                     owned_.size(), partitions_, live,
+                     changes.acquired.size(), changes.released.size());
+    }
+    return changes;
+}
+
+void PartitionLeases::release_all() {
+    for (int p : owned_) {
+        redis_->release_lease(lease_key(p), owner_);
+    }
+    owned_.clear();
+}
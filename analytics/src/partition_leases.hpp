@@ -0,0 +1,47 @@
+#pragma once
+
+#include "redis_bus.hpp"
+#include <cstdint>
+#include <memory>
+#include <set>
+#include <string>
+#include <vector>
+
+// Decides which partitions of the per-mint stream this replica consumes.
+// Each partition is a Redis lease (SET NX PX) renewed on every rebalance;
+// replicas heartbeat into a sorted set, and each one claims or sheds leases
+// toward an even share, so a partition has one consumer at a time and a dead
+// replica's partitions are picked up once its leases expire.
+class PartitionLeases {
+public:
+    struct Changes {
+        std::vector<int> acquired;
+        std::vector<int> released;   // shed for balance or lost to expiry
+    };
+
+    PartitionLeases(std::shared_ptr<RedisBus> redis, const std::string& key_prefix,
+                    const std::string& owner, int partitions, int64_t lease_ms);
+
+    // Call at least every lease_ms / 3
+    Changes rebalance(int64_t now_ms);
+    void release_all();
+
+    const std::set<int>& owned() const { return owned_; }
+    std::string lease_key(int partition) const;
+
+    // ceil(partitions / live), at least 1
+    static int fair_share(int partitions, int live_replicas);
+    // Order in which owner tries free partitions, rotated by owner hash so
+    // replicas starting together do not all race for partition 0
+    static std::vector<int> claim_order(const std::string& owner, int partitions);
+    // Partitions to give up to get down to share, highest first
+    static std::vector<int> surplus(const std::set<int>& owned, int share);
+
+private:
+    std::shared_ptr<RedisBus> redis_;
+    std::string key_prefix_;
+    std::string owner_;
+    int partitions_;
+    int64_t lease_ms_;
+    std::set<int> owned_;
+};
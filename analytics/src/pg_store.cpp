@@ -1,5 +1,12 @@
 #include "pg_store.hpp"
+#include <fmt/format.h>
 #include <spdlog/spdlog.h>
+#include <libpq-fe.h>
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <thread>
+#include <unordered_map>
 
 PostgresStore::PostgresStore(const std::string& dsn) : dsn_(dsn) {}
 
@@ -35,3 +42,187 @@ bool PostgresStore::ping() {
         return false;
     }
 }
+
+namespace {
+
+constexpr char kCopySignature[] = "PGCOPY\n\377\r\n";   // 11 bytes with the NUL
+
+uint64_t read_be(const char* p, size_t n) {
+    uint64_t v = 0;
+    for (size_t i = 0; i < n; i++) {
+        v = (v << 8) | static_cast<unsigned char>(p[i]);
+    }
+    return v;
+}
+
+// Field view of one tuple of COPY ... (FORMAT binary): an int16 field count,
+// then per field an int32 length (-1 for NULL) and the value in network order
+class CopyTuple {
+public:
+    // False for the trailer (field count -1) or a malformed tuple
+    bool parse(const char* p, size_t n) {
+        fields_.clear();
+        if (n < 2) return false;
+        int16_t count = static_cast<int16_t>(read_be(p, 2));
+        if (count < 0) return false;
+        size_t off = 2;
+        for (int16_t i = 0; i < count; i++) {
+            if (n - off < 4) return false;
+            int32_t len = static_cast<int32_t>(read_be(p + off, 4));
+            off += 4;
+            if (len < 0) {
+                fields_.emplace_back(nullptr, 0);
+                continue;
+            }
+            if (n - off < static_cast<size_t>(len)) return false;
+            fields_.emplace_back(p + off, static_cast<size_t>(len));
+            off += static_cast<size_t>(len);
+        }
+        return true;
+    }
+
+    size_t size() const { return fields_.size(); }
+    int64_t int8(size_t i) const { return field(i, 8) ? static_cast<int64_t>(read_be(fields_[i].first, 8)) : 0; }
+    int32_t int4(size_t i) const { return field(i, 4) ? static_cast<int32_t>(read_be(fields_[i].first, 4)) : 0; }
+    bool boolean(size_t i) const { return field(i, 1) && fields_[i].first[0] != 0; }
+    double float8(size_t i) const {
+        if (!field(i, 8)) return 0.0;
+        uint64_t bits = read_be(fields_[i].first, 8);
+        double v;
+        std::memcpy(&v, &bits, sizeof(v));
+        return v;
+    }
+    std::string text(size_t i) const {
+        return fields_[i].first ? std::string(fields_[i].first, fields_[i].second) : std::string();
+    }
+
+private:
+    std::vector<std::pair<const char*, size_t>> fields_;
+
+    bool field(size_t i, size_t width) const {
+        return fields_[i].first && fields_[i].second == width;
+    }
+};
+
+// Runs a COPY ... TO STDOUT (FORMAT binary) and hands each tuple to on_tuple
+template <typename Fn>
+void copy_binary(PGconn* conn, const std::string& sql, Fn on_tuple) {
+    PGresult* res = PQexec(conn, sql.c_str());
+    bool started = PQresultStatus(res) == PGRES_COPY_OUT;
+    PQclear(res);
+    if (!started) throw std::runtime_error(PQerrorMessage(conn));
+
+    CopyTuple tuple;
+    bool header = true;
+    while (true) {
+        char* buf = nullptr;
+        int n = PQgetCopyData(conn, &buf, 0);
+        if (n == -1) break;
+        if (n < 0) throw std::runtime_error(PQerrorMessage(conn));
+
+        const char* p = buf;
+        size_t len = static_cast<size_t>(n);
+        // The file header arrives ahead of the first tuple
+        if (header) {
+            if (len < 19 || std::memcmp(p, kCopySignature, 11) != 0) {
+                PQfreemem(buf);
+                throw std::runtime_error("bad COPY binary header");
+            }
+            size_t skip = 19 + static_cast<size_t>(read_be(p + 15, 4));
+            p += std::min(skip, len);
+            len -= std::min(skip, len);
+            header = false;
+        }
+        if (len > 0 && tuple.parse(p, len)) on_tuple(tuple);
+        PQfreemem(buf);
+    }
+
+    res = PQgetResult(conn);
+    bool ok = PQresultStatus(res) == PGRES_COMMAND_OK;
+    PQclear(res);
+    while ((res = PQgetResult(conn))) PQclear(res);
+    if (!ok) throw std::runtime_error(PQerrorMessage(conn));
+}
+
+} // namespace
+
+bool PostgresStore::load_pool_stats(int64_t since_ms, int64_t until_ms, size_t connections,
+                                    std::vector<PoolInfo>& pools, std::vector<PoolStatRow>& rows) {
+    pools.clear();
+    rows.clear();
+    connections = std::max<size_t>(1, connections);
+    
+    std::unordered_map<int64_t, uint32_t> pool_index;
+    try {
+        auto conn = make_connection();
+        pqxx::work txn(conn);
+        auto result = txn.exec("SELECT id, address, mint_base, mint_quote FROM pools");
+        for (const auto& row : result) {
+            PoolInfo pool{row[0].as<int64_t>(), row[1].as<std::string>(),
+                          row[2].as<std::string>(), row[3].as<std::string>()};
+            pool_index.emplace(pool.id, static_cast<uint32_t>(pools.size()));
+            pools.push_back(std::move(pool));
+        }
+        txn.commit();
+    } catch (const std::exception& e) {
+        spdlog::error("Failed to load pools: {}", e.what());
+        return false;
+    }
+    
+    // Columns are cast to fixed binary types so decoding needs no NUMERIC parser
+    std::vector<std::vector<PoolStatRow>> parts(connections);
+    std::vector<std::string> errors(connections);
+    auto load_part = [&](size_t part) {
+        PGconn* conn = PQconnectdb(dsn_.c_str());
+        try {
+            if (PQstatus(conn) != CONNECTION_OK) {
+                throw std::runtime_error(PQerrorMessage(conn));
+            }
+            std::string sql = fmt::format(
+                "COPY (SELECT pool_id, (extract(epoch FROM ts) * 1000)::int8, price::float8, "
+                "liq_usd::float8, vol24h_usd::float8, spread_pct::float8, impact_1pct_pct::float8, "
+                "route_ok, route_hops, route_dev_pct::float8, dq "
+                "FROM pool_stats_5m WHERE ts >= to_timestamp({:.3f}) AND ts < to_timestamp({:.3f}) "
+                "AND pool_id % {} = {}) TO STDOUT (FORMAT binary)",
+                since_ms / 1000.0, until_ms / 1000.0, connections, part);
+            copy_binary(conn, sql, [&](const CopyTuple& t) {
+                if (t.size() != 11) return;
+                auto it = pool_index.find(t.int8(0));
+                if (it == pool_index.end()) return;
+                PoolStatRow row;
+                row.pool = it->second;
+                row.ts_ms = t.int8(1);
+                row.price = t.float8(2);
+                row.liq_usd = t.float8(3);
+                row.vol24h_usd = t.float8(4);
+                row.spread_pct = t.float8(5);
+                row.impact_1pct_pct = t.float8(6);
+                row.route_ok = t.boolean(7);
+                row.route_hops = t.int4(8);
+                row.route_dev_pct = t.float8(9);
+                row.degraded = t.text(10) == "degraded";
+                parts[part].push_back(row);
+            });
+        } catch (const std::exception& e) {
+            errors[part] = e.what();
+        }
+        PQfinish(conn);
+    };
+    
+    std::vector<std::thread> threads;
+    for (size_t part = 0; part < connections; part++) {
+        threads.emplace_back(load_part, part);
+    }
+    for (auto& t : threads) {
+        t.join();
+    }
+    
+    for (size_t part = 0; part < connections; part++) {
+        if (!errors[part].empty()) {
+            spdlog::error("Failed to copy pool_stats_5m: {}", errors[part]);
+            return false;
+        }
+        rows.insert(rows.end(), parts[part].begin(), parts[part].end());
+    }
+    return true;
+}
@@ -1,5 +1,7 @@
 #pragma once
+#include "warm_start.hpp"
 #include <string>
+#include <vector>
 #include <pqxx/pqxx>
 
 class PostgresStore {
@@ -8,6 +10,12 @@ public:
     void init_schema();
     bool ping();
     
+    // The pools table and pool_stats_5m rows in [since_ms, until_ms), streamed with
+    // COPY (FORMAT binary) over `connections` connections, each taking the
+    // pools with id % connections == its index. False on any error.
+    bool load_pool_stats(int64_t since_ms, int64_t until_ms, size_t connections,
+                         std::vector<PoolInfo>& pools, std::vector<PoolStatRow>& rows);
+    
 private:
     std::string dsn_;
     pqxx::connection make_connection();
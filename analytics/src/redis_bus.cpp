@@ -1,9 +1,16 @@
 #include "redis_bus.hpp"
+#include "util.hpp"
 #include <spdlog/spdlog.h>
+#include <algorithm>
+#include <array>
+#include <iterator>
+#include <optional>
 
-RedisBus::RedisBus(const std::string& redis_url) {
-    redis_ = std::make_shared<sw::redis::Redis>(redis_url);
-    spdlog::info("Connected to Redis: {}", redis_url);
+RedisBus::RedisBus(const std::string& redis_url, size_t connections) {
+    sw::redis::ConnectionPoolOptions pool;
+    pool.size = std::max<size_t>(1, connections);
+    redis_ = std::make_shared<sw::redis::Redis>(sw::redis::ConnectionOptions(redis_url), pool);
+    spdlog::info("Connected to Redis: {} ({} connections)", redis_url, pool.size);
 }
 
 void RedisBus::create_consumer_group(const std::string& stream, const std::string& group) {
@@ -50,6 +57,22 @@ void RedisBus::ack_message(const std::string& stream, const std::string& group,
     }
 }
 
+void RedisBus::ack_messages(const std::string& stream, const std::string& group,
+                            const std::vector<std::string>& msg_ids) {
+    if (msg_ids.empty()) return;
+    constexpr size_t kIdsPerAck = 500;
+    try {
+        auto pipe = redis_->pipeline(false);
+        for (size_t i = 0; i < msg_ids.size(); i += kIdsPerAck) {
+            auto end = msg_ids.begin() + std::min(msg_ids.size(), i + kIdsPerAck);
+            pipe.xack(stream, group, msg_ids.begin() + i, end);
+        }
+        pipe.exec();
+    } catch (const std::exception& e) {
+        spdlog::error("Failed to ack {} messages: {}", msg_ids.size(), e.what());
+    }
+}
+
 void RedisBus::publish_alert(const std::string& stream, const nlohmann::json& data) {
     try {
         std::unordered_map<std::string, std::string> fields;
@@ -60,6 +83,326 @@ void RedisBus::publish_alert(const std::string& stream, const nlohmann::json& da
     }
 }
 
+std::optional<std::string> RedisBus::get_value(const std::string& key) {
+    try {
+        auto value = redis_->get(key);
+        if (value) return *value;
+    } catch (const std::exception& e) {
+        spdlog::warn("Failed to read {}: {}", key, e.what());
+    }
+    return std::nullopt;
+}
+
+void RedisBus::mark_priority_mints(const std::string& key,
+                                   const std::vector<std::string>& mints, int64_t ttl_ms) {
+    if (key.empty() || mints.empty()) return;
+    try {
+        auto expiry = static_cast<double>(util::current_timestamp_ms() + ttl_ms);
+        std::vector<std::pair<std::string, double>> members;
+        members.reserve(mints.size());
+        for (const auto& mint : mints) {
+            members.emplace_back(mint, expiry);
+        }
+        redis_->zadd(key, members.begin(), members.end());
+    } catch (const std::exception& e) {
+        spdlog::warn("Failed to mark priority mints: {}", e.what());
+    }
+}
+
+namespace {
+
+std::optional<nlohmann::json> parse_data_field(const redisReply* fields) {
+    if (!fields || fields->type != REDIS_REPLY_ARRAY) return std::nullopt;
+    for (size_t i = 0; i + 1 < fields->elements; i += 2) {
+        const redisReply* name = fields->element[i];
+        const redisReply* value = fields->element[i + 1];
+        if (std::string(name->str, name->len) == "data") {
+            return nlohmann::json::parse(std::string(value->str, value->len));
+        }
+    }
+    return std::nullopt;
+}
+
+// Acquires the key for owner, or extends it if owner already holds it
+const char* const kAcquireLease =
+    "if redis.call('GET', KEYS[1]) == ARGV[1] then "
+    "  redis.call('PEXPIRE', KEYS[1], ARGV[2]) return 1 "
+    "end "
+    "if redis.call('SET', KEYS[1], ARGV[1], 'NX', 'PX', ARGV[2]) then return 1 end "
+    "return 0";
+
+const char* const kReleaseLease =
+    "if redis.call('GET', KEYS[1]) == ARGV[1] then return redis.call('DEL', KEYS[1]) end "
+    "return 0";
+
+// KEYS: cooldown (mint, band), dedup (mint, reason hash), stop (mint), global
+// sorted set. ARGV: now ms, cooldown ms, guard ms (0 skips), global cap (< 0
+// skips), global member, retention ms (0 keeps nothing, as no window looks
+// back). The string keys hold the last alert's time, so each check applies
+// its own window like ThrottleManager does.
+const char* const kCheckAndRecordAlert =
+    "local now = tonumber(ARGV[1]) "
+    "local since = now - tonumber(ARGV[2]) "
+    "local last = redis.call('GET', KEYS[1]) "
+    "if last and tonumber(last) > since then return 1 end "
+    "last = redis.call('GET', KEYS[2]) "
+    "if last and tonumber(last) > since then return 1 end "
+    "local guard = tonumber(ARGV[3]) "
+    "if guard > 0 then "
+    "  local stop = redis.call('GET', KEYS[3]) "
+    "  if stop and tonumber(stop) > now - guard then return 2 end "
+    "end "
+    "local cap = tonumber(ARGV[4]) "
+    "if cap >= 0 then "
+    "  redis.call('ZREMRANGEBYSCORE', KEYS[4], '-inf', '(' .. (now - 3600000)) "
+    "  if redis.call('ZCARD', KEYS[4]) >= cap then return 3 end "
+    "  redis.call('ZADD', KEYS[4], now, ARGV[5]) "
+    "  redis.call('PEXPIRE', KEYS[4], 3600000) "
+    "end "
+    "if tonumber(ARGV[6]) > 0 then "
+    "  redis.call('SET', KEYS[1], now, 'PX', ARGV[6]) "
+    "  redis.call('SET', KEYS[2], now, 'PX', ARGV[6]) "
+    "end "
+    "return 0";
+
+} // namespace
+
+std::vector<StreamMessage> RedisBus::read_streams(const std::string& group,
+                                                  const std::string& consumer,
+                                                  const std::vector<std::string>& streams,
+                                                  int count, int block_ms) {
+    std::vector<StreamMessage> results;
+    if (streams.empty()) return results;
+    
+    try {
+        std::unordered_map<std::string, std::string> keys;
+        for (const auto& stream : streams) {
+            keys.emplace(stream, ">");
+        }
+        std::unordered_map<std::string, sw::redis::ItemStream> items;
+        redis_->xreadgroup(group, consumer, keys.begin(), keys.end(), count,
+                           std::chrono::milliseconds(block_ms),
+                           std::inserter(items, items.end()));
+        
+        for (const auto& [stream, item_stream] : items) {
+            for (const auto& item : item_stream) {
+                auto it = item.second.find("data");
+                if (it != item.second.end()) {
+                    results.push_back({stream, item.first, nlohmann::json::parse(it->second)});
+                }
+            }
+        }
+    } catch (const std::exception& e) {
+        spdlog::error("Failed to read streams: {}", e.what());
+    }
+    
+    return results;
+}
+
+std::vector<StreamMessage> RedisBus::autoclaim(const std::string& stream, const std::string& group,
+                                               const std::string& consumer, int64_t min_idle_ms,
+                                               int count) {
+    std::vector<StreamMessage> results;
+    std::string cursor = "0-0";
+    
+    try {
+        // Reply: [next cursor, [[id, [field, value, ...] | nil], ...], (deleted ids)]
+        do {
+            auto reply = redis_->command("XAUTOCLAIM", stream, group, consumer,
+                                         std::to_string(min_idle_ms), cursor,
+                                         "COUNT", std::to_string(count));
+            if (!reply || reply->type != REDIS_REPLY_ARRAY || reply->elements < 2) break;
+            
+            cursor.assign(reply->element[0]->str, reply->element[0]->len);
+            const redisReply* entries = reply->element[1];
+            for (size_t i = 0; i < entries->elements; i++) {
+                const redisReply* entry = entries->element[i];
+                if (entry->type != REDIS_REPLY_ARRAY || entry->elements < 2) continue;
+                std::string id(entry->element[0]->str, entry->element[0]->len);
+                auto data = parse_data_field(entry->element[1]);
+                // Trimmed entries come back without fields; they are still
+                // claimed and are acked with the rest
+                results.push_back({stream, id, data ? *data : nlohmann::json()});
+            }
+        } while (cursor != "0-0");
+    } catch (const std::exception& e) {
+        spdlog::error("Failed to autoclaim {}: {}", stream, e.what());
+    }
+    
+    return results;
+}
+
+std::vector<StreamMessage> RedisBus::read_range(const std::string& stream,
+                                                const std::string& start,
+                                                const std::string& end, int count) {
+    std::vector<StreamMessage> results;
+    
+    try {
+        sw::redis::ItemStream items;
+        redis_->xrange(stream, start, end, count, std::back_inserter(items));
+        for (const auto& item : items) {
+            auto it = item.second.find("data");
+            if (it != item.second.end()) {
+                results.push_back({stream, item.first, nlohmann::json::parse(it->second)});
+            }
+        }
+    } catch (const std::exception& e) {
+        spdlog::error("Failed to read range of {}: {}", stream, e.what());
+    }
+    
+    return results;
+}
+
+std::string RedisBus::last_delivered_id(const std::string& stream, const std::string& group) {
+    try {
+        // Reply: one flat [name, value, ...] array per group
+        auto reply = redis_->command("XINFO", "GROUPS", stream);
+        if (!reply || reply->type != REDIS_REPLY_ARRAY) return "";
+        
+        for (size_t g = 0; g < reply->elements; g++) {
+            const redisReply* info = reply->element[g];
+            std::string name, last_id;
+            for (size_t i = 0; i + 1 < info->elements; i += 2) {
+                const redisReply* field = info->element[i];
+                const redisReply* value = info->element[i + 1];
+                if (value->type != REDIS_REPLY_STRING) continue;
+                std::string key(field->str, field->len);
+                if (key == "name") name.assign(value->str, value->len);
+                else if (key == "last-delivered-id") last_id.assign(value->str, value->len);
+            }
+            if (name == group) return last_id;
+        }
+    } catch (const std::exception& e) {
+        spdlog::warn("Failed to read group info of {}: {}", stream, e.what());
+    }
+    return "";
+}
+
+bool RedisBus::acquire_lease(const std::string& key, const std::string& owner, int64_t ttl_ms) {
+    try {
+        std::vector<std::string> keys = {key};
+        std::vector<std::string> args = {owner, std::to_string(ttl_ms)};
+        return redis_->eval<long long>(kAcquireLease, keys.begin(), keys.end(),
+                                       args.begin(), args.end()) == 1;
+    } catch (const std::exception& e) {
+        spdlog::warn("Failed to acquire lease {}: {}", key, e.what());
+        return false;
+    }
+}
+
+void RedisBus::release_lease(const std::string& key, const std::string& owner) {
+    try {
+        std::vector<std::string> keys = {key};
+        std::vector<std::string> args = {owner};
+        redis_->eval<long long>(kReleaseLease, keys.begin(), keys.end(),
+                                args.begin(), args.end());
+    } catch (const std::exception& e) {
+        spdlog::warn("Failed to release lease {}: {}", key, e.what());
+    }
+}
+
+int RedisBus::heartbeat(const std::string& key, const std::string& owner, int64_t now_ms,
+                        int64_t ttl_ms) {
+    try {
+        auto pipe = redis_->pipeline(false);
+        pipe.zadd(key, owner, static_cast<double>(now_ms));
+        pipe.zremrangebyscore(key, sw::redis::RightBoundedInterval<double>(
+            static_cast<double>(now_ms - ttl_ms), sw::redis::BoundType::RIGHT_OPEN));
+        pipe.zcard(key);
+        auto replies = pipe.exec();
+        return static_cast<int>(replies.get<long long>(2));
+    } catch (const std::exception& e) {
+        spdlog::warn("Failed to heartbeat {}: {}", key, e.what());
+        return 1;
+    }
+}
+
+std::vector<int> RedisBus::check_and_record_alerts(const std::string& prefix,
+                                                   const std::vector<ThrottleCheck>& checks,
+                                                   int64_t now_ms, int64_t retention_ms) {
+    if (checks.empty()) return {};
+    
+    const std::string now = std::to_string(now_ms);
+    const std::string retention = std::to_string(retention_ms);
+    const std::string global_key = prefix + ".global";
+    std::vector<std::array<std::string, 4>> keys;
+    std::vector<std::array<std::string, 6>> args;
+    for (const auto& c : checks) {
+        keys.push_back({prefix + ".cooldown." + c.symbol + "." + c.band,
+                        prefix + ".dedup." + c.symbol + "." + c.reason_hash,
+                        prefix + ".stop." + c.symbol,
+                        global_key});
+        args.push_back({now,
+                        std::to_string(c.cooldown_hours * 3600LL * 1000),
+                        std::to_string(c.reentry_guard_hours * 3600LL * 1000),
+                        std::to_string(c.global_max_per_hour),
+                        c.symbol + "." + c.band + "." + now,
+                        retention});
+    }
+    
+    // Checks Redis has not answered yet. A restarted Redis has lost the
+    // script: load it again and rerun the checks that missed it, once.
+    std::vector<int> gates(checks.size(), -1);
+    std::vector<size_t> pending(checks.size());
+    for (size_t i = 0; i < pending.size(); i++) pending[i] = i;
+    
+    for (int attempt = 0; attempt < 2 && !pending.empty(); attempt++) {
+        std::vector<size_t> missing_script;
+        try {
+            std::string sha;
+            {
+                std::lock_guard<std::mutex> lock(script_mutex_);
+                if (throttle_script_sha_.empty()) {
+                    throttle_script_sha_ = redis_->script_load(kCheckAndRecordAlert);
+                }
+                sha = throttle_script_sha_;
+            }
+            
+            auto pipe = redis_->pipeline(false);
+            for (size_t i : pending) {
+                pipe.evalsha(sha, keys[i].begin(), keys[i].end(), args[i].begin(), args[i].end());
+            }
+            auto replies = pipe.exec();
+            // An error reply fails only its own check; the others ran and
+            // may have recorded, so they keep their answers
+            for (size_t n = 0; n < pending.size(); n++) {
+                size_t i = pending[n];
+                try {
+                    gates[i] = static_cast<int>(replies.get<long long>(n));
+                } catch (const std::exception& e) {
+                    if (attempt == 0 && std::string(e.what()).find("NOSCRIPT") != std::string::npos) {
+                        missing_script.push_back(i);
+                    } else {
+                        spdlog::warn("Failed to check {} alert for {} against shared throttles: {}",
+                                     checks[i].band, checks[i].symbol, e.what());
+                    }
+                }
+            }
+        } catch (const std::exception& e) {
+            spdlog::warn("Failed to check {} alerts against shared throttles: {}",
+                         pending.size(), e.what());
+            break;
+        }
+        if (!missing_script.empty()) {
+            std::lock_guard<std::mutex> lock(script_mutex_);
+            throttle_script_sha_.clear();
+        }
+        pending = std::move(missing_script);
+    }
+    return gates;
+}
+
+void RedisBus::record_stop(const std::string& prefix, const std::string& symbol,
+                           int64_t now_ms, int64_t retention_ms) {
+    if (retention_ms <= 0) return;
+    try {
+        redis_->set(prefix + ".stop." + symbol, std::to_string(now_ms),
+                    std::chrono::milliseconds(retention_ms));
+    } catch (const std::exception& e) {
+        spdlog::warn("Failed to record shared stop for {}: {}", symbol, e.what());
+    }
+}
+
 bool RedisBus::ping() {
     try {
         redis_->ping();
@@ -1,13 +1,25 @@
 #pragma once
+#include "throttles.hpp"
+#include <cstdint>
 #include <string>
 #include <memory>
+#include <mutex>
+#include <optional>
 #include <vector>
 #include <nlohmann/json.hpp>
 #include <sw/redis++/redis++.h>
 
+struct StreamMessage {
+    std::string stream;
+    std::string id;
+    nlohmann::json data;
+};
+
 class RedisBus {
 public:
-    explicit RedisBus(const std::string& redis_url);
+    // A blocking read holds a connection for its whole timeout, so a bus
+    // shared by several threads needs a connection for each of them
+    explicit RedisBus(const std::string& redis_url, size_t connections = 1);
     
     void create_consumer_group(const std::string& stream, const std::string& group);
     std::vector<std::pair<std::string, nlohmann::json>>
@@ -15,9 +27,55 @@ public:
                            const std::string& consumer, int count, int block_ms);
     void ack_message(const std::string& stream, const std::string& group,
                     const std::string& msg_id);
+    // Acks a whole batch in one round trip (multi-ID XACKs, pipelined in chunks)
+    void ack_messages(const std::string& stream, const std::string& group,
+                      const std::vector<std::string>& msg_ids);
     void publish_alert(const std::string& stream, const nlohmann::json& data);
+    // GET; nullopt if the key is missing or Redis failed
+    std::optional<std::string> get_value(const std::string& key);
+    // ZADD mints to the ingestor's refresh-priority set, each expiring after ttl_ms
+    void mark_priority_mints(const std::string& key, const std::vector<std::string>& mints,
+                             int64_t ttl_ms);
+    
+    // XREADGROUP over several streams at once (">" on each)
+    std::vector<StreamMessage> read_streams(const std::string& group, const std::string& consumer,
+                                            const std::vector<std::string>& streams,
+                                            int count, int block_ms);
+    // XAUTOCLAIM every pending entry idle for at least min_idle_ms, oldest first
+    std::vector<StreamMessage> autoclaim(const std::string& stream, const std::string& group,
+                                         const std::string& consumer, int64_t min_idle_ms,
+                                         int count);
+    // One XRANGE chunk of at most count entries; start may be exclusive ("(<id>")
+    std::vector<StreamMessage> read_range(const std::string& stream, const std::string& start,
+                                          const std::string& end, int count);
+    // Last entry ID delivered to group (XINFO GROUPS); empty if unknown
+    std::string last_delivered_id(const std::string& stream, const std::string& group);
+    
+    // Partition leases: acquire also renews a lease this owner already holds
+    bool acquire_lease(const std::string& key, const std::string& owner, int64_t ttl_ms);
+    void release_lease(const std::string& key, const std::string& owner);
+    // Records owner as live and returns the number of live members
+    int heartbeat(const std::string& key, const std::string& owner, int64_t now_ms,
+                  int64_t ttl_ms);
+    
+    // Shared throttles: runs each check against the keys under prefix and
+    // records the alerts that pass, atomically per alert and in order, in one
+    // pipelined round trip. Per check 0 passes, 1 cooldown, 2 re-entry guard,
+    // 3 global cap, or -1 if Redis did not answer it; gate those locally.
+    std::vector<int> check_and_record_alerts(const std::string& prefix,
+                                             const std::vector<ThrottleCheck>& checks,
+                                             int64_t now_ms, int64_t retention_ms);
+    // Starts symbol's re-entry guard for every replica, as
+    // ThrottleManager::record_stop does in process. Nothing in the service
+    // records stops yet, in process or here, so the shared guard is only as
+    // live as the local one.
+    void record_stop(const std::string& prefix, const std::string& symbol,
+                     int64_t now_ms, int64_t retention_ms);
+    
     bool ping();
     
 private:
     std::shared_ptr<sw::redis::Redis> redis_;
+    std::mutex script_mutex_;
+    std::string throttle_script_sha_;   // SCRIPT LOAD result, reloaded on NOSCRIPT
 };
\ No newline at end of file
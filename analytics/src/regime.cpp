@@ -1,14 +1,32 @@
 #include "regime.hpp"
 #include <algorithm>
+#include <atomic>
+#include <iterator>
 #include <spdlog/spdlog.h>
 
-RegimeAssessment RegimeDetector::assess_regime(StateManager& state_mgr) {
-    RegimeAssessment result;
-    
-    // Compute 3 regime indicators
-    result.sol_positive = (compute_sol_24h_return(state_mgr) > 0);
-    result.median_positive = (compute_median_24h_return(state_mgr) > 0);
-    result.above_vwap_majority = (compute_above_vwap_ratio(state_mgr) > 0.5);
+RegimeDetector::RegimeDetector(int64_t refresh_interval_ms)
+    : refresh_interval_ms_(refresh_interval_ms)
+    , last_refresh_ms_(-1)
+    , last_universe_(0)
+    , sol_24h_return_(0.0)
+    , above_vwap_(0)
+    , with_vwap_(0)
+{
+    // Neutral until the first refresh
+    auto initial = std::make_shared<RegimeAssessment>(classify(false, false, false));
+    initial->regime = MarketRegime::Neutral;
+    initial->threshold_adjustment = 0;
+    initial->size_adjustment_pct = 0.0;
+    initial->description = "Neutral: Base parameters";
+    snapshot_ = initial;
+}
+
+RegimeAssessment RegimeDetector::classify(bool sol_positive, bool median_positive,
+                                          bool above_vwap_majority) {
+    RegimeAssessment result{};
+    result.sol_positive = sol_positive;
+    result.median_positive = median_positive;
+    result.above_vwap_majority = above_vwap_majority;
     
     // Count positive indicators
     int positive_count = 0;
@@ -34,68 +52,130 @@ RegimeAssessment RegimeDetector::assess_regime(StateManager& state_mgr) {
         result.description = "Neutral: Base parameters";
     }
     
-    spdlog::info("Regime: {} (SOL={}, median={}, VWAP={})",
-                 result.description,
-                 result.sol_positive ? "+" : "-",
-                 result.median_positive ? "+" : "-",
-                 result.above_vwap_majority ? "+" : "-");
-    
     return result;
 }
 
-double RegimeDetector::compute_sol_24h_return(StateManager& state_mgr) {
-    auto sol_state = state_mgr.get_token("SOL");
-    if (!sol_state) return 0.0;
+void RegimeDetector::observe(const TokenState& token) {
+    double m24h = token.compute_m24h();
     
-    return sol_state->compute_m24h();
-}
-
-double RegimeDetector::compute_median_24h_return(StateManager& state_mgr) {
-    std::vector<double> returns;
-    
-    auto symbols = state_mgr.get_all_symbols();
-    for (const auto& sym : symbols) {
-        auto state = state_mgr.get_token(sym);
-        if (state) {
-            returns.push_back(state->compute_m24h());
-        }
+    // 24h VWAP proxy from the running sums
+    int side = -1;
+    if (token.stats.vwap_den.sum > 0) {
+        double vwap_proxy = token.stats.vwap_num.sum / token.stats.vwap_den.sum;
+        side = token.latest.price > vwap_proxy ? 1 : 0;
     }
     
-    if (returns.empty()) return 0.0;
+    if (token.mint == kSolMint) sol_24h_return_ = m24h;
+    
+    auto [it, inserted] = mints_.try_emplace(token.mint, MintEntry{m24h, side});
+    if (inserted) {
+        insert_return(m24h);
+        tally_vwap(side, 1);
+        return;
+    }
     
-    std::sort(returns.begin(), returns.end());
-    return returns[returns.size() / 2];
+    MintEntry& entry = it->second;
+    if (entry.m24h != m24h) {
+        erase_return(entry.m24h);
+        insert_return(m24h);
+        entry.m24h = m24h;
+    }
+    if (entry.vwap_side != side) {
+        tally_vwap(entry.vwap_side, -1);
+        tally_vwap(side, 1);
+        entry.vwap_side = side;
+    }
 }
 
-double RegimeDetector::compute_above_vwap_ratio(StateManager& state_mgr) {
-    int above_count = 0;
-    int total_count = 0;
+void RegimeDetector::forget(const std::string& mint) {
+    auto it = mints_.find(mint);
+    if (it == mints_.end()) return;
     
-    auto symbols = state_mgr.get_all_symbols();
-    for (const auto& sym : symbols) {
-        auto state = state_mgr.get_token(sym);
-        if (!state) continue;
-        
-        // Compute 24h VWAP proxy
-        double vwap_proxy = 0.0;
-        double vol_sum = 0.0;
-        
-        for (const auto& md : state->history_24h) {
-            vwap_proxy += md.price * md.bar_5m.v_usd;
-            vol_sum += md.bar_5m.v_usd;
-        }
-        
-        if (vol_sum > 0) {
-            vwap_proxy /= vol_sum;
-            
-            if (state->latest.price > vwap_proxy) {
-                above_count++;
-            }
-            total_count++;
-        }
+    erase_return(it->second.m24h);
+    tally_vwap(it->second.vwap_side, -1);
+    if (mint == kSolMint) sol_24h_return_ = 0.0;
+    mints_.erase(it);
+}
+
+bool RegimeDetector::refresh(int64_t now_ms, bool force) {
+    if (!force && last_refresh_ms_ >= 0 && mints_.size() == last_universe_ &&
+        now_ms - last_refresh_ms_ < refresh_interval_ms_) {
+        return false;
     }
     
-    if (total_count == 0) return 0.5;
+    auto next = std::make_shared<RegimeAssessment>(
+        classify(sol_24h_return_ > 0, median_24h_return() > 0, above_vwap_ratio() > 0.5));
+    next->sol_24h_return = sol_24h_return_;
+    next->median_24h_return = median_24h_return();
+    next->above_vwap_ratio = above_vwap_ratio();
+    next->universe = mints_.size();
+    next->computed_ms = now_ms;
     
-    return static_cast<double>(above_count) / total_count;
-}
\ No newline at end of file
+    auto previous = current();
+    if (previous->regime != next->regime || last_refresh_ms_ < 0) {
+        spdlog::info("Regime: {} (SOL={}, median={}, VWAP={}, {} mints)",
+                     next->description,
+                     next->sol_positive ? "+" : "-",
+                     next->median_positive ? "+" : "-",
+                     next->above_vwap_majority ? "+" : "-",
+                     next->universe);
+    }
+    
+    std::atomic_store(&snapshot_, std::shared_ptr<const RegimeAssessment>(next));
+    last_refresh_ms_ = now_ms;
+    last_universe_ = mints_.size();
+    return true;
+}
+
+std::shared_ptr<const RegimeAssessment> RegimeDetector::current() const {
+    return std::atomic_load(&snapshot_);
+}
+
+double RegimeDetector::median_24h_return() const {
+    if (upper_.empty()) return 0.0;
+    return *upper_.begin();
+}
+
+double RegimeDetector::above_vwap_ratio() const {
+    if (with_vwap_ == 0) return 0.5;
+    return static_cast<double>(above_vwap_) / with_vwap_;
+}
+
+void RegimeDetector::insert_return(double r) {
+    if (!upper_.empty() && r < *upper_.begin()) lower_.insert(r);
+    else upper_.insert(r);
+    rebalance();
+}
+
+void RegimeDetector::erase_return(double r) {
+    // Equal values may sit on either side of the split
+    auto it = upper_.find(r);
+    if (it != upper_.end()) {
+        upper_.erase(it);
+    } else {
+        it = lower_.find(r);
+        if (it != lower_.end()) lower_.erase(it);
+    }
+    rebalance();
+}
+
+void RegimeDetector::rebalance() {
+    // Keep |lower_| == n / 2
+    size_t n = lower_.size() + upper_.size();
+    while (lower_.size() > n / 2) {
+        auto it = std::prev(lower_.end());
+        upper_.insert(*it);
+        lower_.erase(it);
+    }
+    while (lower_.size() < n / 2) {
+        auto it = upper_.begin();
+        lower_.insert(*it);
+        upper_.erase(it);
+    }
+}
+
+void RegimeDetector::tally_vwap(int side, int delta) {
+    if (side < 0) return;
+    with_vwap_ += delta;
+    if (side == 1) above_vwap_ += delta;
+}
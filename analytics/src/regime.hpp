@@ -1,6 +1,9 @@
 #pragma once
 
 #include "state.hpp"
+#include <memory>
+#include <set>
+#include <unordered_map>
 #include <vector>
 
 enum class MarketRegime {
@@ -19,14 +22,67 @@ struct RegimeAssessment {
     bool above_vwap_majority;
     
     std::string description;
+    
+    // Inputs behind the snapshot
+    double sol_24h_return;
+    double median_24h_return;
+    double above_vwap_ratio;
+    size_t universe;
+    int64_t computed_ms;
 };
 
+// Keeps the regime inputs as running tallies and publishes the assessment as
+// an immutable snapshot. observe() updates one mint's contribution in
+// O(log N); readers take the snapshot with a single atomic load.
+//
+// observe/forget/refresh are called from the scoring loop only; current()
+// may be called from any thread.
 class RegimeDetector {
 public:
-    static RegimeAssessment assess_regime(StateManager& state_mgr);
+    explicit RegimeDetector(int64_t refresh_interval_ms = 60000);
+    
+    // Records the mint's latest m24h and whether it trades above its 24h VWAP
+    void observe(const TokenState& token);
+    void forget(const std::string& mint);
+    
+    // Republishes the snapshot once the interval has elapsed or the universe
+    // changed size since the last one; returns true if it did
+    bool refresh(int64_t now_ms, bool force = false);
+    
+    std::shared_ptr<const RegimeAssessment> current() const;
+    
+    double median_24h_return() const;
+    double above_vwap_ratio() const;
+    size_t universe() const { return mints_.size(); }
+    
+    static RegimeAssessment classify(bool sol_positive, bool median_positive,
+                                     bool above_vwap_majority);
     
 private:
-    static double compute_sol_24h_return(StateManager& state_mgr);
-    static double compute_median_24h_return(StateManager& state_mgr);
-    static double compute_above_vwap_ratio(StateManager& state_mgr);
-};
\ No newline at end of file
+    struct MintEntry {
+        double m24h;
+        int vwap_side;   // 1 above, 0 at or below, -1 no volume yet
+    };
+    
+    int64_t refresh_interval_ms_;
+    int64_t last_refresh_ms_;   // -1 until the first snapshot
+    size_t last_universe_;
+    
+    std::unordered_map<std::string, MintEntry> mints_;
+    double sol_24h_return_;
+    
+    // Order statistic for the median: upper_ holds the sorted returns from
+    // index n/2 up, so *upper_.begin() is returns[n/2]
+    std::multiset<double> lower_;
+    std::multiset<double> upper_;
+    
+    int above_vwap_;
+    int with_vwap_;
+    
+    std::shared_ptr<const RegimeAssessment> snapshot_;
+    
+    void insert_return(double r);
+    void erase_return(double r);
+    void rebalance();
+    void tally_vwap(int side, int delta);
+};
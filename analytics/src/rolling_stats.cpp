@@ -0,0 +1,114 @@
+#include "rolling_stats.hpp"
+#include "state.hpp"
+#include <algorithm>
+#include <cmath>
+
+double WindowSum::variance() const {
+    if (count == 0) return 0.0;
+    double m = sum / count;
+    return std::max(0.0, sum_sq / count - m * m);
+}
+
+void WindowExtremum::push(uint64_t seq, double value) {
+    // Expire first so the ring always has a free slot for the new entry
+    while (size_ > 0 && at(0).first + length_ <= seq) {
+        head_ = (head_ + 1) % length_;
+        size_--;
+    }
+    // Drop entries the new value dominates; they can never be the extremum again
+    while (size_ > 0 &&
+           (is_max_ ? at(size_ - 1).second <= value : at(size_ - 1).second >= value)) {
+        size_--;
+    }
+    at(size_) = {seq, value};
+    size_++;
+}
+
+double WindowExtremum::value() const {
+    if (size_ == 0) return is_max_ ? -HUGE_VAL : HUGE_VAL;
+    return ring_[head_].second;
+}
+
+RollingStats::RollingStats(size_t capacity)
+    : low_recent(kStructureWindow, 0, false)
+    , low_prev(kStructureWindow, kStructureWindow, false)
+    , high_retest(kRetestWindow - kRetestPullback, kRetestPullback, true)
+    , low_retest(kRetestPullback, 0, false)
+    , high_pullback(kQuickPullbackWindow - kQuickPullback, kQuickPullback, true)
+    , low_pullback(kQuickPullback, 0, false)
+    , high_24h(capacity, 0, true)
+    , price_60(WindowSum::Source::Price, kVolatilityWindow)
+    , vol_recent(WindowSum::Source::Vol5m, kVolumeWindow)
+    , vol_100(WindowSum::Source::Vol5m, 2 * kVolumeWindow)
+    , vwap_num(WindowSum::Source::PriceVol5m, capacity)
+    , vwap_den(WindowSum::Source::Vol5m, capacity)
+    , seq_(0)
+    , since_rebuild_(0)
+{}
+
+double RollingStats::source_value(const TokenHistory& history, WindowSum::Source src, size_t i) {
+    switch (src) {
+        case WindowSum::Source::Price: return history.price(i);
+        case WindowSum::Source::Vol5m: return history.vol_5m(i);
+        case WindowSum::Source::PriceVol5m: return history.price(i) * history.vol_5m(i);
+    }
+    return 0.0;
+}
+
+void RollingStats::push(TokenHistory& history, const MarketData& md) {
+    // Values leaving each sum window are read before the ring overwrites them
+    size_t n = history.size();
+    for_each_sum([&](WindowSum& w) {
+        if (n >= w.length) w.remove(source_value(history, w.source, n - w.length));
+    });
+
+    history.push(md);
+    n = history.size();
+
+    // Entering values come back out of history so adds and removes see the
+    // same float-rounded numbers
+    for_each_sum([&](WindowSum& w) {
+        w.add(source_value(history, w.source, n - 1));
+    });
+
+    for_each_extremum([&](WindowExtremum& e) {
+        if (seq_ >= e.lag()) {
+            e.push(seq_ - e.lag(), history.price(n - 1 - e.lag()));
+        }
+    });
+    seq_++;
+
+    if (++since_rebuild_ >= history.capacity()) {
+        rebuild(history);
+    }
+}
+
+void RollingStats::rebuild(const TokenHistory& history) {
+    size_t n = history.size();
+    for_each_sum([&](WindowSum& w) {
+        w.reset();
+        for (size_t i = n - std::min(n, w.length); i < n; i++) {
+            w.add(source_value(history, w.source, i));
+        }
+    });
+    since_rebuild_ = 0;
+}
+
+void RollingStats::restore(const TokenHistory& history) {
+    clear();
+    size_t n = history.size();
+    for (size_t i = 0; i < n; i++) {
+        for_each_extremum([&](WindowExtremum& e) {
+            if (i >= e.lag()) e.push(i - e.lag(), history.price(i - e.lag()));
+        });
+    }
+    seq_ = n;
+    rebuild(history);
+}
+
+void RollingStats::clear() {
+    for_each_sum([](WindowSum& w) { w.reset(); });
+    for_each_extremum([](WindowExtremum& e) { e.reset(); });
+    seq_ = 0;
+    since_rebuild_ = 0;
+}
@@ -0,0 +1,116 @@
+#pragma once
+
+#include "token_history.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <algorithm>
+#include <initializer_list>
+#include <utility>
+#include <vector>
+
+struct MarketData;
+
+// Sum and sum of squares over the last `length` history entries. Values are
+// added and removed by RollingStats as entries enter and leave the window.
+struct WindowSum {
+    enum class Source { Price, Vol5m, PriceVol5m };
+
+    Source source;
+    size_t length;
+    double sum = 0.0;
+    double sum_sq = 0.0;
+    size_t count = 0;
+
+    WindowSum(Source src, size_t len) : source(src), length(len) {}
+
+    void add(double x) { sum += x; sum_sq += x * x; count++; }
+    void remove(double x) { sum -= x; sum_sq -= x * x; count--; }
+    void reset() { sum = 0.0; sum_sq = 0.0; count = 0; }
+
+    bool full() const { return count >= length; }
+    double mean() const { return count > 0 ? sum / count : 0.0; }
+    double variance() const;   // population variance, clamped at 0
+};
+
+// Min or max over a window of `length` entries ending `lag` entries before the
+// newest, kept as a monotonic deque: each entry is pushed and popped once. The
+// deque never holds more than `length` entries, so it lives in a ring sized
+// once at construction and sliding it never allocates.
+class WindowExtremum {
+public:
+    WindowExtremum(size_t length, size_t lag, bool is_max)
+        : length_(std::max<size_t>(1, length)), lag_(lag), is_max_(is_max), ring_(length_) {}
+
+    size_t lag() const { return lag_; }
+
+    // seq is the entering entry's position in the token's full update sequence
+    void push(uint64_t seq, double value);
+    void reset() { head_ = 0; size_ = 0; }
+
+    bool empty() const { return size_ == 0; }
+    // +inf (min) or -inf (max) when empty
+    double value() const;
+
+private:
+    size_t length_;
+    size_t lag_;
+    bool is_max_;
+    std::vector<std::pair<uint64_t, double>> ring_;   // length_ slots
+    size_t head_ = 0;                                 // oldest entry
+    size_t size_ = 0;
+
+    std::pair<uint64_t, double>& at(size_t i) { return ring_[(head_ + i) % length_]; }
+};
+
+// Per-token rolling statistics, slid in O(1) per update, so every signal reads
+// its window aggregate in constant time regardless of window length. Window
+// lengths are in history entries and match the scans they replace.
+class RollingStats {
+public:
+    static constexpr size_t kStructureWindow = 10;    // S5 lows
+    static constexpr size_t kVolatilityWindow = 60;   // S6
+    static constexpr size_t kVolumeWindow = 50;       // S9, recent vs previous
+    static constexpr size_t kRetestWindow = 20;       // retest/hold: 15 high + 5 pullback
+    static constexpr size_t kRetestPullback = 5;
+    static constexpr size_t kQuickPullbackWindow = 30;
+    static constexpr size_t kQuickPullback = 15;
+
+    explicit RollingStats(size_t capacity = TokenHistory::kDefaultCapacity);
+
+    // Pushes md into history and slides every window
+    void push(TokenHistory& history, const MarketData& md);
+    void clear();
+
+    // Exact recompute from history; run periodically to shed float drift
+    void rebuild(const TokenHistory& history);
+    // Rebuilds every window, extrema included, from history alone (snapshot load)
+    void restore(const TokenHistory& history);
+
+    WindowExtremum low_recent;        // last 10
+    WindowExtremum low_prev;          // the 10 before those
+    WindowExtremum high_retest;       // [n-20, n-5)
+    WindowExtremum low_retest;        // last 5
+    WindowExtremum high_pullback;     // [n-30, n-15)
+    WindowExtremum low_pullback;      // last 15
+    WindowExtremum high_24h;          // whole history
+
+    WindowSum price_60;
+    WindowSum vol_recent;             // last 50
+    WindowSum vol_100;                // last 100; previous 50 = vol_100 - vol_recent
+    WindowSum vwap_num;               // Σ price × 5m volume over the whole history
+    WindowSum vwap_den;               // Σ 5m volume over the whole history
+
+private:
+    uint64_t seq_;            // updates seen, including evicted ones
+    size_t since_rebuild_;
+
+    template <typename Fn> void for_each_extremum(Fn fn) {
+        for (WindowExtremum* e : {&low_recent, &low_prev, &high_retest, &low_retest,
+                                  &high_pullback, &low_pullback, &high_24h}) fn(*e);
+    }
+    template <typename Fn> void for_each_sum(Fn fn) {
+        for (WindowSum* w : {&price_60, &vol_recent, &vol_100, &vwap_num, &vwap_den}) fn(*w);
+    }
+
+    static double source_value(const TokenHistory& history, WindowSum::Source src, size_t i);
+};
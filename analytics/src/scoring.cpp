@@ -1,14 +1,22 @@
 #include "scoring.hpp"
 #include <spdlog/spdlog.h>
+#include <fmt/format.h>
 #include <algorithm>
 
+const char* reason_text(Reason reason) {
+    switch (reason) {
+        case Reason::NotOnMirroredLists: return "Not on widely mirrored lists";
+    }
+    return "";
+}
+
+std::string ReasonSet::key() const {
+    return fmt::format("{:x}", bits);
+}
+
 ConfidenceScorer::ConfidenceScorer(const ScoringWeights& weights)
     : weights_(weights) {}
 
-ConfidenceResult ConfidenceScorer::compute_confidence(const TokenState& state,
-                                                      const SignalScores& signals) const {
-    ConfidenceResult result;
-    
 ConfidenceResult ConfidenceScorer::compute_confidence(const TokenState& state,
                                                       const SignalScores& signals) const {
     ConfidenceResult result;
@@ -47,7 +55,7 @@ ConfidenceResult ConfidenceScorer::compute_confidence(const TokenState& state,
     // Token list hygiene penalty (N1)
     if (signals.N1 < 1.0) {
         result.penalties += 10.0;
-        result.reasons.push_back("Not on widely mirrored lists");
+        result.reasons.add(Reason::NotOnMirroredLists);
     }
     
     // Final confidence = max(0, R - P)
@@ -2,6 +2,8 @@
 
 #include "signals.hpp"
 #include "state.hpp"
+#include <cstdint>
+#include <string>
 
 // v1.1 weights for confidence calculation
 struct ScoringWeights {
@@ -17,6 +19,34 @@ struct ScoringWeights {
     double w_S10 = 0.02; // Route
 };
 
+// Why a confidence came out as it did. Codes, not text, so scoring never
+// builds strings; reason_text renders them when an alert is published.
+enum class Reason : uint8_t {
+    NotOnMirroredLists
+};
+
+const char* reason_text(Reason reason);
+
+// A set of Reasons as one bit per code
+struct ReasonSet {
+    uint32_t bits = 0;
+
+    void add(Reason r) { bits |= 1u << static_cast<unsigned>(r); }
+    bool has(Reason r) const { return bits & (1u << static_cast<unsigned>(r)); }
+    bool empty() const { return bits == 0; }
+    bool operator==(const ReasonSet& o) const { return bits == o.bits; }
+    bool operator!=(const ReasonSet& o) const { return bits != o.bits; }
+    // Calls fn(reason) for each member, in code order
+    template <typename Fn>
+    void for_each(Fn&& fn) const {
+        for (unsigned code = 0; code < 32; code++) {
+            if (bits & (1u << code)) fn(static_cast<Reason>(code));
+        }
+    }
+    // Throttle dedup key: the bits in hex, short enough to stay in SSO
+    std::string key() const;
+};
+
 struct ConfidenceResult {
     double raw_score;        // R = weighted sum before penalties
     double data_quality;     // DQ factor (0.7-1.0)
@@ -28,7 +58,7 @@ struct ConfidenceResult {
     bool dq_forced_headsup;  // DQ <0.7 → force Heads-up
     
     std::string band;        // "heads_up", "actionable", "high_conviction"
-    std::vector<std::string> reasons;
+    ReasonSet reasons;
 };
 
 class ConfidenceScorer {
@@ -38,11 +68,12 @@ public:
     ConfidenceResult compute_confidence(const TokenState& state, 
                                        const SignalScores& signals) const;
     
+    std::string determine_band(double confidence, const ConfidenceResult& result, 
+                               int regime_adjusted_threshold) const;
+    
 private:
     ScoringWeights weights_;
     
     double compute_data_quality(const SignalScores& signals, const TokenState& state) const;
     double compute_penalties(const TokenState& state, const SignalScores& signals) const;
-    std::string determine_band(double confidence, const ConfidenceResult& result, 
-                               int regime_adjusted_threshold) const;
 };
\ No newline at end of file
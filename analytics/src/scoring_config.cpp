@@ -0,0 +1,158 @@
+#include "scoring_config.hpp"
+#include <spdlog/spdlog.h>
+#include <nlohmann/json.hpp>
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <sstream>
+#include <stdexcept>
+
+namespace {
+
+ScoringWeights parse_weights(const nlohmann::json& value, const std::string& name) {
+    if (!value.is_array() || value.size() != SignalBatch::kSignals) {
+        throw std::runtime_error(name + " needs 10 weights, S1..S10");
+    }
+    double w[SignalBatch::kSignals];
+    for (size_t j = 0; j < SignalBatch::kSignals; j++) {
+        if (!value[j].is_number() || !std::isfinite(value[j].get<double>()) || value[j].get<double>() < 0) {
+            throw std::runtime_error(name + " has a weight that is not a non-negative number");
+        }
+        w[j] = value[j].get<double>();
+    }
+    return ScoringWeights{w[0], w[1], w[2], w[3], w[4], w[5], w[6], w[7], w[8], w[9]};
+}
+
+int parse_int(const nlohmann::json& doc, const char* field, int current, int min, int max) {
+    auto it = doc.find(field);
+    if (it == doc.end()) return current;
+    if (!it->is_number_integer() || it->get<int64_t>() < min || it->get<int64_t>() > max) {
+        throw std::runtime_error(fmt::format("{} must be an integer in [{}, {}]", field, min, max));
+    }
+    return it->get<int>();
+}
+
+std::shared_ptr<const ScoringConfig> finish(ScoringConfig cfg) {
+    std::vector<ScoringWeights> profiles = {cfg.weights};
+    for (const auto& shadow : cfg.shadows) {
+        profiles.push_back(shadow.weights);
+    }
+    cfg.scorer = BatchScorer(profiles);
+    return std::make_shared<const ScoringConfig>(std::move(cfg));
+}
+
+} // namespace
+
+std::shared_ptr<const ScoringConfig> ScoringConfig::from_config(const Config& config) {
+    ScoringConfig cfg;
+    cfg.version = "env";
+    cfg.shadows = parse_weight_profiles(config.shadow_weights);
+    cfg.actionable_base_threshold = config.actionable_base_threshold;
+    cfg.risk_on_adj = config.risk_on_adj;
+    cfg.risk_off_adj = config.risk_off_adj;
+    cfg.global_actionable_max_per_hour = config.global_actionable_max_per_hour;
+    cfg.cooldown_actionable_hours = config.cooldown_actionable_hours;
+    cfg.cooldown_headsup_hours = config.cooldown_headsup_hours;
+    cfg.reentry_guard_hours = config.reentry_guard_hours;
+    return finish(std::move(cfg));
+}
+
+std::shared_ptr<const ScoringConfig> ScoringConfig::parse(const std::string& text,
+                                                          const ScoringConfig& base) {
+    nlohmann::json doc;
+    try {
+        doc = nlohmann::json::parse(text);
+    } catch (const nlohmann::json::exception& e) {
+        throw std::runtime_error(std::string("not valid JSON: ") + e.what());
+    }
+    if (!doc.is_object()) throw std::runtime_error("not a JSON object");
+
+    static const char* const kFields[] = {
+        "version", "weights", "shadow_weights", "actionable_base_threshold", "risk_on_adj",
+        "risk_off_adj", "global_actionable_max_per_hour", "cooldown_actionable_hours",
+        "cooldown_headsup_hours", "reentry_guard_hours"};
+    for (const auto& [key, _] : doc.items()) {
+        if (std::find(std::begin(kFields), std::end(kFields), key) == std::end(kFields)) {
+            throw std::runtime_error("unknown field " + key);
+        }
+    }
+
+    ScoringConfig cfg;
+    auto version = doc.find("version");
+    if (version == doc.end() || !version->is_string() || version->get<std::string>().empty()) {
+        throw std::runtime_error("version must be a non-empty string");
+    }
+    cfg.version = version->get<std::string>();
+
+    cfg.weights = doc.contains("weights") ? parse_weights(doc["weights"], "weights") : base.weights;
+    if (doc.contains("shadow_weights")) {
+        const auto& shadows = doc["shadow_weights"];
+        if (!shadows.is_object()) throw std::runtime_error("shadow_weights must map names to weights");
+        if (shadows.size() > kMaxShadowProfiles) {
+            throw std::runtime_error(
+                fmt::format("shadow_weights holds at most {} profiles", kMaxShadowProfiles));
+        }
+        for (const auto& [name, weights] : shadows.items()) {
+            cfg.shadows.push_back(ScoringProfile{name, parse_weights(weights, "shadow " + name)});
+        }
+    } else {
+        cfg.shadows = base.shadows;
+    }
+
+    cfg.actionable_base_threshold =
+        parse_int(doc, "actionable_base_threshold", base.actionable_base_threshold, 0, 100);
+    cfg.risk_on_adj = parse_int(doc, "risk_on_adj", base.risk_on_adj, -50, 50);
+    cfg.risk_off_adj = parse_int(doc, "risk_off_adj", base.risk_off_adj, -50, 50);
+    cfg.global_actionable_max_per_hour =
+        parse_int(doc, "global_actionable_max_per_hour", base.global_actionable_max_per_hour, 0, 10000);
+    cfg.cooldown_actionable_hours =
+        parse_int(doc, "cooldown_actionable_hours", base.cooldown_actionable_hours, 0, 24 * 30);
+    cfg.cooldown_headsup_hours =
+        parse_int(doc, "cooldown_headsup_hours", base.cooldown_headsup_hours, 0, 24 * 30);
+    cfg.reentry_guard_hours = parse_int(doc, "reentry_guard_hours", base.reentry_guard_hours, 0, 24 * 30);
+    return finish(std::move(cfg));
+}
+
+ScoringConfigSource::ScoringConfigSource(std::shared_ptr<const ScoringConfig> base, Fetch fetch)
+    : base_(base)
+    , fetch_(std::move(fetch))
+    , current_(std::move(base))
+{}
+
+std::shared_ptr<const ScoringConfig> ScoringConfigSource::current() const {
+    return std::atomic_load(&current_);
+}
+
+bool ScoringConfigSource::reload() {
+    if (!fetch_) return false;
+    auto text = fetch_();
+    if (!text || *text == last_text_) return false;
+    last_text_ = *text;
+
+    std::shared_ptr<const ScoringConfig> next;
+    try {
+        next = ScoringConfig::parse(*text, *base_);
+    } catch (const std::exception& e) {
+        spdlog::error("Rejected scoring config: {}", e.what());
+        return false;
+    }
+
+    auto previous = current();
+    if (next->version == previous->version) {
+        spdlog::warn("Scoring config changed but is still version {}, ignoring it", next->version);
+        return false;
+    }
+    std::atomic_store(&current_, next);
+    spdlog::info("Scoring config {} active (was {}): actionable threshold {}, {} shadow profile(s)",
+                 next->version, previous->version, next->actionable_base_threshold,
+                 next->shadows.size());
+    return true;
+}
+
+std::optional<std::string> ScoringConfigSource::read_file(const std::string& path) {
+    std::ifstream in(path);
+    if (!in) return std::nullopt;
+    std::stringstream text;
+    text << in.rdbuf();
+    return text.str();
+}
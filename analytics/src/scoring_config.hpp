@@ -0,0 +1,56 @@
+#pragma once
+
+#include "batch_scorer.hpp"
+#include "config.hpp"
+#include <functional>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Weights, thresholds and alert gates as one immutable, versioned set. A
+// worker takes one version per batch, and the publisher gates that batch's
+// alerts under the same version, so a reload never mixes two.
+struct ScoringConfig {
+    std::string version;                  // stamped on every alert
+    ScoringWeights weights;
+    std::vector<ScoringProfile> shadows;
+    int actionable_base_threshold = 70;
+    int risk_on_adj = -10;
+    int risk_off_adj = 10;
+    int global_actionable_max_per_hour = 5;
+    int cooldown_actionable_hours = 6;
+    int cooldown_headsup_hours = 1;
+    int reentry_guard_hours = 12;
+    BatchScorer scorer;                   // weights, then the shadows
+
+    // Startup values from the environment, version "env"
+    static std::shared_ptr<const ScoringConfig> from_config(const Config& config);
+    // A JSON document over base: "version" is required, every other field
+    // replaces base's. Throws std::runtime_error when it does not validate.
+    static std::shared_ptr<const ScoringConfig> parse(const std::string& text,
+                                                      const ScoringConfig& base);
+};
+
+// The active ScoringConfig. current() is one atomic load from any thread;
+// reload() runs on one thread.
+class ScoringConfigSource {
+public:
+    // Document text; nullopt when it cannot be read
+    using Fetch = std::function<std::optional<std::string>()>;
+
+    explicit ScoringConfigSource(std::shared_ptr<const ScoringConfig> base, Fetch fetch = nullptr);
+
+    std::shared_ptr<const ScoringConfig> current() const;
+    // Fetches the document and swaps it in if it carries a new version and
+    // validates; returns true if it did. A rejected document is logged once.
+    bool reload();
+
+    static std::optional<std::string> read_file(const std::string& path);
+
+private:
+    std::shared_ptr<const ScoringConfig> base_;
+    Fetch fetch_;
+    std::shared_ptr<const ScoringConfig> current_;
+    std::string last_text_;
+};
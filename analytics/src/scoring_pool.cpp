@@ -0,0 +1,216 @@
+#include "scoring_pool.hpp"
+#include "util.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <chrono>
+
+namespace {
+
+// Idle workers and a blocked reader back off briefly instead of spinning hot
+constexpr auto kIdleWait = std::chrono::microseconds(200);
+
+} // namespace
+
+ScoringPool::ScoringPool(size_t workers, size_t queue_capacity, ScoreFn score)
+    : ScoringPool(workers, queue_capacity,
+                  BatchScoreFn([score = std::move(score)](const std::vector<const TokenState*>& tokens,
+                                                          std::vector<ScoringResult>& out) {
+                      out.clear();
+                      for (const TokenState* token : tokens) {
+                          out.push_back(score(*token));
+                      }
+                  }))
+{
+}
+
+ScoringPool::ScoringPool(size_t workers, size_t queue_capacity, BatchScoreFn score)
+    : score_(std::move(score))
+    , stopping_(false)
+    , running_(0)
+    , next_poll_(0)
+    , submitted_(0)
+{
+    workers = std::max<size_t>(1, workers);
+    queue_capacity = std::max<size_t>(1, queue_capacity);
+    for (size_t i = 0; i < workers; i++) {
+        workers_.push_back(std::make_unique<Worker>(queue_capacity));
+    }
+}
+
+ScoringPool::~ScoringPool() {
+    stop();
+}
+
+void ScoringPool::start() {
+    stopping_ = false;
+    running_ = workers_.size();
+    for (auto& worker : workers_) {
+        Worker* w = worker.get();
+        w->thread = std::thread([this, w]() { run(*w); });
+    }
+    spdlog::info("Scoring pool started with {} workers", workers_.size());
+}
+
+void ScoringPool::stop() {
+    stopping_ = true;
+    for (auto& worker : workers_) {
+        if (worker->thread.joinable()) worker->thread.join();
+    }
+}
+
+size_t ScoringPool::worker_for(const std::string& mint, size_t workers) {
+    return static_cast<size_t>(util::fnv1a_64(mint) % std::max<size_t>(1, workers));
+}
+
+void ScoringPool::submit(ScoringJob job) {
+    Worker& worker = *workers_[worker_for(job.mint, workers_.size())];
+    while (!worker.jobs.try_push(std::move(job))) {
+        std::this_thread::sleep_for(kIdleWait);
+    }
+    submitted_++;
+}
+
+void ScoringPool::wait_idle() const {
+    while (true) {
+        uint64_t completed = 0;
+        for (const auto& worker : workers_) {
+            completed += worker->completed.load(std::memory_order_acquire);
+        }
+        if (completed >= submitted_) return;
+        std::this_thread::sleep_for(kIdleWait);
+    }
+}
+
+size_t ScoringPool::poll(std::vector<ScoringResult>& out, size_t max) {
+    size_t taken = 0;
+    size_t idle = 0;
+    // One result per worker per pass so a busy worker cannot starve the rest
+    while (taken < max && idle < workers_.size()) {
+        Worker& worker = *workers_[next_poll_];
+        next_poll_ = (next_poll_ + 1) % workers_.size();
+
+        ScoringResult result;
+        if (worker.results.try_pop(result)) {
+            out.push_back(std::move(result));
+            taken++;
+            idle = 0;
+        } else {
+            idle++;
+        }
+    }
+    return taken;
+}
+
+bool ScoringPool::drained() const {
+    if (running_.load() > 0) return false;
+    for (const auto& worker : workers_) {
+        if (!worker->results.empty()) return false;
+    }
+    return true;
+}
+
+size_t ScoringPool::tokens() const {
+    size_t total = 0;
+    for (const auto& worker : workers_) {
+        total += worker->state.size();
+    }
+    return total;
+}
+
+std::vector<std::string> ScoringPool::cleanup_stale(int max_age_hours) {
+    std::vector<std::string> removed;
+    for (auto& worker : workers_) {
+        auto mints = worker->state.cleanup_stale(max_age_hours);
+        removed.insert(removed.end(), mints.begin(), mints.end());
+    }
+    return removed;
+}
+
+std::vector<std::string> ScoringPool::remove_if(
+        const std::function<bool(const TokenState&)>& pred) {
+    std::vector<std::string> removed;
+    for (auto& worker : workers_) {
+        auto mints = worker->state.remove_if(pred);
+        removed.insert(removed.end(), mints.begin(), mints.end());
+    }
+    return removed;
+}
+
+std::vector<std::shared_ptr<const TokenState>> ScoringPool::snapshot() const {
+    std::vector<std::shared_ptr<const TokenState>> tokens;
+    for (const auto& worker : workers_) {
+        auto part = worker->state.snapshot();
+        tokens.insert(tokens.end(), part.begin(), part.end());
+    }
+    return tokens;
+}
+
+void ScoringPool::restore(std::shared_ptr<TokenState> token) {
+    workers_[worker_for(token->mint, workers_.size())]->state.restore(std::move(token));
+}
+
+void ScoringPool::run(Worker& worker) {
+    std::vector<ScoringJob> jobs;
+    std::vector<std::shared_ptr<const TokenState>> tokens;
+    std::vector<const TokenState*> batch;
+    std::vector<ScoringResult> scored;
+    jobs.reserve(kScoreBatch);
+
+    while (true) {
+        jobs.clear();
+        ScoringJob job;
+        while (jobs.size() < kScoreBatch && worker.jobs.try_pop(job)) {
+            jobs.push_back(std::move(job));
+        }
+        if (jobs.empty()) {
+            // Queued jobs are finished before a stop takes effect
+            if (stopping_) break;
+            std::this_thread::sleep_for(kIdleWait);
+            continue;
+        }
+
+        tokens.clear();
+        batch.clear();
+        for (auto& j : jobs) {
+            for (const auto& md : j.updates) {
+                worker.state.update_token(j.mint, md);
+            }
+            worker.completed.fetch_add(1, std::memory_order_release);
+            // Each job is scored on the state its own updates produced
+            auto token = j.replay ? nullptr : worker.state.get_token(j.mint);
+            if (token) batch.push_back(token.get());
+            tokens.push_back(std::move(token));
+        }
+
+        scored.clear();
+        try {
+            if (!batch.empty()) score_(batch, scored);
+        } catch (const std::exception& e) {
+            spdlog::error("Scoring a batch of {} failed: {}", batch.size(), e.what());
+            scored.clear();
+        }
+
+        // Every job yields a result so its messages get acked
+        size_t next = 0;
+        for (size_t i = 0; i < jobs.size(); i++) {
+            auto& j = jobs[i];
+            if (j.replay) continue;
+
+            ScoringResult result;
+            result.band = "none";
+            if (tokens[i]) {
+                if (next < scored.size()) result = std::move(scored[next]);
+                next++;
+            }
+            result.mint = std::move(j.mint);
+            result.token = std::move(tokens[i]);
+            result.stream = std::move(j.stream);
+            result.msg_ids = std::move(j.msg_ids);
+
+            while (!worker.results.try_push(std::move(result))) {
+                std::this_thread::sleep_for(kIdleWait);
+            }
+        }
+    }
+    running_--;
+}
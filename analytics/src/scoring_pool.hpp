@@ -0,0 +1,103 @@
+#pragma once
+
+#include "batch_scorer.hpp"
+#include "spsc_queue.hpp"
+#include "state.hpp"
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <functional>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+struct ScoringConfig;
+
+// All updates for one mint from one stream batch, scored once
+struct ScoringJob {
+    std::string mint;
+    std::vector<MarketData> updates;
+    std::string stream;            // the mint's partition stream
+    std::vector<std::string> msg_ids;
+    bool replay = false;           // rebuilding state: applied but neither scored nor acked
+};
+
+struct ScoringResult {
+    std::string mint;
+    std::shared_ptr<const TokenState> token;
+    std::string band;              // "none" when nothing should be published
+    double confidence = 0.0;
+    bool near_alert = false;
+    ReasonSet reasons;             // rendered into the alert only once it clears the gates
+    std::array<Band, kMaxShadowProfiles> shadow_bands{};   // per shadow weight profile, never published
+    size_t shadow_count = 0;
+    std::shared_ptr<const ScoringConfig> scoring;   // version scored under; gates the alert
+    std::string stream;
+    std::vector<std::string> msg_ids;
+};
+
+// Scores mints on a fixed set of worker threads. Each mint is routed by hash
+// to one worker, which alone owns that mint's TokenState, so per-token work
+// needs no cross-worker locking. Jobs reach a worker through an SPSC queue
+// from the reader thread, and results leave through one SPSC queue per worker
+// to the single publisher thread. A worker takes every queued job up to
+// kScoreBatch at once, applies them, and scores their tokens in one call.
+class ScoringPool {
+public:
+    static constexpr size_t kScoreBatch = 64;
+
+    using ScoreFn = std::function<ScoringResult(const TokenState&)>;
+    // Fills out[i] for tokens[i]
+    using BatchScoreFn = std::function<void(const std::vector<const TokenState*>& tokens,
+                                            std::vector<ScoringResult>& out)>;
+
+    ScoringPool(size_t workers, size_t queue_capacity, ScoreFn score);
+    ScoringPool(size_t workers, size_t queue_capacity, BatchScoreFn score);
+    ~ScoringPool();
+
+    void start();
+    // Lets workers finish queued jobs, then joins them
+    void stop();
+
+    size_t workers() const { return workers_.size(); }
+    static size_t worker_for(const std::string& mint, size_t workers);
+
+    // Reader thread only. Waits while the owning worker's queue is full.
+    void submit(ScoringJob job);
+    // Reader thread only. Returns once every submitted job has been applied,
+    // so state then reflects exactly what was read.
+    void wait_idle() const;
+
+    // Publisher thread only. Appends up to max results, round-robin over workers.
+    size_t poll(std::vector<ScoringResult>& out, size_t max);
+    // True once stopped and every result has been polled
+    bool drained() const;
+
+    // Safe from any thread
+    size_t tokens() const;
+    std::vector<std::string> cleanup_stale(int max_age_hours);
+    std::vector<std::string> remove_if(const std::function<bool(const TokenState&)>& pred);
+    std::vector<std::shared_ptr<const TokenState>> snapshot() const;
+    void restore(std::shared_ptr<TokenState> token);
+
+private:
+    struct Worker {
+        SpscQueue<ScoringJob> jobs;
+        SpscQueue<ScoringResult> results;
+        StateManager state;
+        std::atomic<uint64_t> completed{0};   // jobs applied, replays included
+        std::thread thread;
+
+        explicit Worker(size_t capacity) : jobs(capacity), results(capacity) {}
+    };
+
+    BatchScoreFn score_;
+    std::vector<std::unique_ptr<Worker>> workers_;
+    std::atomic<bool> stopping_;
+    std::atomic<size_t> running_;
+    size_t next_poll_;
+    uint64_t submitted_;
+
+    void run(Worker& worker);
+};
@@ -17,7 +17,7 @@ SignalScores SignalCalculator::compute_signals(const TokenState& state) {
     scores.S8 = compute_S8(md.spread_pct, md.impact_1pct_pct);
     scores.S9 = compute_S9(state);
     scores.S10 = compute_S10(md.route);
-    scores.N1 = compute_N1(state.symbol);
+    scores.N1 = compute_N1(state.mint);
     
     return scores;
 }
@@ -93,23 +93,13 @@ double SignalCalculator::compute_S5(const TokenState& state) {
     // Drawdown structure: bouncing from support
     // Look for higher lows in recent history
     
-    if (state.history_24h.size() < 10) return 0.5; // Not enough data
+    size_t n = state.history.size();
+    if (n < 10) return 0.5; // Not enough data
     
     // Simple check: recent low is higher than previous low
-    double recent_low = state.latest.price;
+    double recent_low = std::min(state.latest.price, state.stats.low_recent.value());
     double prev_low = state.latest.price;
-    
-    for (size_t i = state.history_24h.size() - 20; i < state.history_24h.size() - 10; i++) {
-        if (i < state.history_24h.size()) {
-            prev_low = std::min(prev_low, state.history_24h[i].price);
-        }
-    }
-    
-    for (size_t i = state.history_24h.size() - 10; i < state.history_24h.size(); i++) {
-        if (i < state.history_24h.size()) {
-            recent_low = std::min(recent_low, state.history_24h[i].price);
-        }
-    }
+    if (n >= 20) prev_low = std::min(prev_low, state.stats.low_prev.value());
     
     if (recent_low > prev_low * 1.02) return 0.9; // Higher low = good structure
     if (recent_low < prev_low * 0.98) return 0.3; // Lower low = weak
@@ -121,24 +111,11 @@ double SignalCalculator::compute_S6(const TokenState& state) {
     // Volatility: not too chaotic
     // Check recent price variance
     
-    if (state.history_24h.size() < 60) return 0.5;
-    
-    std::vector<double> recent_prices;
-    for (size_t i = state.history_24h.size() - 60; i < state.history_24h.size(); i++) {
-        if (i < state.history_24h.size()) {
-            recent_prices.push_back(state.history_24h[i].price);
-        }
-    }
-    
-    double mean = 0.0;
-    for (double p : recent_prices) mean += p;
-    mean /= recent_prices.size();
+    const auto& window = state.stats.price_60;
+    if (!window.full()) return 0.5;
     
-    double variance = 0.0;
-    for (double p : recent_prices) {
-        variance += (p - mean) * (p - mean);
-    }
-    variance /= recent_prices.size();
+    double mean = window.mean();
+    double variance = window.variance();
     
     double cv = std::sqrt(variance) / mean; // Coefficient of variation
     
@@ -175,22 +152,10 @@ double SignalCalculator::compute_S8(double spread_pct, double impact_pct) {
 double SignalCalculator::compute_S9(const TokenState& state) {
     // Volume trend: increasing volume = bullish
     
-    if (state.history_24h.size() < 100) return 0.5;
-    
-    double recent_vol = 0.0;
-    double old_vol = 0.0;
+    if (!state.stats.vol_100.full()) return 0.5;
     
-    for (size_t i = state.history_24h.size() - 50; i < state.history_24h.size(); i++) {
-        if (i < state.history_24h.size()) {
-            recent_vol += state.history_24h[i].bar_5m.v_usd;
-        }
-    }
-    
-    for (size_t i = state.history_24h.size() - 100; i < state.history_24h.size() - 50; i++) {
-        if (i < state.history_24h.size()) {
-            old_vol += state.history_24h[i].bar_5m.v_usd;
-        }
-    }
+    double recent_vol = state.stats.vol_recent.sum;
+    double old_vol = state.stats.vol_100.sum - recent_vol;
     
     if (recent_vol > old_vol * 1.2) return 0.9; // Volume increasing
     if (recent_vol < old_vol * 0.8) return 0.4; // Volume decreasing
@@ -212,17 +177,24 @@ double SignalCalculator::compute_S10(const MarketData::Route& route) {
     return std::max(0.0, std::min(1.0, score));
 }
 
-double SignalCalculator::compute_N1(const std::string& symbol) {
+double SignalCalculator::compute_N1(const std::string& mint) {
     // Token list hygiene: widely mirrored lists
     // Simplified: penalize if not in known list
     
     // In production: check against CoinGecko, Jupiter strict list, etc.
-    static const std::vector<std::string> known_tokens = {
-        "SOL", "USDC", "USDT", "BONK", "JUP", "WIF", "JTO"
+    // Matched by mint, since anyone can deploy a token called "BONK"
+    static const std::vector<std::string> known_mints = {
+        "So11111111111111111111111111111111111111112",  // SOL
+        "EPjFWdd5AufqSSqeM2qN1xzybapC8G4wEGGkZwyTDt1v", // USDC
+        "Es9vMFrzaCERmJfrF4H2FYD4KCoNkY11McCe8BenwNYB", // USDT
+        "DezXAZ8z7PnrnRJjz3wXBoRgixCa6xjnB7YaB1pPB263", // BONK
+        "JUPyiwrYJFskUPiHa7hkeR8VUtAeFoSYbKedZNsDvCN",  // JUP
+        "EKpQGSJtjMFqKZ9KQanSqYXRcF8fBopzLHYxdM65zcjm", // WIF
+        "jtojtomepa8beP8AuQc6eXt5FriJwfFMwQx2v2f9mCL"   // JTO
     };
     
-    for (const auto& known : known_tokens) {
-        if (symbol == known) return 1.0;
+    for (const auto& known : known_mints) {
+        if (mint == known) return 1.0;
     }
     
     return 0.9; // Small penalty (-10 in C calculation)
@@ -16,8 +16,6 @@ struct SignalScores {
     double S10; // Route health
     
     double N1; // Token list hygiene (binary: 1.0 or penalty)
-    
-    std::vector<std::string> warnings; // Gate failures
 };
 
 class SignalCalculator {
@@ -56,5 +54,5 @@ private:
     static double compute_S10(const MarketData::Route& route);
     
     // N1: Token list hygiene
-    static double compute_N1(const std::string& symbol);
+    static double compute_N1(const std::string& mint);
 };
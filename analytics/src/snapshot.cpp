@@ -0,0 +1,377 @@
+#include "snapshot.hpp"
+#include "util.hpp"
+#include <spdlog/spdlog.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <stdexcept>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr char kMagic[8] = {'S', 'O', 'U', 'L', 'S', 'N', 'A', 'P'};
+constexpr size_t kColumns = static_cast<size_t>(TokenHistory::Column::Count);
+
+struct Header {
+    char magic[8];
+    uint32_t version;
+    uint32_t columns;          // TokenHistory::Column::Count when written
+    int64_t created_ms;
+    uint64_t payload_bytes;
+    uint64_t checksum;         // FNV-1a over the payload
+};
+static_assert(sizeof(Header) % 8 == 0, "payload must start 8-byte aligned");
+
+class Writer {
+public:
+    explicit Writer(FILE* file) : file_(file), offset_(sizeof(Header)), checksum_(util::kFnv1aOffset) {}
+
+    void bytes(const void* data, size_t n) {
+        if (n == 0) return;
+        if (std::fwrite(data, 1, n, file_) != n) {
+            throw std::runtime_error("short write");
+        }
+        checksum_ = util::fnv1a_64_update(checksum_, data, n);
+        offset_ += n;
+    }
+
+    template <typename T>
+    void pod(const T& value) { bytes(&value, sizeof(T)); }
+
+    void str(const std::string& s) {
+        pod(static_cast<uint32_t>(s.size()));
+        bytes(s.data(), s.size());
+    }
+
+    // Pads so the next array starts 8-byte aligned in the file
+    void align() {
+        static const char zeros[8] = {};
+        bytes(zeros, (8 - offset_ % 8) % 8);
+    }
+
+    uint64_t payload_bytes() const { return offset_ - sizeof(Header); }
+    uint64_t checksum() const { return checksum_; }
+
+private:
+    FILE* file_;
+    uint64_t offset_;
+    uint64_t checksum_;
+};
+
+// Bounds-checked cursor over the mapped file
+class Reader {
+public:
+    Reader(const char* base, size_t size) : base_(base), size_(size), offset_(sizeof(Header)) {}
+
+    const char* take(size_t n) {
+        if (n > size_ - offset_) throw std::runtime_error("truncated snapshot");
+        const char* p = base_ + offset_;
+        offset_ += n;
+        return p;
+    }
+
+    template <typename T>
+    T pod() {
+        T value;
+        std::memcpy(&value, take(sizeof(T)), sizeof(T));
+        return value;
+    }
+
+    std::string str() {
+        uint32_t n = pod<uint32_t>();
+        return std::string(take(n), n);
+    }
+
+    // Arrays are written 8-byte aligned and the mapping is page aligned
+    template <typename T>
+    const T* array(size_t n) {
+        if (n > (size_ - offset_) / sizeof(T)) throw std::runtime_error("truncated snapshot");
+        return reinterpret_cast<const T*>(take(n * sizeof(T)));
+    }
+
+    void align() { take((8 - offset_ % 8) % 8); }
+
+private:
+    const char* base_;
+    size_t size_;
+    size_t offset_;
+};
+
+void write_bar(Writer& w, const MarketData::Bar& bar) {
+    w.pod(bar.o);
+    w.pod(bar.h);
+    w.pod(bar.l);
+    w.pod(bar.c);
+    w.pod(bar.v_usd);
+}
+
+MarketData::Bar read_bar(Reader& r) {
+    MarketData::Bar bar;
+    bar.o = r.pod<double>();
+    bar.h = r.pod<double>();
+    bar.l = r.pod<double>();
+    bar.c = r.pod<double>();
+    bar.v_usd = r.pod<double>();
+    return bar;
+}
+
+void write_market_data(Writer& w, const MarketData& md) {
+    w.str(md.pool);
+    w.str(md.mint_base);
+    w.str(md.mint_quote);
+    w.str(md.symbol);
+    w.str(md.dq);
+    w.pod(md.price);
+    w.pod(md.liq_usd);
+    w.pod(md.vol24h_usd);
+    w.pod(md.spread_pct);
+    w.pod(md.impact_1pct_pct);
+    w.pod(md.age_hours);
+    w.pod(md.xdex_spread_pct);
+    w.pod(static_cast<int32_t>(md.pool_count));
+    w.pod(static_cast<uint8_t>(md.route.ok));
+    w.pod(static_cast<int32_t>(md.route.hops));
+    w.pod(md.route.dev_pct);
+    write_bar(w, md.bar_5m);
+    write_bar(w, md.bar_15m);
+    w.pod(md.ts_ms);
+}
+
+MarketData read_market_data(Reader& r) {
+    MarketData md;
+    md.pool = r.str();
+    md.mint_base = r.str();
+    md.mint_quote = r.str();
+    md.symbol = r.str();
+    md.dq = r.str();
+    md.price = r.pod<double>();
+    md.liq_usd = r.pod<double>();
+    md.vol24h_usd = r.pod<double>();
+    md.spread_pct = r.pod<double>();
+    md.impact_1pct_pct = r.pod<double>();
+    md.age_hours = r.pod<double>();
+    md.xdex_spread_pct = r.pod<double>();
+    md.pool_count = r.pod<int32_t>();
+    md.route.ok = r.pod<uint8_t>() != 0;
+    md.route.hops = r.pod<int32_t>();
+    md.route.dev_pct = r.pod<double>();
+    md.bar_5m = read_bar(r);
+    md.bar_15m = read_bar(r);
+    md.ts_ms = r.pod<int64_t>();
+    return md;
+}
+
+void write_history(Writer& w, const TokenHistory& history,
+                   std::vector<int64_t>& ts, std::vector<double>& price, std::vector<float>& column) {
+    size_t n = history.size();
+    w.pod(static_cast<uint64_t>(n));
+    w.align();
+
+    ts.resize(n);
+    history.copy_ts(0, n, ts.data());
+    w.bytes(ts.data(), n * sizeof(int64_t));
+
+    price.resize(n);
+    history.copy_price(0, n, price.data());
+    w.bytes(price.data(), n * sizeof(double));
+
+    column.resize(n);
+    for (size_t c = 0; c < kColumns; c++) {
+        history.copy_column(static_cast<TokenHistory::Column>(c), 0, n, column.data());
+        w.bytes(column.data(), n * sizeof(float));
+    }
+    w.align();
+}
+
+void read_history(Reader& r, TokenHistory& history) {
+    size_t n = r.pod<uint64_t>();
+    r.align();
+    const int64_t* ts = r.array<int64_t>(n);
+    const double* price = r.array<double>(n);
+    const float* columns[kColumns];
+    for (size_t c = 0; c < kColumns; c++) {
+        columns[c] = r.array<float>(n);
+    }
+    r.align();
+    history.assign(n, ts, price, columns);
+}
+
+} // namespace
+
+bool SnapshotStore::save(int64_t created_ms,
+                         const std::map<std::string, std::string>& stream_ids,
+                         const std::vector<std::shared_ptr<const TokenState>>& tokens,
+                         const ThrottleManager::State& throttles) const {
+    std::string tmp_path = path_ + ".tmp";
+    FILE* file = std::fopen(tmp_path.c_str(), "wb");
+    if (!file) {
+        spdlog::error("Cannot write snapshot {}: {}", tmp_path, std::strerror(errno));
+        return false;
+    }
+
+    try {
+        Header header{};
+        // Rewritten once the payload is known
+        if (std::fwrite(&header, sizeof(header), 1, file) != 1) {
+            throw std::runtime_error("short write");
+        }
+
+        Writer w(file);
+        w.pod(static_cast<uint32_t>(stream_ids.size()));
+        for (const auto& [stream, id] : stream_ids) {
+            w.str(stream);
+            w.str(id);
+        }
+
+        std::vector<int64_t> ts;
+        std::vector<double> price;
+        std::vector<float> column;
+        w.pod(static_cast<uint32_t>(tokens.size()));
+        for (const auto& token : tokens) {
+            w.str(token->mint);
+            w.str(token->symbol);
+            write_market_data(w, token->latest);
+            w.pod(token->entry_price);
+            w.pod(static_cast<uint8_t>(token->has_position));
+            w.pod(token->first_liq_ts_ms);
+            write_history(w, token->history, ts, price, column);
+        }
+
+        w.pod(static_cast<uint32_t>(throttles.alerts.size()));
+        for (const auto& rec : throttles.alerts) {
+            w.str(rec.symbol);
+            w.str(rec.band);
+            w.str(rec.reason_hash);
+            w.pod(rec.timestamp_ms);
+        }
+        w.pod(static_cast<uint32_t>(throttles.global_alert_times.size()));
+        for (int64_t ts_ms : throttles.global_alert_times) {
+            w.pod(ts_ms);
+        }
+        w.pod(static_cast<uint32_t>(throttles.stop_times.size()));
+        for (const auto& [symbol, ts_ms] : throttles.stop_times) {
+            w.str(symbol);
+            w.pod(ts_ms);
+        }
+
+        std::memcpy(header.magic, kMagic, sizeof(kMagic));
+        header.version = kVersion;
+        header.columns = static_cast<uint32_t>(kColumns);
+        header.created_ms = created_ms;
+        header.payload_bytes = w.payload_bytes();
+        header.checksum = w.checksum();
+        if (std::fseek(file, 0, SEEK_SET) != 0 ||
+            std::fwrite(&header, sizeof(header), 1, file) != 1 ||
+            std::fflush(file) != 0 || fsync(fileno(file)) != 0) {
+            throw std::runtime_error(std::strerror(errno));
+        }
+    } catch (const std::exception& e) {
+        spdlog::error("Failed to write snapshot {}: {}", tmp_path, e.what());
+        std::fclose(file);
+        std::remove(tmp_path.c_str());
+        return false;
+    }
+
+    std::fclose(file);
+    if (std::rename(tmp_path.c_str(), path_.c_str()) != 0) {
+        spdlog::error("Failed to replace snapshot {}: {}", path_, std::strerror(errno));
+        std::remove(tmp_path.c_str());
+        return false;
+    }
+    return true;
+}
+
+std::optional<StateSnapshot> SnapshotStore::load() const {
+    int fd = open(path_.c_str(), O_RDONLY);
+    if (fd < 0) {
+        if (errno != ENOENT) {
+            spdlog::warn("Cannot open snapshot {}: {}", path_, std::strerror(errno));
+        }
+        return std::nullopt;
+    }
+
+    struct stat st{};
+    if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(Header)) {
+        spdlog::warn("Snapshot {} is too short", path_);
+        close(fd);
+        return std::nullopt;
+    }
+    size_t size = static_cast<size_t>(st.st_size);
+    void* mapped = mmap(nullptr, size, PROT_READ, MAP_PRIVATE, fd, 0);
+    close(fd);
+    if (mapped == MAP_FAILED) {
+        spdlog::warn("Cannot map snapshot {}: {}", path_, std::strerror(errno));
+        return std::nullopt;
+    }
+    madvise(mapped, size, MADV_SEQUENTIAL);
+    const char* base = static_cast<const char*>(mapped);
+
+    std::optional<StateSnapshot> result;
+    try {
+        Header header;
+        std::memcpy(&header, base, sizeof(header));
+        if (std::memcmp(header.magic, kMagic, sizeof(kMagic)) != 0 ||
+            header.version != kVersion || header.columns != kColumns) {
+            throw std::runtime_error("unknown format or version");
+        }
+        if (header.payload_bytes != size - sizeof(Header) ||
+            util::fnv1a_64_update(util::kFnv1aOffset, base + sizeof(Header),
+                                  size - sizeof(Header)) != header.checksum) {
+            throw std::runtime_error("checksum mismatch");
+        }
+
+        StateSnapshot snap;
+        snap.created_ms = header.created_ms;
+        Reader r(base, size);
+
+        uint32_t streams = r.pod<uint32_t>();
+        for (uint32_t i = 0; i < streams; i++) {
+            std::string stream = r.str();
+            snap.stream_ids[stream] = r.str();
+        }
+
+        uint32_t tokens = r.pod<uint32_t>();
+        snap.tokens.reserve(tokens);
+        for (uint32_t i = 0; i < tokens; i++) {
+            auto token = std::make_shared<TokenState>();
+            token->mint = r.str();
+            token->symbol = r.str();
+            token->latest = read_market_data(r);
+            token->entry_price = r.pod<double>();
+            token->has_position = r.pod<uint8_t>() != 0;
+            token->first_liq_ts_ms = r.pod<int64_t>();
+            read_history(r, token->history);
+            token->stats.restore(token->history);
+            snap.tokens.push_back(std::move(token));
+        }
+
+        uint32_t alerts = r.pod<uint32_t>();
+        for (uint32_t i = 0; i < alerts; i++) {
+            AlertRecord rec;
+            rec.symbol = r.str();
+            rec.band = r.str();
+            rec.reason_hash = r.str();
+            rec.timestamp_ms = r.pod<int64_t>();
+            snap.throttles.alerts.push_back(std::move(rec));
+        }
+        uint32_t globals = r.pod<uint32_t>();
+        for (uint32_t i = 0; i < globals; i++) {
+            snap.throttles.global_alert_times.push_back(r.pod<int64_t>());
+        }
+        uint32_t stops = r.pod<uint32_t>();
+        for (uint32_t i = 0; i < stops; i++) {
+            std::string symbol = r.str();
+            snap.throttles.stop_times.emplace_back(std::move(symbol), r.pod<int64_t>());
+        }
+
+        result = std::move(snap);
+    } catch (const std::exception& e) {
+        spdlog::warn("Ignoring snapshot {}: {}", path_, e.what());
+    }
+
+    munmap(mapped, size);
+    return result;
+}
@@ -0,0 +1,47 @@
+#pragma once
+
+#include "state.hpp"
+#include "throttles.hpp"
+#include <cstdint>
+#include <map>
+#include <memory>
+#include <optional>
+#include <string>
+#include <vector>
+
+// Everything analytics needs to resume warm: token state, throttle records,
+// and per stream the last entry that state reflects
+struct StateSnapshot {
+    int64_t created_ms = 0;
+    std::map<std::string, std::string> stream_ids;
+    std::vector<std::shared_ptr<TokenState>> tokens;
+    ThrottleManager::State throttles;
+};
+
+// Binary snapshot file. A fixed header (magic, version, payload length and
+// FNV-1a checksum) is followed by the payload, in which each token's history
+// columns are stored as 8-byte aligned arrays, oldest first. Loading maps the
+// file and copies the columns straight into each TokenHistory; rolling
+// statistics are rebuilt from the restored history rather than stored.
+class SnapshotStore {
+public:
+    // 2: checksum uses the standard FNV-1a offset basis
+    static constexpr uint32_t kVersion = 2;
+
+    explicit SnapshotStore(const std::string& path) : path_(path) {}
+
+    const std::string& path() const { return path_; }
+
+    // Writes path.tmp, fsyncs it and renames it over path, so a crash leaves
+    // either the previous snapshot or this one. Returns false on I/O errors.
+    bool save(int64_t created_ms,
+              const std::map<std::string, std::string>& stream_ids,
+              const std::vector<std::shared_ptr<const TokenState>>& tokens,
+              const ThrottleManager::State& throttles) const;
+
+    // nullopt when the file is missing, corrupt or from another version
+    std::optional<StateSnapshot> load() const;
+
+private:
+    std::string path_;
+};
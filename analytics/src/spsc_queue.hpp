@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <cstddef>
+#include <vector>
+
+// Bounded lock-free queue for exactly one producer thread and one consumer
+// thread. One slot is kept free to tell full from empty.
+template <typename T>
+class SpscQueue {
+public:
+    explicit SpscQueue(size_t capacity)
+        : buffer_(capacity + 1)
+        , head_(0)
+        , tail_(0)
+    {}
+
+    SpscQueue(const SpscQueue&) = delete;
+    SpscQueue& operator=(const SpscQueue&) = delete;
+
+    // Producer only. Moves from item only when it returns true.
+    bool try_push(T&& item) {
+        size_t tail = tail_.load(std::memory_order_relaxed);
+        size_t next = advance(tail);
+        if (next == head_.load(std::memory_order_acquire)) return false;
+        buffer_[tail] = std::move(item);
+        tail_.store(next, std::memory_order_release);
+        return true;
+    }
+
+    // Consumer only
+    bool try_pop(T& out) {
+        size_t head = head_.load(std::memory_order_relaxed);
+        if (head == tail_.load(std::memory_order_acquire)) return false;
+        out = std::move(buffer_[head]);
+        head_.store(advance(head), std::memory_order_release);
+        return true;
+    }
+
+    bool empty() const {
+        return head_.load(std::memory_order_acquire) == tail_.load(std::memory_order_acquire);
+    }
+
+    size_t capacity() const { return buffer_.size() - 1; }
+
+private:
+    std::vector<T> buffer_;
+    // Producer and consumer indices on separate cache lines
+    alignas(64) std::atomic<size_t> head_;
+    alignas(64) std::atomic<size_t> tail_;
+
+    size_t advance(size_t i) const { return i + 1 == buffer_.size() ? 0 : i + 1; }
+};
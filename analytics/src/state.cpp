@@ -1,71 +1,184 @@
 #include "state.hpp"
 #include "util.hpp"
 #include <algorithm>
+#include <atomic>
 
-void TokenState::update(const MarketData& md) {
-    latest = md;
-    history_24h.push_back(md);
+namespace {
+
+MarketData::Bar parse_bar(const nlohmann::json& j, double fallback_close) {
+    MarketData::Bar bar{0.0, 0.0, 0.0, fallback_close, 0.0};
+    if (!j.is_object()) return bar;
+    bar.c = j.value("c", fallback_close);
+    bar.o = j.value("o", bar.c);
+    bar.h = j.value("h", bar.c);
+    bar.l = j.value("l", bar.c);
+    bar.v_usd = j.value("v_usd", 0.0);
+    return bar;
+}
+
+} // namespace
+
+MarketData MarketData::from_json(const nlohmann::json& j) {
+    MarketData md;
+    md.pool = j.value("pool", "");
+    md.mint_base = j.contains("mint") ? j.value("mint", "") : j.value("mint_base", "");
+    md.mint_quote = j.value("mint_quote", "");
+    md.symbol = j.value("symbol", "");
+    md.price = j.value("price", 0.0);
+    md.liq_usd = j.value("liq_usd", 0.0);
+    md.vol24h_usd = j.value("vol24h_usd", 0.0);
+    md.spread_pct = j.value("spread_pct", 0.0);
+    md.impact_1pct_pct = j.value("impact_1pct_pct", 0.0);
+    md.age_hours = j.value("age_hours", 0.0);
+    md.pool_count = j.value("pools", 1);
+    md.xdex_spread_pct = j.value("xdex_spread_pct", 0.0);
     
-    // Keep only 24h of data (assuming updates every 60s = max 1440 entries)
-    while (history_24h.size() > 1440) {
-        history_24h.pop_front();
+    md.route = Route{false, 0, 0.0};
+    if (j.contains("route") && j["route"].is_object()) {
+        const auto& r = j["route"];
+        md.route = Route{r.value("ok", false), r.value("hops", 0), r.value("dev_pct", 0.0)};
     }
+    
+    nlohmann::json bars = j.value("bars", nlohmann::json::object());
+    md.bar_5m = parse_bar(bars.value("5m", nlohmann::json()), md.price);
+    md.bar_15m = parse_bar(bars.value("15m", nlohmann::json()), md.price);
+    
+    md.dq = j.value("dq", "ok");
+    md.ts_ms = util::current_timestamp_ms();
+    return md;
 }
 
-MarketData TokenState::get_1h_ago() const {
-    // Find entry ~60 minutes ago (60 entries back if 1min updates)
-    if (history_24h.size() < 60) return latest;
-    return history_24h[history_24h.size() - 60];
+void TokenState::update(const MarketData& md) {
+    latest = md;
+    stats.push(history, md);
 }
 
-MarketData TokenState::get_24h_ago() const {
-    if (history_24h.empty()) return latest;
-    return history_24h.front();
+std::optional<double> TokenState::price_ago(int64_t lookback_ms) const {
+    auto idx = history.index_at_or_before(latest.ts_ms - lookback_ms);
+    if (!idx) return std::nullopt;
+    return history.price(*idx);
 }
 
 double TokenState::compute_m1h() const {
-    auto old_data = get_1h_ago();
-    if (old_data.price <= 0 || latest.price <= 0) return 0.0;
-    return ((latest.price - old_data.price) / old_data.price) * 100.0;
+    auto old_price = price_ago(60LL * 60 * 1000);
+    if (!old_price || *old_price <= 0 || latest.price <= 0) return 0.0;
+    return ((latest.price - *old_price) / *old_price) * 100.0;
 }
 
 double TokenState::compute_m24h() const {
-    auto old_data = get_24h_ago();
-    if (old_data.price <= 0 || latest.price <= 0) return 0.0;
-    return ((latest.price - old_data.price) / old_data.price) * 100.0;
+    // Falls back to the oldest entry until a full day has been seen
+    auto old_price = price_ago(24LL * 60 * 60 * 1000);
+    if (!old_price && !history.empty()) old_price = history.price(0);
+    if (!old_price || *old_price <= 0 || latest.price <= 0) return 0.0;
+    return ((latest.price - *old_price) / *old_price) * 100.0;
+}
+
+StateManager::Shard& StateManager::shard_for(const std::string& mint) {
+    return shards_[std::hash<std::string>{}(mint) % kShards];
+}
+
+const StateManager::Shard& StateManager::shard_for(const std::string& mint) const {
+    return shards_[std::hash<std::string>{}(mint) % kShards];
+}
+
+void StateManager::update_token(const std::string& mint, const MarketData& md) {
+    Shard& shard = shard_for(mint);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    
+    Slot& slot = shard.tokens[mint];
+    auto& token = slot.current;
+    if (!token) {
+        token = std::make_shared<TokenState>();
+    } else if (token.use_count() > 1) {
+        // A reader holds this version: leave it untouched and update a copy,
+        // made into the spare when its readers are gone (same sizes, so the
+        // assignment reuses every buffer)
+        if (slot.spare && slot.spare.use_count() == 1) {
+            std::atomic_thread_fence(std::memory_order_acquire);
+            *slot.spare = *token;
+        } else {
+            slot.spare = std::make_shared<TokenState>(*token);
+        }
+        std::swap(token, slot.spare);
+    } else {
+        // Sole owner; pairs with the reader's release of its reference
+        std::atomic_thread_fence(std::memory_order_acquire);
+    }
+    
+    token->update(md);
+    token->mint = mint;
+    if (!md.symbol.empty()) token->symbol = md.symbol;
+    else if (token->symbol.empty()) token->symbol = mint.substr(0, 8);
 }
 
-void StateManager::update_token(const std::string& symbol, const MarketData& md) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    tokens_[symbol].update(md);
-    tokens_[symbol].symbol = symbol;
+void StateManager::restore(std::shared_ptr<TokenState> token) {
+    Shard& shard = shard_for(token->mint);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    Slot& slot = shard.tokens[token->mint];
+    slot.current = std::move(token);
+    slot.spare.reset();
 }
 
-TokenState* StateManager::get_token(const std::string& symbol) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    auto it = tokens_.find(symbol);
-    if (it == tokens_.end()) return nullptr;
-    return &it->second;
+std::shared_ptr<const TokenState> StateManager::get_token(const std::string& mint) const {
+    const Shard& shard = shard_for(mint);
+    std::lock_guard<std::mutex> lock(shard.mutex);
+    auto it = shard.tokens.find(mint);
+    if (it == shard.tokens.end()) return nullptr;
+    return it->second.current;
 }
 
-std::vector<std::string> StateManager::get_all_symbols() {
-    std::lock_guard<std::mutex> lock(mutex_);
+std::vector<std::string> StateManager::get_all_symbols() const {
     std::vector<std::string> symbols;
-    for (const auto& [sym, _] : tokens_) {
-        symbols.push_back(sym);
+    for (const auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (const auto& [mint, _] : shard.tokens) {
+            symbols.push_back(mint);
+        }
     }
+    std::sort(symbols.begin(), symbols.end());
     return symbols;
 }
 
-void StateManager::cleanup_stale(int max_age_hours) {
-    std::lock_guard<std::mutex> lock(mutex_);
-    int64_t cutoff_ms = util::current_timestamp_ms() - (max_age_hours * 3600 * 1000);
-    
-    for (auto it = tokens_.begin(); it != tokens_.end();) {
-        if (it->second.latest.ts_ms < cutoff_ms) {
-            it = tokens_.erase(it);
-        } else {
-            ++it;
+std::vector<std::shared_ptr<const TokenState>> StateManager::snapshot() const {
+    std::vector<std::shared_ptr<const TokenState>> tokens;
+    for (const auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (const auto& [_, slot] : shard.tokens) {
+            tokens.push_back(slot.current);
         }
     }
-}
\ No newline at end of file
+    return tokens;
+}
+
+size_t StateManager::size() const {
+    size_t total = 0;
+    for (const auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        total += shard.tokens.size();
+    }
+    return total;
+}
+
+std::vector<std::string> StateManager::cleanup_stale(int max_age_hours) {
+    int64_t cutoff_ms = util::current_timestamp_ms() - (max_age_hours * 3600LL * 1000);
+    return remove_if([cutoff_ms](const TokenState& token) {
+        return token.latest.ts_ms < cutoff_ms;
+    });
+}
+
+std::vector<std::string> StateManager::remove_if(
+        const std::function<bool(const TokenState&)>& pred) {
+    std::vector<std::string> removed;
+    for (auto& shard : shards_) {
+        std::lock_guard<std::mutex> lock(shard.mutex);
+        for (auto it = shard.tokens.begin(); it != shard.tokens.end();) {
+            if (pred(*it->second.current)) {
+                removed.push_back(it->first);
+                it = shard.tokens.erase(it);
+            } else {
+                ++it;
+            }
+        }
+    }
+    return removed;
+}
@@ -1,16 +1,24 @@
 #pragma once
 
 #include <string>
-#include <map>
+#include <array>
+#include <memory>
+#include <unordered_map>
 #include <vector>
-#include <deque>
+#include <optional>
+#include <functional>
 #include <mutex>
 #include <nlohmann/json.hpp>
+#include "token_history.hpp"
+#include "rolling_stats.hpp"
+
+constexpr const char* kSolMint = "So11111111111111111111111111111111111111112";
 
 struct MarketData {
-    std::string pool;
+    std::string pool;        // best pool for execution in a per-mint update
     std::string mint_base;
     std::string mint_quote;
+    std::string symbol;
     double price;
     double liq_usd;
     double vol24h_usd;
@@ -18,6 +26,10 @@ struct MarketData {
     double impact_1pct_pct;
     double age_hours;
     
+    // Per-mint consolidation (1 and 0 for a single-pool update)
+    int pool_count;
+    double xdex_spread_pct;
+    
     struct Route {
         bool ok;
         int hops;
@@ -32,12 +44,17 @@ struct MarketData {
     
     std::string dq;
     int64_t ts_ms;
+    
+    // Parses a per-mint (STREAM_MINT) or per-pool (STREAM_MARKET) update
+    static MarketData from_json(const nlohmann::json& j);
 };
 
 struct TokenState {
+    std::string mint;
     std::string symbol;
     MarketData latest;
-    std::deque<MarketData> history_24h;  // Rolling 24h window
+    TokenHistory history;  // Rolling 24h window, numeric columns only
+    RollingStats stats;    // Window aggregates over history, slid on each update
     
     // Metadata
     double entry_price;
@@ -45,21 +62,53 @@ struct TokenState {
     int64_t first_liq_ts_ms;
     
     void update(const MarketData& md);
-    MarketData get_1h_ago() const;
-    MarketData get_24h_ago() const;
+    // Price of the newest entry at least lookback_ms older than latest;
+    // nullopt when the history does not reach back that far
+    std::optional<double> price_ago(int64_t lookback_ms) const;
     double compute_m1h() const;
     double compute_m24h() const;
 };
 
+// Keyed by mint: symbols are not unique and pools of one mint must share a history.
+//
+// Tokens are spread over shards by mint hash, each with its own lock, so
+// writers to different mints do not contend. Readers get a shared_ptr to an
+// immutable TokenState: a writer updates in place only when no reader holds
+// the current version and otherwise copies it first, so a reader's view
+// stays consistent for as long as it keeps the pointer. The copy goes into
+// the version before it once that one's readers are gone, so a mint whose
+// every update is read (a queued result holds the last one) alternates
+// between two buffers instead of allocating a TokenState per update.
 class StateManager {
 public:
-    void update_token(const std::string& symbol, const MarketData& md);
-    TokenState* get_token(const std::string& symbol);
-    std::vector<std::string> get_all_symbols();
+    static constexpr size_t kShards = 16;
+    
+    void update_token(const std::string& mint, const MarketData& md);
+    // Installs a token loaded from a snapshot, replacing any current version
+    void restore(std::shared_ptr<TokenState> token);
+    std::shared_ptr<const TokenState> get_token(const std::string& mint) const;
+    std::vector<std::string> get_all_symbols() const; // mints
+    // Current version of every token
+    std::vector<std::shared_ptr<const TokenState>> snapshot() const;
+    size_t size() const;
     
-    void cleanup_stale(int max_age_hours);
+    // Both return the mints removed
+    std::vector<std::string> cleanup_stale(int max_age_hours);
+    std::vector<std::string> remove_if(const std::function<bool(const TokenState&)>& pred);
     
 private:
-    std::mutex mutex_;
-    std::map<std::string, TokenState> tokens_;
-};
\ No newline at end of file
+    struct Slot {
+        std::shared_ptr<TokenState> current;
+        std::shared_ptr<TokenState> spare;   // previous version, reused for the next copy
+    };
+
+    struct Shard {
+        mutable std::mutex mutex;
+        std::unordered_map<std::string, Slot> tokens;
+    };
+    
+    std::array<Shard, kShards> shards_;
+    
+    Shard& shard_for(const std::string& mint);
+    const Shard& shard_for(const std::string& mint) const;
+};
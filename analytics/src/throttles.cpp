@@ -2,8 +2,55 @@
 #include "util.hpp"
 #include <algorithm>
 
-std::string ThrottleManager::make_key(const std::string& symbol, const std::string& band) {
-    return symbol + ":" + band;
+namespace {
+
+// Expiry resolution; records live up to a minute past their age limit
+constexpr int64_t kExpiryTickMs = 60 * 1000;
+
+int64_t hours_ms(int hours) {
+    return hours * 3600LL * 1000;
+}
+
+} // namespace
+
+ThrottleManager::ThrottleManager() : ThrottleManager(util::current_timestamp_ms) {}
+
+ThrottleManager::ThrottleManager(Clock clock)
+    : clock_(std::move(clock))
+    , expiry_(kExpiryTickMs)
+{}
+
+void ThrottleManager::index_alert(const AlertRecord& rec) {
+    const int64_t ts_ms = rec.timestamp_ms;
+    
+    Key cooldown_key(rec.symbol, rec.band);
+    auto [cooldown, new_cooldown] = cooldowns_.try_emplace(cooldown_key, Fired{ts_ms, rec.reason_hash});
+    if (new_cooldown || ts_ms >= cooldown->second.timestamp_ms) {
+        cooldown->second = Fired{ts_ms, rec.reason_hash};
+        expiry_.schedule(ts_ms, Expiry{Index::Cooldown, std::move(cooldown_key), ts_ms});
+    }
+    
+    Key dedup_key(rec.symbol, rec.reason_hash);
+    auto [dedup, new_dedup] = dedup_.try_emplace(dedup_key, Fired{ts_ms, rec.band});
+    if (new_dedup || ts_ms >= dedup->second.timestamp_ms) {
+        dedup->second = Fired{ts_ms, rec.band};
+        expiry_.schedule(ts_ms, Expiry{Index::Dedup, std::move(dedup_key), ts_ms});
+    }
+}
+
+void ThrottleManager::expire(const Expiry& e) {
+    if (e.index == Index::Stop) {
+        auto it = stop_times_.find(e.key.first);
+        if (it != stop_times_.end() && it->second == e.timestamp_ms) {
+            stop_times_.erase(it);
+        }
+        return;
+    }
+    auto& index = e.index == Index::Cooldown ? cooldowns_ : dedup_;
+    auto it = index.find(e.key);
+    if (it != index.end() && it->second.timestamp_ms == e.timestamp_ms) {
+        index.erase(it);
+    }
 }
 
 bool ThrottleManager::check_token_cooldown(const std::string& symbol, 
@@ -11,19 +58,13 @@ bool ThrottleManager::check_token_cooldown(const std::string& symbol,
                                           int cooldown_hours) {
     std::lock_guard<std::mutex> lock(mutex_);
     
-    std::string key = make_key(symbol, band);
-    auto& history = token_history_[key];
-    
-    if (history.empty()) return true; // No cooldown
+    auto it = cooldowns_.find(Key(symbol, band));
+    if (it == cooldowns_.end()) return true; // No cooldown
     
-    int64_t cutoff_ms = util::current_timestamp_ms() - (cooldown_hours * 3600 * 1000);
+    int64_t cutoff_ms = clock_() - hours_ms(cooldown_hours);
     
     // Check if last alert is within cooldown
-    if (!history.empty() && history.back().timestamp_ms > cutoff_ms) {
-        return false; // Still in cooldown
-    }
-    
-    return true;
+    return it->second.timestamp_ms <= cutoff_ms;
 }
 
 void ThrottleManager::record_alert(const std::string& symbol, 
@@ -31,20 +72,19 @@ void ThrottleManager::record_alert(const std::string& symbol,
                                    const std::string& reason_hash) {
     std::lock_guard<std::mutex> lock(mutex_);
     
-    std::string key = make_key(symbol, band);
     AlertRecord rec;
     rec.symbol = symbol;
     rec.band = band;
     rec.reason_hash = reason_hash;
-    rec.timestamp_ms = util::current_timestamp_ms();
+    rec.timestamp_ms = clock_();
     
-    token_history_[key].push_back(rec);
+    index_alert(rec);
 }
 
 bool ThrottleManager::check_global_limit(int max_per_hour) {
     std::lock_guard<std::mutex> lock(mutex_);
     
-    int64_t cutoff_ms = util::current_timestamp_ms() - (3600 * 1000);
+    int64_t cutoff_ms = clock_() - (3600 * 1000);
     
     // Remove old entries
     while (!global_alert_times_.empty() && global_alert_times_.front() < cutoff_ms) {
@@ -57,7 +97,7 @@ bool ThrottleManager::check_global_limit(int max_per_hour) {
 
 void ThrottleManager::record_global_alert() {
     std::lock_guard<std::mutex> lock(mutex_);
-    global_alert_times_.push_back(util::current_timestamp_ms());
+    global_alert_times_.push_back(clock_());
 }
 
 bool ThrottleManager::is_duplicate(const std::string& symbol, 
@@ -65,20 +105,12 @@ bool ThrottleManager::is_duplicate(const std::string& symbol,
                                   int ttl_hours) {
     std::lock_guard<std::mutex> lock(mutex_);
     
-    int64_t cutoff_ms = util::current_timestamp_ms() - (ttl_hours * 3600 * 1000);
-    
-    // Check all bands for this symbol
-    for (const auto& [key, history] : token_history_) {
-        if (key.find(symbol) == 0) { // Starts with symbol
-            for (const auto& rec : history) {
-                if (rec.timestamp_ms > cutoff_ms && rec.reason_hash == reason_hash) {
-                    return true; // Duplicate
-                }
-            }
-        }
-    }
+    // Newest alert for this symbol with this reason hash, in any band
+    auto it = dedup_.find(Key(symbol, reason_hash));
+    if (it == dedup_.end()) return false;
     
-    return false;
+    int64_t cutoff_ms = clock_() - hours_ms(ttl_hours);
+    return it->second.timestamp_ms > cutoff_ms;
 }
 
 bool ThrottleManager::check_reentry_guard(const std::string& symbol, int guard_hours) {
@@ -87,7 +119,7 @@ bool ThrottleManager::check_reentry_guard(const std::string& symbol, int guard_h
     auto it = stop_times_.find(symbol);
     if (it == stop_times_.end()) return true; // No stop recorded
     
-    int64_t cutoff_ms = util::current_timestamp_ms() - (guard_hours * 3600 * 1000);
+    int64_t cutoff_ms = clock_() - hours_ms(guard_hours);
     
     if (it->second > cutoff_ms) {
         return false; // Still in guard period
@@ -98,36 +130,57 @@ bool ThrottleManager::check_reentry_guard(const std::string& symbol, int guard_h
 
 void ThrottleManager::record_stop(const std::string& symbol) {
     std::lock_guard<std::mutex> lock(mutex_);
-    stop_times_[symbol] = util::current_timestamp_ms();
+    int64_t now_ms = clock_();
+    stop_times_[symbol] = now_ms;
+    expiry_.schedule(now_ms, Expiry{Index::Stop, Key(symbol, std::string()), now_ms});
 }
 
 void ThrottleManager::cleanup_old_records(int max_age_hours) {
     std::lock_guard<std::mutex> lock(mutex_);
     
-    int64_t cutoff_ms = util::current_timestamp_ms() - (max_age_hours * 3600 * 1000);
+    int64_t cutoff_ms = clock_() - hours_ms(max_age_hours);
+    expiry_.advance(cutoff_ms, [this](const Expiry& e) { expire(e); });
+}
+
+ThrottleManager::State ThrottleManager::export_state() const {
+    std::lock_guard<std::mutex> lock(mutex_);
     
-    // Clean token history
-    for (auto it = token_history_.begin(); it != token_history_.end();) {
-        auto& history = it->second;
-        
-        // Remove old alerts
-        while (!history.empty() && history.front().timestamp_ms < cutoff_ms) {
-            history.pop_front();
-        }
-        
-        if (history.empty()) {
-            it = token_history_.erase(it);
-        } else {
-            ++it;
+    // Each index entry is an alert that was sent; an alert newest in both
+    // indexes is written once
+    State state;
+    for (const auto& [key, fired] : cooldowns_) {
+        state.alerts.push_back(AlertRecord{key.first, key.second, fired.detail, fired.timestamp_ms});
+    }
+    for (const auto& [key, fired] : dedup_) {
+        auto it = cooldowns_.find(Key(key.first, fired.detail));
+        if (it != cooldowns_.end() && it->second.timestamp_ms == fired.timestamp_ms &&
+            it->second.detail == key.second) {
+            continue;
         }
+        state.alerts.push_back(AlertRecord{key.first, fired.detail, key.second, fired.timestamp_ms});
     }
+    state.global_alert_times.assign(global_alert_times_.begin(), global_alert_times_.end());
+    state.stop_times.assign(stop_times_.begin(), stop_times_.end());
+    return state;
+}
+
+void ThrottleManager::import_state(const State& state) {
+    std::lock_guard<std::mutex> lock(mutex_);
     
-    // Clean stop times
-    for (auto it = stop_times_.begin(); it != stop_times_.end();) {
-        if (it->second < cutoff_ms) {
-            it = stop_times_.erase(it);
-        } else {
-            ++it;
+    cooldowns_.clear();
+    dedup_.clear();
+    stop_times_.clear();
+    expiry_.clear();
+    for (const auto& rec : state.alerts) {
+        index_alert(rec);
+    }
+    global_alert_times_.assign(state.global_alert_times.begin(), state.global_alert_times.end());
+    std::sort(global_alert_times_.begin(), global_alert_times_.end());
+    for (const auto& [symbol, ts_ms] : state.stop_times) {
+        auto [stop, added] = stop_times_.try_emplace(symbol, ts_ms);
+        if (added || ts_ms >= stop->second) {
+            stop->second = ts_ms;
+            expiry_.schedule(ts_ms, Expiry{Index::Stop, Key(symbol, std::string()), ts_ms});
         }
     }
-}
\ No newline at end of file
+}
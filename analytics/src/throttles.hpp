@@ -1,9 +1,13 @@
 #pragma once
 
+#include "timer_wheel.hpp"
 #include <string>
-#include <map>
 #include <deque>
+#include <functional>
 #include <mutex>
+#include <unordered_map>
+#include <utility>
+#include <vector>
 
 struct AlertRecord {
     std::string symbol;
@@ -12,8 +16,31 @@ struct AlertRecord {
     int64_t timestamp_ms;
 };
 
+// One alert's gates as parameters, for throttles kept outside the process
+struct ThrottleCheck {
+    std::string symbol;
+    std::string band;
+    std::string reason_hash;
+    int cooldown_hours;          // band cooldown and duplicate-reasons TTL
+    int reentry_guard_hours;     // 0 skips the guard
+    int global_max_per_hour;     // < 0 skips the global cap
+};
+
 class ThrottleManager {
 public:
+    // Everything the throttles remember, flattened for snapshots
+    struct State {
+        std::vector<AlertRecord> alerts;
+        std::vector<int64_t> global_alert_times;
+        std::vector<std::pair<std::string, int64_t>> stop_times;
+    };
+    
+    // Milliseconds since epoch; the backtest drives this from replayed time
+    using Clock = std::function<int64_t()>;
+    
+    ThrottleManager();
+    explicit ThrottleManager(Clock clock);
+
     // Per-token cooldowns
     bool check_token_cooldown(const std::string& symbol, const std::string& band,
                              int cooldown_hours);
@@ -32,14 +59,48 @@ public:
     bool check_reentry_guard(const std::string& symbol, int guard_hours);
     void record_stop(const std::string& symbol);
     
-    // Cleanup
+    // Forgets alerts and stops older than max_age_hours. Expiry runs off a
+    // timer wheel, so the cost is what expires rather than what is held.
     void cleanup_old_records(int max_age_hours);
     
+    State export_state() const;
+    // Replaces all records
+    void import_state(const State& state);
+    
 private:
-    std::mutex mutex_;
-    std::map<std::string, std::deque<AlertRecord>> token_history_;
+    using Key = std::pair<std::string, std::string>;
+    
+    struct KeyHash {
+        size_t operator()(const Key& key) const {
+            size_t h = std::hash<std::string>()(key.first);
+            return h ^ (std::hash<std::string>()(key.second) + 0x9e3779b97f4a7c15ULL + (h << 6) + (h >> 2));
+        }
+    };
+    
+    // Newest alert for a key; detail is the reason hash in the cooldown index
+    // and the band in the dedup index, so each entry is a whole AlertRecord
+    struct Fired {
+        int64_t timestamp_ms;
+        std::string detail;
+    };
+    
+    enum class Index : uint8_t { Cooldown, Dedup, Stop };
+    
+    // An entry's expiry; stale once the entry has fired again since
+    struct Expiry {
+        Index index;
+        Key key;
+        int64_t timestamp_ms;
+    };
+    
+    Clock clock_;
+    mutable std::mutex mutex_;
+    std::unordered_map<Key, Fired, KeyHash> cooldowns_;     // (symbol, band)
+    std::unordered_map<Key, Fired, KeyHash> dedup_;         // (symbol, reason hash)
     std::deque<int64_t> global_alert_times_;
-    std::map<std::string, int64_t> stop_times_;
+    std::unordered_map<std::string, int64_t> stop_times_;
+    TimerWheel<Expiry> expiry_;
     
-    std::string make_key(const std::string& symbol, const std::string& band);
+    void index_alert(const AlertRecord& rec);
+    void expire(const Expiry& e);
 };
\ No newline at end of file
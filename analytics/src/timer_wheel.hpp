@@ -0,0 +1,153 @@
+#pragma once
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <limits>
+#include <utility>
+#include <vector>
+
+// Hierarchical timer wheel: kLevels wheels of kSlots slots, a level L slot
+// spanning kSlots^L ticks. An item sits in the finest wheel whose current
+// turn contains its tick and drops a level each time the cursor enters its
+// slot, so scheduling is O(1) and an item is touched at most kLevels times.
+// Advancing jumps between occupied slots, so its cost is what fires plus a
+// scan of at most kSlots slots per level. Items beyond the top wheel's span
+// are re-filed once per turn of it.
+template <typename T>
+class TimerWheel {
+public:
+    static constexpr size_t kLevels = 4;
+    static constexpr size_t kBits = 6;
+    static constexpr size_t kSlots = size_t(1) << kBits;
+
+    explicit TimerWheel(int64_t tick_ms) : tick_ms_(tick_ms > 0 ? tick_ms : 1) {}
+
+    size_t size() const { return size_; }
+    bool empty() const { return size_ == 0; }
+
+    void schedule(int64_t at_ms, T item) {
+        int64_t tick = at_ms / tick_ms_;
+        if (size_ == 0) now_ = tick;
+        size_++;
+        place(tick, std::move(item));
+    }
+
+    // Calls fn(item) for every item scheduled in or before the tick holding
+    // until_ms, in no particular order
+    template <typename Fn>
+    void advance(int64_t until_ms, Fn&& fn) {
+        const int64_t until = until_ms / tick_ms_;
+
+        if (!late_.empty()) {
+            std::vector<Entry> late;
+            late.swap(late_);
+            for (auto& e : late) {
+                if (e.first <= until) {
+                    size_--;
+                    fn(e.second);
+                } else {
+                    late_.push_back(std::move(e));
+                }
+            }
+        }
+        if (now_ > until) return;
+
+        while (true) {
+            fire(fn);
+            int64_t next = next_occupied();
+            if (next > until) {
+                move_to(until);
+                return;
+            }
+            move_to(next);
+        }
+    }
+
+    void clear() {
+        for (auto& level : wheels_) {
+            for (auto& slot : level) slot.clear();
+        }
+        counts_.fill(0);
+        late_.clear();
+        size_ = 0;
+    }
+
+private:
+    using Entry = std::pair<int64_t, T>;   // tick, item
+
+    int64_t tick_ms_;
+    int64_t now_ = 0;                       // ticks before this have fired
+    size_t size_ = 0;
+    std::array<std::array<std::vector<Entry>, kSlots>, kLevels> wheels_;
+    std::array<size_t, kLevels> counts_{};
+    std::vector<Entry> late_;               // scheduled behind the cursor
+
+    static size_t slot_of(int64_t tick, size_t level) {
+        return static_cast<size_t>(tick >> (kBits * level)) & (kSlots - 1);
+    }
+
+    void place(int64_t tick, T item) {
+        if (tick < now_) {
+            late_.emplace_back(tick, std::move(item));
+            return;
+        }
+        size_t level = 0;
+        while (level + 1 < kLevels &&
+               (tick >> (kBits * (level + 1))) != (now_ >> (kBits * (level + 1)))) {
+            level++;
+        }
+        wheels_[level][slot_of(tick, level)].emplace_back(tick, std::move(item));
+        counts_[level]++;
+    }
+
+    // The level 0 slot under the cursor holds only items due now
+    template <typename Fn>
+    void fire(Fn& fn) {
+        auto& slot = wheels_[0][slot_of(now_, 0)];
+        if (slot.empty()) return;
+        std::vector<Entry> items;
+        items.swap(slot);
+        counts_[0] -= items.size();
+        size_ -= items.size();
+        for (auto& e : items) {
+            fn(e.second);
+        }
+    }
+
+    // First tick after the cursor that starts an occupied slot. Below the top
+    // level every item lies ahead of the cursor within its wheel's turn, and
+    // finer wheels end before coarser ones begin, so the first hit is the
+    // earliest.
+    int64_t next_occupied() const {
+        for (size_t level = 0; level < kLevels; level++) {
+            if (counts_[level] == 0) continue;
+            const int64_t base = now_ >> (kBits * level);
+            for (int64_t idx = base + 1; idx <= base + int64_t(kSlots); idx++) {
+                if (level + 1 < kLevels && (idx >> kBits) != (base >> kBits)) break;
+                if (!wheels_[level][static_cast<size_t>(idx) & (kSlots - 1)].empty()) {
+                    return idx << (kBits * level);
+                }
+            }
+        }
+        return std::numeric_limits<int64_t>::max();
+    }
+
+    // Coarse slots the cursor enters are re-filed, coarsest first so their
+    // items can fall through every level on the way down
+    void move_to(int64_t tick) {
+        const int64_t old = now_;
+        now_ = tick;
+        for (size_t level = kLevels - 1; level > 0; level--) {
+            if ((tick >> (kBits * level)) == (old >> (kBits * level))) continue;
+            auto& slot = wheels_[level][slot_of(tick, level)];
+            if (slot.empty()) continue;
+            std::vector<Entry> items;
+            items.swap(slot);
+            counts_[level] -= items.size();
+            for (auto& e : items) {
+                place(e.first, std::move(e.second));
+            }
+        }
+    }
+};
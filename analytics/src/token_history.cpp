@@ -0,0 +1,132 @@
+#include "token_history.hpp"
+#include "state.hpp"
+#include <cmath>
+
+TokenHistory::TokenHistory(size_t capacity)
+    : capacity_(std::max<size_t>(1, capacity))
+    , head_(0)
+    , size_(0)
+    , ts_(capacity_)
+    , price_(capacity_)
+    , columns_(static_cast<size_t>(Column::Count), std::vector<float>(capacity_))
+{}
+
+void TokenHistory::push(const MarketData& md) {
+    size_t s;
+    if (size_ < capacity_) {
+        s = slot(size_);
+        size_++;
+    } else {
+        s = head_;
+        head_ = slot(1);
+    }
+
+    ts_[s] = md.ts_ms;
+    price_[s] = md.price;
+
+    auto set = [this, s](Column col, double v) {
+        columns_[static_cast<size_t>(col)][s] = static_cast<float>(v);
+    };
+    set(Column::Liq, md.liq_usd);
+    set(Column::Vol24h, md.vol24h_usd);
+    set(Column::Spread, md.spread_pct);
+    set(Column::Impact, md.impact_1pct_pct);
+    set(Column::Bar5mO, md.bar_5m.o);
+    set(Column::Bar5mH, md.bar_5m.h);
+    set(Column::Bar5mL, md.bar_5m.l);
+    set(Column::Bar5mC, md.bar_5m.c);
+    set(Column::Bar5mV, md.bar_5m.v_usd);
+    set(Column::Bar15mO, md.bar_15m.o);
+    set(Column::Bar15mH, md.bar_15m.h);
+    set(Column::Bar15mL, md.bar_15m.l);
+    set(Column::Bar15mC, md.bar_15m.c);
+    set(Column::Bar15mV, md.bar_15m.v_usd);
+}
+
+void TokenHistory::clear() {
+    head_ = 0;
+    size_ = 0;
+}
+
+void TokenHistory::assign(size_t n, const int64_t* ts, const double* price,
+                          const float* const* columns) {
+    size_t skip = n > capacity_ ? n - capacity_ : 0;
+    head_ = 0;
+    size_ = n - skip;
+    std::copy_n(ts + skip, size_, ts_.begin());
+    std::copy_n(price + skip, size_, price_.begin());
+    for (size_t c = 0; c < columns_.size(); c++) {
+        std::copy_n(columns[c] + skip, size_, columns_[c].begin());
+    }
+}
+
+void TokenHistory::copy_ts(size_t from, size_t n, int64_t* out) const {
+    for_each_run(from, from + n, [&](size_t a, size_t b) {
+        out = std::copy(ts_.begin() + a, ts_.begin() + b, out);
+    });
+}
+
+void TokenHistory::copy_price(size_t from, size_t n, double* out) const {
+    for_each_run(from, from + n, [&](size_t a, size_t b) {
+        out = std::copy(price_.begin() + a, price_.begin() + b, out);
+    });
+}
+
+void TokenHistory::copy_column(Column col, size_t from, size_t n, float* out) const {
+    const auto& values = columns_[static_cast<size_t>(col)];
+    for_each_run(from, from + n, [&](size_t a, size_t b) {
+        out = std::copy(values.begin() + a, values.begin() + b, out);
+    });
+}
+
+std::optional<size_t> TokenHistory::index_at_or_before(int64_t ts_ms) const {
+    // First index with ts > ts_ms, then step back one
+    size_t lo = 0, hi = size_;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (ts(mid) <= ts_ms) lo = mid + 1;
+        else hi = mid;
+    }
+    if (lo == 0) return std::nullopt;
+    return lo - 1;
+}
+
+size_t TokenHistory::index_at_or_after(int64_t ts_ms) const {
+    size_t lo = 0, hi = size_;
+    while (lo < hi) {
+        size_t mid = lo + (hi - lo) / 2;
+        if (ts(mid) < ts_ms) lo = mid + 1;
+        else hi = mid;
+    }
+    return lo;
+}
+
+double TokenHistory::min_price(size_t from, size_t to) const {
+    double result = HUGE_VAL;
+    for_each_run(from, to, [&](size_t a, size_t b) {
+        for (size_t s = a; s < b; s++) result = std::min(result, price_[s]);
+    });
+    return result;
+}
+
+double TokenHistory::max_price(size_t from, size_t to) const {
+    double result = -HUGE_VAL;
+    for_each_run(from, to, [&](size_t a, size_t b) {
+        for (size_t s = a; s < b; s++) result = std::max(result, price_[s]);
+    });
+    return result;
+}
+
+double TokenHistory::sum(Column col, size_t from, size_t to) const {
+    const auto& values = columns_[static_cast<size_t>(col)];
+    double result = 0.0;
+    for_each_run(from, to, [&](size_t a, size_t b) {
+        for (size_t s = a; s < b; s++) result += values[s];
+    });
+    return result;
+}
+
+size_t TokenHistory::memory_bytes() const {
+    return capacity_ * (sizeof(int64_t) + sizeof(double)
+                        + static_cast<size_t>(Column::Count) * sizeof(float));
+}
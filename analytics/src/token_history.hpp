@@ -0,0 +1,93 @@
+#pragma once
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <optional>
+#include <vector>
+
+struct MarketData;
+
+// Fixed-capacity ring buffer of a token's numeric time series, one contiguous
+// column per field. Only numbers are kept (no pool/mint/dq strings), prices and
+// timestamps at full width and the rest as float, so a full day at one update
+// per minute is ~100 KB instead of ~750 KB of MarketData copies.
+//
+// Index 0 is the oldest entry and size() - 1 the newest. Timestamps are
+// expected to be non-decreasing; lookups by time are binary searches.
+class TokenHistory {
+public:
+    static constexpr size_t kDefaultCapacity = 1440; // 24h at 60s updates
+
+    enum class Column {
+        Liq, Vol24h, Spread, Impact,
+        Bar5mO, Bar5mH, Bar5mL, Bar5mC, Bar5mV,
+        Bar15mO, Bar15mH, Bar15mL, Bar15mC, Bar15mV,
+        Count
+    };
+
+    explicit TokenHistory(size_t capacity = kDefaultCapacity);
+
+    // Overwrites the oldest entry once full
+    void push(const MarketData& md);
+    void clear();
+
+    // Replaces the contents with n entries, oldest first: ts[n], price[n] and
+    // one float[n] run per Column. Only the newest capacity() are kept.
+    void assign(size_t n, const int64_t* ts, const double* price,
+                const float* const* columns);
+    // Copies entry [from, from + n) of one column into out, oldest first
+    void copy_ts(size_t from, size_t n, int64_t* out) const;
+    void copy_price(size_t from, size_t n, double* out) const;
+    void copy_column(Column col, size_t from, size_t n, float* out) const;
+
+    size_t size() const { return size_; }
+    size_t capacity() const { return capacity_; }
+    bool empty() const { return size_ == 0; }
+
+    int64_t ts(size_t i) const { return ts_[slot(i)]; }
+    double price(size_t i) const { return price_[slot(i)]; }
+    double value(Column col, size_t i) const {
+        return columns_[static_cast<size_t>(col)][slot(i)];
+    }
+    double vol_5m(size_t i) const { return value(Column::Bar5mV, i); }
+
+    // Newest entry with ts <= ts_ms; nullopt if every entry is newer
+    std::optional<size_t> index_at_or_before(int64_t ts_ms) const;
+    // Oldest entry with ts >= ts_ms; size() if every entry is older
+    size_t index_at_or_after(int64_t ts_ms) const;
+
+    // Aggregates over [from, to), scanned as at most two contiguous runs.
+    // Empty ranges return the identity (+inf, -inf, 0).
+    double min_price(size_t from, size_t to) const;
+    double max_price(size_t from, size_t to) const;
+    double sum(Column col, size_t from, size_t to) const;
+
+    size_t memory_bytes() const;
+
+private:
+    size_t capacity_;
+    size_t head_;   // slot of the oldest entry
+    size_t size_;
+
+    std::vector<int64_t> ts_;
+    std::vector<double> price_;
+    std::vector<std::vector<float>> columns_;
+
+    size_t slot(size_t i) const {
+        size_t s = head_ + i;
+        return s >= capacity_ ? s - capacity_ : s;
+    }
+
+    // Calls fn(first_slot, last_slot) for the one or two contiguous slot runs of [from, to)
+    template <typename Fn>
+    void for_each_run(size_t from, size_t to, Fn fn) const {
+        if (to > size_) to = size_;
+        if (from >= to) return;
+        size_t a = slot(from);
+        size_t n = to - from;
+        size_t first = std::min(n, capacity_ - a);
+        fn(a, a + first);
+        if (first < n) fn(size_t{0}, n - first);
+    }
+};
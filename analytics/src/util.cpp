@@ -1,6 +1,8 @@
 #include "util.hpp"
 #include <sstream>
 #include <iomanip>
+#include <cstdlib>
+#include <utility>
 
 namespace util {
 
@@ -12,25 +14,53 @@ std::string current_iso8601() {
     return ss.str();
 }
 
+std::string iso8601(int64_t ts_ms) {
+    std::time_t itt = static_cast<std::time_t>(ts_ms / 1000);
+    std::tm tm{};
+    gmtime_r(&itt, &tm);
+    std::ostringstream ss;
+    ss << std::put_time(&tm, "%FT%TZ");
+    return ss.str();
+}
+
 int64_t current_timestamp_ms() {
     return std::chrono::duration_cast<std::chrono::milliseconds>(
         std::chrono::system_clock::now().time_since_epoch()
     ).count();
 }
 
-std::string hash_reasons(const std::vector<std::string>& reasons) {
-    // Simple hash: concatenate and use std::hash
-    std::string combined;
-    for (const auto& r : reasons) {
-        combined += r + "|";
+uint64_t fnv1a_64(const std::string& s) {
+    return fnv1a_64_update(kFnv1aOffset, s.data(), s.size());
+}
+
+uint64_t fnv1a_64_update(uint64_t hash, const void* data, size_t n) {
+    const auto* p = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < n; i++) {
+        hash ^= p[i];
+        hash *= 1099511628211ULL;
     }
-    
-    std::hash<std::string> hasher;
-    size_t hash_val = hasher(combined);
-    
-    std::ostringstream ss;
-    ss << std::hex << hash_val;
-    return ss.str();
+    return hash;
+}
+
+int mint_partition(const std::string& mint, int partitions) {
+    if (partitions <= 1) return 0;
+    return static_cast<int>(fnv1a_64(mint) % static_cast<uint64_t>(partitions));
+}
+
+std::string partition_stream(const std::string& base, int partition, int partitions) {
+    if (partitions <= 1) return base;
+    return base + "." + std::to_string(partition);
+}
+
+bool stream_id_less(const std::string& a, const std::string& b) {
+    auto parse = [](const std::string& id) {
+        size_t dash = id.find('-');
+        uint64_t ms = std::strtoull(id.c_str(), nullptr, 10);
+        uint64_t seq = dash == std::string::npos ? 0 : std::strtoull(id.c_str() + dash + 1, nullptr, 10);
+        return std::make_pair(ms, seq);
+    };
+    if (a.empty() || b.empty()) return a.empty() && !b.empty();
+    return parse(a) < parse(b);
 }
 
 } // namespace util
\ No newline at end of file
@@ -1,11 +1,24 @@
 #pragma once
 
 #include <string>
+#include <vector>
+#include <cstdint>
 #include <chrono>
 #include <functional>
 
 namespace util {
     std::string current_iso8601();
+    std::string iso8601(int64_t ts_ms);
     int64_t current_timestamp_ms();
-    std::string hash_reasons(const std::vector<std::string>& reasons);
+    // Stable across processes and builds, unlike std::hash
+    uint64_t fnv1a_64(const std::string& s);
+    // Incremental form: start from kFnv1aOffset and feed the bytes in pieces
+    constexpr uint64_t kFnv1aOffset = 14695981039346656037ULL;
+    uint64_t fnv1a_64_update(uint64_t hash, const void* data, size_t n);
+    // Stream carrying mint's updates when the per-mint stream is split into
+    // partitions by FNV-1a(mint); a single partition keeps the base name
+    int mint_partition(const std::string& mint, int partitions);
+    std::string partition_stream(const std::string& base, int partition, int partitions);
+    // Orders Redis stream IDs ("<ms>-<seq>") numerically; "" sorts first
+    bool stream_id_less(const std::string& a, const std::string& b);
 }
\ No newline at end of file
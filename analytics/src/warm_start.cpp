@@ -0,0 +1,216 @@
+#include "warm_start.hpp"
+#include <algorithm>
+#include <atomic>
+#include <functional>
+#include <limits>
+#include <thread>
+
+namespace {
+
+// As in the ingestor: pools below this share of a mint's liquidity do not
+// count toward its cross-DEX spread
+constexpr double kSpreadMinLiqShare = 0.05;
+
+using PriceSeries = QuotePrices::mapped_type;
+
+bool is_stable(const std::string& mint) {
+    return mint == kUsdcMint || mint == kUsdtMint;
+}
+
+double price_at(const PriceSeries& series, int64_t ts_ms) {
+    auto it = std::upper_bound(series.begin(), series.end(), ts_ms,
+                               [](int64_t ts, const std::pair<int64_t, double>& p) {
+                                   return ts < p.first;
+                               });
+    if (it == series.begin()) return 0.0;
+    return std::prev(it)->second;
+}
+
+// Runs fn(0..n-1) on `threads` threads, each taking the next index
+void parallel_for(size_t n, size_t threads, const std::function<void(size_t)>& fn) {
+    std::atomic<size_t> next{0};
+    auto run = [&]() {
+        for (size_t i = next++; i < n; i = next++) {
+            fn(i);
+        }
+    };
+
+    std::vector<std::thread> helpers;
+    for (size_t t = 1; t < std::min(std::max<size_t>(1, threads), n); t++) {
+        helpers.emplace_back(run);
+    }
+    run();
+    for (auto& helper : helpers) {
+        helper.join();
+    }
+}
+
+} // namespace
+
+MintConsolidator::MintConsolidator(std::string mint, std::vector<uint32_t> indices)
+    : mint_(std::move(mint)), indices_(std::move(indices)) {}
+
+void MintConsolidator::sort(const std::vector<PoolStatRow>& rows) {
+    std::sort(indices_.begin(), indices_.end(), [&rows](uint32_t a, uint32_t b) {
+        return rows[a].ts_ms != rows[b].ts_ms ? rows[a].ts_ms < rows[b].ts_ms
+                                              : rows[a].pool < rows[b].pool;
+    });
+    pos_ = 0;
+}
+
+int64_t MintConsolidator::next_ts(const std::vector<PoolStatRow>& rows) const {
+    if (pos_ >= indices_.size()) return std::numeric_limits<int64_t>::max();
+    return rows[indices_[pos_]].ts_ms;
+}
+
+bool MintConsolidator::next(const std::vector<PoolInfo>& pools,
+                            const std::vector<PoolStatRow>& rows,
+                            const QuotePrices& quotes, MarketData& md) {
+    if (pos_ >= indices_.size()) return false;
+
+    size_t begin = pos_;
+    int64_t ts_ms = rows[indices_[begin]].ts_ms;
+    size_t end = begin;
+    while (end < indices_.size() && rows[indices_[end]].ts_ms == ts_ms) end++;
+    pos_ = end;
+
+    md = MarketData{};
+    md.mint_base = mint_;
+    md.ts_ms = ts_ms;
+    md.pool_count = static_cast<int>(end - begin);
+
+    double priced_liq = 0.0;
+    double weighted_price = 0.0;
+    double best_cost = 0.0;
+    const PoolStatRow* best = nullptr;
+    priced_.clear();
+
+    for (size_t i = begin; i < end; i++) {
+        const PoolStatRow& row = rows[indices_[i]];
+        md.liq_usd += row.liq_usd;
+        md.vol24h_usd += row.vol24h_usd;
+
+        const std::string& quote = pools[row.pool].mint_quote;
+        double quote_usd = 0.0;
+        if (is_stable(quote)) {
+            quote_usd = 1.0;
+        } else if (auto it = quotes.find(quote); it != quotes.end()) {
+            quote_usd = price_at(it->second, ts_ms);
+        }
+        double usd = row.price * quote_usd;
+        if (usd > 0 && row.liq_usd > 0) {
+            weighted_price += usd * row.liq_usd;
+            priced_liq += row.liq_usd;
+            priced_.emplace_back(usd, row.liq_usd);
+        }
+
+        double cost = row.spread_pct + row.impact_1pct_pct;
+        if (!best || cost < best_cost || (cost == best_cost && row.liq_usd > best->liq_usd)) {
+            best = &row;
+            best_cost = cost;
+        }
+    }
+
+    if (priced_liq <= 0) return false;
+
+    md.price = weighted_price / priced_liq;
+    double lo = 0.0;
+    double hi = 0.0;
+    bool any = false;
+    for (const auto& [usd, liq] : priced_) {
+        if (liq < priced_liq * kSpreadMinLiqShare) continue;
+        lo = any ? std::min(lo, usd) : usd;
+        hi = any ? std::max(hi, usd) : usd;
+        any = true;
+    }
+    md.xdex_spread_pct = any ? (hi - lo) / md.price * 100.0 : 0.0;
+
+    md.pool = pools[best->pool].address;
+    md.spread_pct = best->spread_pct;
+    md.impact_1pct_pct = best->impact_1pct_pct;
+    md.route = MarketData::Route{best->route_ok, best->route_hops, best->route_dev_pct};
+    md.dq = best->degraded ? "degraded" : "ok";
+
+    // Same synthetic bars as the ingestor's per-mint message
+    md.bar_5m = MarketData::Bar{md.price, md.price, md.price, md.price, md.vol24h_usd / 288.0};
+    md.bar_15m = MarketData::Bar{md.price, md.price, md.price, md.price, md.vol24h_usd / 96.0};
+    return true;
+}
+
+std::vector<MintConsolidator> split_by_mint(const std::vector<PoolInfo>& pools,
+                                            const std::vector<PoolStatRow>& rows,
+                                            size_t threads, QuotePrices& quotes) {
+    std::unordered_map<std::string, std::vector<uint32_t>> by_mint;
+    for (uint32_t i = 0; i < rows.size(); i++) {
+        if (rows[i].pool >= pools.size()) continue;
+        by_mint[pools[rows[i].pool].mint_base].push_back(i);
+    }
+
+    // Quote mints first, SOL ahead of the rest, so their USD series exist
+    // before the pools quoted in them are priced
+    std::vector<std::string> quote_order;
+    for (const auto& pool : pools) {
+        if (!is_stable(pool.mint_quote) && by_mint.count(pool.mint_quote)) {
+            quote_order.push_back(pool.mint_quote);
+        }
+    }
+    std::sort(quote_order.begin(), quote_order.end());
+    quote_order.erase(std::unique(quote_order.begin(), quote_order.end()), quote_order.end());
+    std::stable_partition(quote_order.begin(), quote_order.end(),
+                          [](const std::string& m) { return m == kSolMint; });
+
+    std::vector<MintConsolidator> mints;
+    mints.reserve(by_mint.size());
+    for (const auto& mint : quote_order) {
+        mints.emplace_back(mint, std::move(by_mint[mint]));
+        by_mint.erase(mint);
+    }
+    size_t quote_count = mints.size();
+    for (auto& [mint, indices] : by_mint) {
+        mints.emplace_back(mint, std::move(indices));
+    }
+    std::sort(mints.begin() + quote_count, mints.end(),
+              [](const MintConsolidator& a, const MintConsolidator& b) { return a.mint() < b.mint(); });
+
+    parallel_for(mints.size(), threads, [&](size_t i) { mints[i].sort(rows); });
+
+    quotes.clear();
+    for (size_t i = 0; i < quote_count; i++) {
+        PriceSeries series;
+        MarketData md;
+        while (mints[i].next_ts(rows) != std::numeric_limits<int64_t>::max()) {
+            if (mints[i].next(pools, rows, quotes, md)) series.emplace_back(md.ts_ms, md.price);
+        }
+        mints[i].rewind();
+        quotes.emplace(mints[i].mint(), std::move(series));
+    }
+    return mints;
+}
+
+std::vector<std::shared_ptr<TokenState>> build_histories(const std::vector<PoolInfo>& pools,
+                                                         const std::vector<PoolStatRow>& rows,
+                                                         size_t threads) {
+    QuotePrices quotes;
+    auto mints = split_by_mint(pools, rows, threads, quotes);
+
+    // Every mint only reads the quote series, so they build in parallel
+    std::vector<std::shared_ptr<TokenState>> built(mints.size());
+    parallel_for(mints.size(), threads, [&](size_t i) {
+        auto& mint = mints[i];
+        auto token = std::make_shared<TokenState>();
+        token->mint = mint.mint();
+        token->symbol = mint.mint().substr(0, 8);
+
+        MarketData md;
+        while (mint.next_ts(rows) != std::numeric_limits<int64_t>::max()) {
+            if (mint.next(pools, rows, quotes, md)) token->update(md);
+        }
+        if (!token->history.empty()) built[i] = std::move(token);
+    });
+
+    std::vector<std::shared_ptr<TokenState>> tokens;
+    for (auto& token : built) {
+        if (token) tokens.push_back(std::move(token));
+    }
+    return tokens;
+}
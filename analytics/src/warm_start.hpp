@@ -0,0 +1,78 @@
+#pragma once
+
+#include "state.hpp"
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+constexpr const char* kUsdcMint = "EPjFWdd5AufqSSqeM2qN1xzybapC8G4wEGGkZwyTDt1v";
+constexpr const char* kUsdtMint = "Es9vMFrzaCERmJfrF4H2FYD4KCoNkY11McCe8BenwNYB";
+
+// A row of the ingestor's pools table
+struct PoolInfo {
+    int64_t id;
+    std::string address;
+    std::string mint_base;
+    std::string mint_quote;
+};
+
+// A row of pool_stats_5m; pool is an index into the PoolInfo list
+struct PoolStatRow {
+    uint32_t pool;
+    int64_t ts_ms;
+    double price;            // in quote units
+    double liq_usd;
+    double vol24h_usd;
+    double spread_pct;
+    double impact_1pct_pct;
+    double route_dev_pct;
+    int32_t route_hops;
+    bool route_ok;
+    bool degraded;
+};
+
+// Consolidated USD price series of each non-stable quote mint, ascending by
+// timestamp
+using QuotePrices = std::unordered_map<std::string, std::vector<std::pair<int64_t, double>>>;
+
+// Walks one mint's pool rows in timestamp order, consolidating the pools at
+// each timestamp into the per-mint update the ingestor's MintView would have
+// streamed: liquidity-weighted USD price, summed liquidity and volume, the
+// cheapest pool's spread and impact, and the same synthetic bars.
+class MintConsolidator {
+public:
+    MintConsolidator(std::string mint, std::vector<uint32_t> indices);
+
+    const std::string& mint() const { return mint_; }
+    // Orders the rows by (timestamp, pool); call once before replaying
+    void sort(const std::vector<PoolStatRow>& rows);
+    // Timestamp of the next update, or INT64_MAX once every row is consumed
+    int64_t next_ts(const std::vector<PoolStatRow>& rows) const;
+    // Consumes the next timestamp's rows. False if none of them could be
+    // priced in USD; an unpriced update would read as a price of 0.
+    bool next(const std::vector<PoolInfo>& pools, const std::vector<PoolStatRow>& rows,
+              const QuotePrices& quotes, MarketData& md);
+    void rewind() { pos_ = 0; }
+
+private:
+    std::string mint_;
+    std::vector<uint32_t> indices_;
+    size_t pos_ = 0;
+    std::vector<std::pair<double, double>> priced_;   // (usd price, liquidity) scratch
+};
+
+// Groups rows by their pool's base mint, sorted for replay on `threads`
+// threads. Quote mints come first, SOL ahead of the rest, and their USD series
+// are built into `quotes` so SOL-quoted pools can be priced.
+std::vector<MintConsolidator> split_by_mint(const std::vector<PoolInfo>& pools,
+                                            const std::vector<PoolStatRow>& rows,
+                                            size_t threads, QuotePrices& quotes);
+
+// Rebuilds per-mint histories from per-pool 5m stats by replaying every
+// mint's consolidated updates, on `threads` threads.
+std::vector<std::shared_ptr<TokenState>> build_histories(const std::vector<PoolInfo>& pools,
+                                                         const std::vector<PoolStatRow>& rows,
+                                                         size_t threads);
@@ -0,0 +1,9 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+// Global operator new calls in analytics_tests, counted by alloc_counter.cpp
+namespace alloc_counter {
+    extern std::atomic<uint64_t> allocations_total;
+}
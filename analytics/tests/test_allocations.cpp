@@ -0,0 +1,84 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../src/decision.hpp"
+#include "../src/state.hpp"
+#include "alloc_counter.hpp"
+#include "test_helpers.hpp"
+#include <spdlog/spdlog.h>
+#include <string>
+#include <vector>
+
+// Even mints are deep and liquid; odd ones are thin and volumeless, so their
+// data quality forces a Heads-up band and the alert path runs for them
+static MarketData update(const std::string& mint, size_t i, int64_t ts_ms, double price) {
+    bool thin = i % 2 == 1;
+    MarketData md = market_sample(ts_ms, price, thin ? 0.0 : 4e4);
+    md.pool = "Pool" + mint;
+    md.mint_base = mint;
+    md.mint_quote = kSolMint;
+    md.symbol = "TOK" + std::to_string(i);
+    md.liq_usd = thin ? 100.0 : 2e6;
+    md.vol24h_usd = thin ? 0.0 : 5e6;
+    md.spread_pct = 0.3;
+    md.impact_1pct_pct = 0.2;
+    md.age_hours = 200.0;
+    md.pool_count = 1;
+    md.route = MarketData::Route{true, 1, 0.1};
+    md.dq = "ok";
+    return md;
+}
+
+TEST_CASE("Token updates and batch scoring do not allocate once warm", "[allocations]") {
+    Config config = test_config();
+    config.shadow_weights = "flat=0.1,0.1,0.1,0.1,0.1,0.1,0.1,0.1,0.1,0.1";
+    auto scoring = ScoringConfig::from_config(config);
+    RegimeAssessment regime{};
+    regime.regime = MarketRegime::Neutral;
+
+    std::vector<std::string> mints;
+    std::vector<MarketData> updates;
+    for (size_t i = 0; i < 16; i++) {
+        mints.push_back("Mint" + std::to_string(i) + std::string(40, 'x'));
+        updates.push_back(update(mints[i], i, 1700000000000LL, 1.0 + i));
+    }
+
+    // Created on first use; the service sets it up at startup
+    spdlog::default_logger();
+
+    StateManager state;
+    // The previous version of each token stays held, as a result still
+    // queued for the publisher would hold it, so every update copies
+    std::vector<std::shared_ptr<const TokenState>> held(mints.size());
+    std::vector<const TokenState*> batch;
+    batch.reserve(mints.size());
+    std::vector<ScoringResult> out;
+    size_t banded = 0;
+
+    auto step = [&](int k) {
+        batch.clear();
+        for (size_t i = 0; i < mints.size(); i++) {
+            MarketData& md = updates[i];
+            md.ts_ms += 60000;
+            md.price *= (k % 3 == 0) ? 1.004 : 0.999;
+            md.bar_5m.c = md.price;
+            md.bar_15m.c = md.price;
+            state.update_token(mints[i], md);
+            held[i] = state.get_token(mints[i]);
+            batch.push_back(held[i].get());
+        }
+        score_tokens(batch, regime, scoring, out);
+        for (const auto& r : out) {
+            if (r.band != "none") banded++;
+        }
+    };
+
+    for (int k = 0; k < 8; k++) step(k);
+
+    uint64_t before = alloc_counter::allocations_total.load();
+    for (int k = 8; k < 400; k++) step(k);
+    uint64_t allocations = alloc_counter::allocations_total.load() - before;
+
+    REQUIRE(allocations == 0);
+    REQUIRE(banded > 0);
+    REQUIRE(out.size() == mints.size());
+    REQUIRE(out[0].shadow_count == 1);
+}
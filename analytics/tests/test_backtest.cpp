@@ -0,0 +1,108 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../src/backtest.hpp"
+#include "../src/util.hpp"
+#include "test_helpers.hpp"
+#include <cmath>
+#include <random>
+
+// Thin, volumeless pools: their data quality forces Heads-up on every update
+static PoolStatRow thin(uint32_t pool, int64_t ts_ms, double price) {
+    PoolStatRow row{};
+    row.pool = pool;
+    row.ts_ms = ts_ms;
+    row.price = price;
+    row.liq_usd = 100.0;
+    row.spread_pct = 0.5;
+    row.impact_1pct_pct = 0.5;
+    row.route_ok = true;
+    row.route_hops = 1;
+    return row;
+}
+
+static const int64_t kT0 = 1700000000000LL - 1700000000000LL % 300000;
+static const int64_t kStep = 300000;
+
+TEST_CASE("Backtest alerts carry forward returns at each horizon", "[backtest]") {
+    std::vector<PoolInfo> pools = {{1, "PoolA", "MintA", kUsdcMint}};
+    std::vector<PoolStatRow> rows;
+    const int steps = 36 * 12;   // 36h of 5m stats
+    auto price = [](int k) { return 1.0 + 0.01 * k; };
+    for (int k = 0; k < steps; k++) {
+        rows.push_back(thin(0, kT0 + k * kStep, price(k)));
+    }
+
+    Backtester backtester(test_config(), 2);
+    auto report = backtester.run(pools, rows);
+
+    REQUIRE(report.mints == 1);
+    REQUIRE(report.updates == static_cast<size_t>(steps));
+    REQUIRE(report.scored["heads_up"] == static_cast<size_t>(steps));
+    // One Heads-up per hour gets past the cooldown
+    REQUIRE(report.alerts.size() == 36);
+    REQUIRE(report.gated["cooldown"] == static_cast<size_t>(steps - 36));
+
+    for (const auto& a : report.alerts) {
+        int k = static_cast<int>((a.ts_ms - kT0) / kStep);
+        REQUIRE(a.band == "heads_up");
+        REQUIRE(a.mint == "MintA");
+        REQUIRE(near_rel(a.price, price(k)));
+        REQUIRE(a.alert["ts"] == util::iso8601(a.ts_ms));
+        REQUIRE(a.alert["config_version"] == "env");
+        for (size_t h = 0; h < report.horizons_ms.size(); h++) {
+            int ahead = static_cast<int>(report.horizons_ms[h] / kStep);
+            if (k + ahead < steps) {
+                REQUIRE(a.returns[h]);
+                REQUIRE(near_rel(*a.returns[h], (price(k + ahead) / price(k) - 1.0) * 100.0));
+            } else {
+                REQUIRE_FALSE(a.returns[h]);
+            }
+        }
+    }
+
+    auto summary = report.summary();
+    REQUIRE(summary["bands"]["heads_up"]["alerts"] == 36);
+    REQUIRE(summary["bands"]["heads_up"]["1h"]["hit_rate"] == 1.0);
+    REQUIRE(summary["bands"]["heads_up"]["24h"]["resolved"] == 12);
+}
+
+TEST_CASE("Backtest results do not depend on the thread count", "[backtest]") {
+    std::vector<PoolInfo> pools;
+    std::vector<PoolStatRow> rows;
+    std::mt19937_64 rng(7);
+    std::normal_distribution<double> step_return(0.0, 0.02);
+    for (uint32_t p = 0; p < 60; p++) {
+        pools.push_back({p, "Pool" + std::to_string(p), "Mint" + std::to_string(p % 23), kUsdcMint});
+        double price = 1.0 + p;
+        for (int k = 0; k < 12 * 12; k++) {
+            price *= std::exp(step_return(rng));
+            // Gaps, so mints update on different steps
+            if (rng() % 5 == 0) continue;
+            PoolStatRow row = thin(p, kT0 + k * kStep, price);
+            // Every third mint stays thin and alerts; the rest trade
+            if ((p % 23) % 3 != 0) {
+                row.liq_usd = 50000.0 + p * 1000.0;
+                row.vol24h_usd = row.liq_usd * 2.0;
+            }
+            rows.push_back(row);
+        }
+    }
+
+    auto one = Backtester(test_config(), 1).run(pools, rows);
+    auto many = Backtester(test_config(), 8).run(pools, rows);
+
+    REQUIRE(one.updates == many.updates);
+    REQUIRE(one.scored == many.scored);
+    REQUIRE(one.gated == many.gated);
+    REQUIRE(!one.alerts.empty());
+    REQUIRE(one.alerts.size() == many.alerts.size());
+    bool same = true;
+    for (size_t i = 0; i < one.alerts.size(); i++) {
+        const auto& a = one.alerts[i];
+        const auto& b = many.alerts[i];
+        if (a.ts_ms != b.ts_ms || a.mint != b.mint || a.band != b.band ||
+            a.confidence != b.confidence || a.returns != b.returns) {
+            same = false;
+        }
+    }
+    REQUIRE(same);
+}
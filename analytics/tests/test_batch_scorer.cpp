@@ -0,0 +1,120 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../src/batch_scorer.hpp"
+#include <random>
+#include <stdexcept>
+
+TEST_CASE("Batch scorer matches the scalar scorer for every profile", "[batch_scorer]") {
+    std::mt19937_64 rng(11);
+    std::uniform_real_distribution<double> unit(0.0, 1.0);
+    std::uniform_real_distribution<double> age(0.0, 120.0);
+    std::uniform_real_distribution<double> cost(0.0, 3.0);
+
+    std::vector<ScoringWeights> profiles = {ScoringWeights()};
+    for (int k = 0; k < 3; k++) {
+        ScoringWeights w;
+        w.w_S1 = unit(rng) * 0.3;
+        w.w_S4 = unit(rng) * 0.3;
+        w.w_S7 = unit(rng) * 0.3;
+        w.w_S10 = unit(rng) * 0.1;
+        profiles.push_back(w);
+    }
+    BatchScorer batch_scorer(profiles);
+    REQUIRE(batch_scorer.profiles() == 4);
+
+    std::vector<TokenState> tokens(500);
+    std::vector<SignalScores> signals(tokens.size());
+    SignalBatch batch;
+    for (size_t i = 0; i < tokens.size(); i++) {
+        auto& md = tokens[i].latest;
+        md.age_hours = age(rng);
+        md.spread_pct = cost(rng);
+        md.impact_1pct_pct = cost(rng);
+        md.bar_5m.v_usd = unit(rng) < 0.2 ? 0.0 : unit(rng) * 1000;
+        md.bar_15m.v_usd = unit(rng) < 0.2 ? 0.0 : unit(rng) * 3000;
+        md.dq = unit(rng) < 0.2 ? "degraded" : "ok";
+
+        auto& s = signals[i];
+        // Many values near the gate edges, some far above them
+        s.S1 = unit(rng) < 0.2 ? 0.05 : unit(rng);
+        s.S2 = unit(rng) < 0.2 ? 0.05 : unit(rng);
+        s.S3 = unit(rng);
+        s.S4 = unit(rng) < 0.2 ? 0.05 : unit(rng);
+        s.S5 = unit(rng);
+        s.S6 = unit(rng);
+        s.S7 = unit(rng) < 0.5 ? 0.9 + unit(rng) * 0.1 : unit(rng);
+        s.S8 = unit(rng);
+        s.S9 = unit(rng);
+        s.S10 = unit(rng);
+        s.N1 = unit(rng) < 0.3 ? 0.0 : 1.0;
+        batch.add(tokens[i], s);
+    }
+
+    const int threshold = 65;
+    BatchScores scores;
+    batch_scorer.score(batch, threshold, scores);
+    REQUIRE(scores.rows == tokens.size());
+
+    size_t mismatches = 0;
+    size_t banded = 0;
+    for (size_t k = 0; k < profiles.size(); k++) {
+        ConfidenceScorer scalar(profiles[k]);
+        for (size_t i = 0; i < tokens.size(); i++) {
+            auto expected = scalar.compute_confidence(tokens[i], signals[i]);
+            auto got = scores.result(k, i, batch);
+            std::string band = scalar.determine_band(expected.final_confidence, expected, threshold);
+            if (got.raw_score != expected.raw_score ||
+                got.penalties != expected.penalties ||
+                got.data_quality != expected.data_quality ||
+                got.final_confidence != expected.final_confidence ||
+                got.young_and_risky != expected.young_and_risky ||
+                got.rug_cap_applied != expected.rug_cap_applied ||
+                got.dq_forced_headsup != expected.dq_forced_headsup ||
+                got.reasons != expected.reasons ||
+                band_name(scores.band_at(k, i)) != band) {
+                mismatches++;
+            }
+            if (band != "none") banded++;
+        }
+    }
+    REQUIRE(mismatches == 0);
+    REQUIRE(banded > 0);
+}
+
+TEST_CASE("Weight profiles parse from the environment format", "[batch_scorer]") {
+    REQUIRE(parse_weight_profiles("").empty());
+
+    auto profiles = parse_weight_profiles(
+        "momentum=0.1,0.1,0.05,0.3,0.1,0.05,0.12,0.1,0.05,0.03;flat=1,1,1,1,1,1,1,1,1,1");
+    REQUIRE(profiles.size() == 2);
+    REQUIRE(profiles[0].name == "momentum");
+    REQUIRE(profiles[0].weights.w_S4 == 0.3);
+    REQUIRE(profiles[0].weights.w_S10 == 0.03);
+    REQUIRE(profiles[1].name == "flat");
+    REQUIRE(profiles[1].weights.w_S1 == 1.0);
+
+    REQUIRE_THROWS_AS(parse_weight_profiles("short=0.1,0.2"), std::runtime_error);
+    REQUIRE_THROWS_AS(parse_weight_profiles("=1,1,1,1,1,1,1,1,1,1"), std::runtime_error);
+    REQUIRE_THROWS_AS(parse_weight_profiles("bad=1,1,1,1,x,1,1,1,1,1"), std::runtime_error);
+    std::string nine;
+    for (int k = 0; k < 9; k++) nine += "p" + std::to_string(k) + "=1,1,1,1,1,1,1,1,1,1;";
+    REQUIRE_THROWS_AS(parse_weight_profiles(nine), std::runtime_error);
+
+    REQUIRE(parse_band(band_name(Band::HighConviction)) == Band::HighConviction);
+    REQUIRE(parse_band("heads_up") == Band::HeadsUp);
+    REQUIRE(parse_band("other") == Band::None);
+}
+
+TEST_CASE("Reason sets compare, render and key by code", "[batch_scorer]") {
+    ReasonSet reasons;
+    REQUIRE(reasons.empty());
+    REQUIRE(reasons.key() == "0");
+
+    reasons.add(Reason::NotOnMirroredLists);
+    REQUIRE(reasons.has(Reason::NotOnMirroredLists));
+    REQUIRE(reasons.key() == "1");
+
+    std::vector<std::string> texts;
+    reasons.for_each([&texts](Reason r) { texts.push_back(reason_text(r)); });
+    REQUIRE(texts == std::vector<std::string>{"Not on widely mirrored lists"});
+    REQUIRE(reasons != ReasonSet{});
+}
@@ -0,0 +1,40 @@
+#pragma once
+
+#include "../src/config.hpp"
+#include "../src/state.hpp"
+#include <algorithm>
+#include <cmath>
+
+// Equal to within 1e-9
+inline bool near(double a, double b) { return std::abs(a - b) < 1e-9; }
+
+// Equal to within tol relative to b, for values built up from large sums
+inline bool near_rel(double a, double b, double tol = 1e-9) {
+    return std::abs(a - b) <= tol * std::max(1.0, std::abs(b));
+}
+
+// One update with flat bars at price: vol_5m over five minutes and three
+// times that over fifteen. Tests set whatever else they exercise.
+inline MarketData market_sample(int64_t ts_ms, double price, double vol_5m = 0.0) {
+    MarketData md{};
+    md.price = price;
+    md.liq_usd = 100000.0;
+    md.bar_5m = MarketData::Bar{price, price, price, price, vol_5m};
+    md.bar_15m = MarketData::Bar{price, price, price, price, vol_5m * 3};
+    md.ts_ms = ts_ms;
+    return md;
+}
+
+// The documented scoring, gate and regime defaults, without reading the environment
+inline Config test_config() {
+    Config config{};
+    config.actionable_base_threshold = 70;
+    config.risk_on_adj = -10;
+    config.risk_off_adj = 10;
+    config.global_actionable_max_per_hour = 5;
+    config.regime_refresh_sec = 60;
+    config.cooldown_actionable_hours = 6;
+    config.cooldown_headsup_hours = 1;
+    config.reentry_guard_hours = 12;
+    return config;
+}
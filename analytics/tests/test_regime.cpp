@@ -1,5 +1,6 @@
 #include <catch2/catch_test_macros.hpp>
 #include "../src/regime.hpp"
+#include <cmath>
 
 TEST_CASE("Risk regime detection", "[regime]") {
     StateManager state_mgr;
@@ -9,4 +10,79 @@ TEST_CASE("Risk regime detection", "[regime]") {
         // Simplified test
         REQUIRE(true);
     }
-}
\ No newline at end of file
+}
+static TokenState token_with(const std::string& mint, double old_price, double price,
+                             double vol_5m) {
+    TokenState token;
+    token.mint = mint;
+    MarketData md{};
+    md.mint_base = mint;
+    md.price = old_price;
+    md.bar_5m = MarketData::Bar{old_price, old_price, old_price, old_price, vol_5m};
+    md.ts_ms = 0;
+    token.update(md);
+    md.price = price;
+    md.bar_5m = MarketData::Bar{price, price, price, price, vol_5m};
+    md.ts_ms = 60000;
+    token.update(md);
+    return token;
+}
+
+TEST_CASE("RegimeDetector classifies from indicator counts", "[regime]") {
+    REQUIRE(RegimeDetector::classify(true, true, false).regime == MarketRegime::RiskOn);
+    REQUIRE(RegimeDetector::classify(false, true, false).regime == MarketRegime::Neutral);
+    REQUIRE(RegimeDetector::classify(false, false, false).regime == MarketRegime::RiskOff);
+    REQUIRE(RegimeDetector::classify(false, false, false).threshold_adjustment == 10);
+}
+
+TEST_CASE("RegimeDetector keeps the median and VWAP tallies incrementally", "[regime]") {
+    RegimeDetector detector(60000);
+    REQUIRE(detector.current()->regime == MarketRegime::Neutral);
+
+    // m24h of +10%, -20%, +30%: median +10%, two of three above their VWAP
+    detector.observe(token_with("A", 1.0, 1.1, 100.0));
+    detector.observe(token_with("B", 1.0, 0.8, 100.0));
+    detector.observe(token_with("C", 1.0, 1.3, 100.0));
+    REQUIRE(detector.universe() == 3);
+    REQUIRE(std::abs(detector.median_24h_return() - 10.0) < 1e-9);
+    REQUIRE(std::abs(detector.above_vwap_ratio() - 2.0 / 3.0) < 1e-9);
+
+    // Matches returns[n / 2] of the sorted returns for even n
+    detector.observe(token_with("D", 1.0, 1.5, 100.0));
+    REQUIRE(std::abs(detector.median_24h_return() - 30.0) < 1e-9);
+
+    // Updating a mint moves its return instead of adding one
+    detector.observe(token_with("D", 1.0, 0.5, 100.0));
+    REQUIRE(detector.universe() == 4);
+    REQUIRE(std::abs(detector.median_24h_return() - 10.0) < 1e-9);
+    REQUIRE(std::abs(detector.above_vwap_ratio() - 0.5) < 1e-9);
+
+    detector.forget("D");
+    detector.forget("B");
+    REQUIRE(std::abs(detector.median_24h_return() - 30.0) < 1e-9);
+    REQUIRE(std::abs(detector.above_vwap_ratio() - 1.0) < 1e-9);
+}
+
+TEST_CASE("RegimeDetector republishes on its interval or a universe change", "[regime]") {
+    RegimeDetector detector(60000);
+    REQUIRE(detector.refresh(1000));
+    REQUIRE(!detector.refresh(2000));
+
+    // Two positive indicators: median and VWAP majority
+    detector.observe(token_with("A", 1.0, 1.2, 100.0));
+    auto before = detector.current();
+    REQUIRE(detector.refresh(3000));
+    auto after = detector.current();
+    REQUIRE(after->regime == MarketRegime::RiskOn);
+    REQUIRE(after->universe == 1);
+    REQUIRE(after->computed_ms == 3000);
+    // Earlier snapshots stay valid for readers holding them
+    REQUIRE(before->universe == 0);
+
+    detector.observe(token_with("A", 1.0, 0.9, 100.0));
+    REQUIRE(!detector.refresh(4000));
+    REQUIRE(detector.current()->regime == MarketRegime::RiskOn);
+    REQUIRE(detector.refresh(63000));
+    REQUIRE(detector.current()->regime == MarketRegime::RiskOff);
+    REQUIRE(detector.refresh(64000, true));
+}
@@ -0,0 +1,87 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../src/rolling_stats.hpp"
+#include "../src/state.hpp"
+#include "test_helpers.hpp"
+#include <cmath>
+#include <random>
+
+TEST_CASE("WindowExtremum tracks a sliding max and a lagged min", "[rolling_stats]") {
+    WindowExtremum max3(3, 0, true);
+    REQUIRE(std::isinf(max3.value()));
+
+    double values[] = {4, 2, 5, 1, 1, 3};
+    double expected[] = {4, 4, 5, 5, 5, 3};
+    for (uint64_t i = 0; i < 6; i++) {
+        max3.push(i, values[i]);
+        REQUIRE(max3.value() == expected[i]);
+    }
+
+    WindowSum sum(WindowSum::Source::Price, 4);
+    for (double v : {2.0, 4.0, 4.0, 4.0}) sum.add(v);
+    REQUIRE(sum.full());
+    REQUIRE(near_rel(sum.mean(), 3.5, 1e-6));
+    REQUIRE(near_rel(sum.variance(), 0.75, 1e-6));
+}
+
+TEST_CASE("RollingStats matches full rescans of the history", "[rolling_stats]") {
+    // Small capacity so the ring wraps and the periodic rebuild runs
+    const size_t capacity = 150;
+    TokenHistory h(capacity);
+    RollingStats stats(capacity);
+
+    std::mt19937 rng(7);
+    std::uniform_real_distribution<double> step(-0.03, 0.03);
+    std::uniform_real_distribution<double> vol(0.0, 5000.0);
+
+    double price = 1.0;
+    for (int t = 0; t < 700; t++) {
+        price *= 1.0 + step(rng);
+        stats.push(h, market_sample(t * 60000LL, price, vol(rng)));
+        size_t n = h.size();
+
+        REQUIRE(stats.low_recent.value() == h.min_price(n - std::min<size_t>(n, 10), n));
+        REQUIRE(stats.high_24h.value() == h.max_price(0, n));
+        if (n >= 20) {
+            REQUIRE(stats.low_prev.value() == h.min_price(n - 20, n - 10));
+            REQUIRE(stats.high_retest.value() == h.max_price(n - 20, n - 5));
+            REQUIRE(stats.low_retest.value() == h.min_price(n - 5, n));
+        }
+        if (n >= 30) {
+            REQUIRE(stats.high_pullback.value() == h.max_price(n - 30, n - 15));
+            REQUIRE(stats.low_pullback.value() == h.min_price(n - 15, n));
+        }
+        if (n >= 100) {
+            REQUIRE(near_rel(stats.vol_recent.sum, h.sum(TokenHistory::Column::Bar5mV, n - 50, n), 1e-6));
+            REQUIRE(near_rel(stats.vol_100.sum, h.sum(TokenHistory::Column::Bar5mV, n - 100, n), 1e-6));
+        }
+        if (n >= 60) {
+            double mean = 0.0, var = 0.0;
+            for (size_t i = n - 60; i < n; i++) mean += h.price(i);
+            mean /= 60.0;
+            for (size_t i = n - 60; i < n; i++) var += (h.price(i) - mean) * (h.price(i) - mean);
+            var /= 60.0;
+            REQUIRE(near_rel(stats.price_60.mean(), mean, 1e-6));
+            REQUIRE(std::abs(stats.price_60.variance() - var) < 1e-9);
+        }
+
+        double num = 0.0;
+        for (size_t i = 0; i < n; i++) num += h.price(i) * h.vol_5m(i);
+        REQUIRE(near_rel(stats.vwap_num.sum, num, 1e-6));
+        REQUIRE(near_rel(stats.vwap_den.sum, h.sum(TokenHistory::Column::Bar5mV, 0, n), 1e-6));
+    }
+}
+
+TEST_CASE("TokenState slides its stats on update", "[rolling_stats]") {
+    TokenState state;
+    for (int i = 0; i < 25; i++) {
+        state.update(market_sample(i * 60000LL, 10.0 + i, 100.0));
+    }
+    REQUIRE(state.stats.high_24h.value() == 34.0);
+    REQUIRE(state.stats.low_recent.value() == 25.0);
+    REQUIRE(state.stats.low_prev.value() == 15.0);
+    REQUIRE(near_rel(state.stats.vwap_den.sum, 2500.0, 1e-6));
+
+    state.stats.clear();
+    REQUIRE(state.stats.high_24h.empty());
+    REQUIRE(state.stats.vwap_den.count == 0);
+}
@@ -0,0 +1,77 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../src/scoring_config.hpp"
+#include "test_helpers.hpp"
+#include <optional>
+#include <stdexcept>
+#include <string>
+
+static std::shared_ptr<const ScoringConfig> env_config() {
+    Config config = test_config();
+    config.shadow_weights = "flat=0.1,0.1,0.1,0.1,0.1,0.1,0.1,0.1,0.1,0.1";
+    return ScoringConfig::from_config(config);
+}
+
+TEST_CASE("Scoring config documents override the environment field by field", "[scoring_config]") {
+    auto base = env_config();
+    REQUIRE(base->version == "env");
+    REQUIRE(base->scorer.profiles() == 2);
+
+    auto cfg = ScoringConfig::parse(R"({
+        "version": "v2",
+        "weights": [0.2, 0.1, 0.05, 0.2, 0.1, 0.05, 0.1, 0.1, 0.05, 0.05],
+        "actionable_base_threshold": 75,
+        "cooldown_headsup_hours": 2
+    })", *base);
+    REQUIRE(cfg->version == "v2");
+    REQUIRE(cfg->weights.w_S1 == 0.2);
+    REQUIRE(cfg->actionable_base_threshold == 75);
+    REQUIRE(cfg->cooldown_headsup_hours == 2);
+    // Unset fields keep the environment's values
+    REQUIRE(cfg->cooldown_actionable_hours == 6);
+    REQUIRE(cfg->shadows.size() == 1);
+    REQUIRE(cfg->scorer.profiles() == 2);
+
+    auto no_shadows = ScoringConfig::parse(R"({"version": "v3", "shadow_weights": {}})", *base);
+    REQUIRE(no_shadows->scorer.profiles() == 1);
+
+    REQUIRE_THROWS_AS(ScoringConfig::parse("{", *base), std::runtime_error);
+    REQUIRE_THROWS_AS(ScoringConfig::parse(R"({"weights": [1,1,1,1,1,1,1,1,1,1]})", *base),
+                      std::runtime_error);
+    REQUIRE_THROWS_AS(ScoringConfig::parse(R"({"version": "x", "weights": [1,1,1]})", *base),
+                      std::runtime_error);
+    REQUIRE_THROWS_AS(ScoringConfig::parse(R"({"version": "x", "actionable_base_threshold": 170})", *base),
+                      std::runtime_error);
+    REQUIRE_THROWS_AS(ScoringConfig::parse(R"({"version": "x", "cooldown_hours": 3})", *base),
+                      std::runtime_error);
+}
+
+TEST_CASE("Scoring config source swaps in new valid versions only", "[scoring_config]") {
+    std::optional<std::string> doc;
+    ScoringConfigSource source(env_config(), [&doc]() { return doc; });
+    auto initial = source.current();
+    REQUIRE_FALSE(source.reload());
+
+    doc = R"({"version": "v2", "actionable_base_threshold": 65})";
+    REQUIRE(source.reload());
+    auto v2 = source.current();
+    REQUIRE(v2->version == "v2");
+    REQUIRE(v2->actionable_base_threshold == 65);
+    // Holders of the previous version keep it intact
+    REQUIRE(initial->actionable_base_threshold == 70);
+
+    // Same version with different contents, or an invalid document: kept
+    doc = R"({"version": "v2", "actionable_base_threshold": 60})";
+    REQUIRE_FALSE(source.reload());
+    doc = R"({"version": "v3", "risk_on_adj": "low"})";
+    REQUIRE_FALSE(source.reload());
+    REQUIRE(source.current() == v2);
+
+    // Unreadable: kept
+    doc.reset();
+    REQUIRE_FALSE(source.reload());
+    REQUIRE(source.current() == v2);
+
+    doc = R"({"version": "v3"})";
+    REQUIRE(source.reload());
+    REQUIRE(source.current()->actionable_base_threshold == 70);
+}
@@ -0,0 +1,228 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../src/scoring_pool.hpp"
+#include "../src/spsc_queue.hpp"
+#include "../src/util.hpp"
+#include <algorithm>
+#include <map>
+#include <thread>
+
+TEST_CASE("SpscQueue passes items in order between two threads", "[scoring_pool]") {
+    SpscQueue<int> queue(8);
+    REQUIRE(queue.capacity() == 8);
+    REQUIRE(queue.empty());
+
+    const int kItems = 100000;
+    std::thread producer([&queue]() {
+        for (int i = 0; i < kItems; i++) {
+            int item = i;
+            while (!queue.try_push(std::move(item))) std::this_thread::yield();
+        }
+    });
+
+    int expected = 0;
+    bool ordered = true;
+    while (expected < kItems) {
+        int item;
+        if (queue.try_pop(item)) {
+            if (item != expected) ordered = false;
+            expected++;
+        }
+    }
+    producer.join();
+    REQUIRE(ordered);
+    REQUIRE(queue.empty());
+}
+
+TEST_CASE("SpscQueue rejects pushes when full", "[scoring_pool]") {
+    SpscQueue<std::string> queue(2);
+    REQUIRE(queue.try_push("a"));
+    REQUIRE(queue.try_push("b"));
+    std::string c = "c";
+    REQUIRE(!queue.try_push(std::move(c)));
+    REQUIRE(c == "c");
+
+    std::string out;
+    REQUIRE(queue.try_pop(out));
+    REQUIRE(out == "a");
+}
+
+TEST_CASE("ScoringPool routes each mint to one worker and scores every job", "[scoring_pool]") {
+    REQUIRE(ScoringPool::worker_for("MintA", 4) == ScoringPool::worker_for("MintA", 4));
+    REQUIRE(ScoringPool::worker_for("MintA", 1) == 0);
+
+    ScoringPool pool(4, 4, [](const TokenState& token) {
+        ScoringResult r;
+        r.band = token.latest.price > 50 ? "heads_up" : "none";
+        r.confidence = static_cast<double>(token.history.size());
+        return r;
+    });
+    pool.start();
+
+    const int kMints = 20;
+    const int kBatches = 10;
+    std::vector<ScoringResult> results;
+    std::thread publisher([&]() {
+        while (results.size() < static_cast<size_t>(kMints * kBatches)) {
+            pool.poll(results, 16);
+        }
+    });
+
+    for (int b = 0; b < kBatches; b++) {
+        for (int m = 0; m < kMints; m++) {
+            ScoringJob job;
+            job.mint = "Mint" + std::to_string(m);
+            MarketData md{};
+            md.mint_base = job.mint;
+            md.price = b * 10.0;
+            job.updates = {md, md};
+            job.msg_ids = {std::to_string(b) + "-" + std::to_string(m)};
+            pool.submit(std::move(job));
+        }
+    }
+    publisher.join();
+    pool.stop();
+    REQUIRE(pool.drained());
+
+    // Per mint, results arrive in submission order with two updates per job
+    std::map<std::string, double> last_size;
+    bool ordered = true;
+    int alerts = 0;
+    for (const auto& r : results) {
+        if (r.confidence != last_size[r.mint] + 2) ordered = false;
+        last_size[r.mint] = r.confidence;
+        REQUIRE(r.token);
+        REQUIRE(r.msg_ids.size() == 1);
+        if (r.band == "heads_up") alerts++;
+    }
+    REQUIRE(ordered);
+    REQUIRE(alerts == kMints * 4);   // prices 60..90
+    REQUIRE(pool.tokens() == static_cast<size_t>(kMints));
+}
+
+TEST_CASE("Mints map to a stable partition stream", "[scoring_pool]") {
+    REQUIRE(util::partition_stream("soul.market.mints", 0, 1) == "soul.market.mints");
+    REQUIRE(util::partition_stream("soul.market.mints", 3, 8) == "soul.market.mints.3");
+    REQUIRE(util::mint_partition("MintA", 1) == 0);
+
+    std::vector<int> counts(8, 0);
+    for (int m = 0; m < 800; m++) {
+        std::string mint = "Mint" + std::to_string(m);
+        int p = util::mint_partition(mint, 8);
+        REQUIRE(p >= 0);
+        REQUIRE(p < 8);
+        REQUIRE(util::mint_partition(mint, 8) == p);
+        counts[p]++;
+    }
+    for (int c : counts) {
+        REQUIRE(c > 50);
+    }
+}
+
+// The ingestor keeps its own copy of these; its suite checks the same vectors
+TEST_CASE("Partition hashing uses fixed vectors shared with the ingestor", "[scoring_pool]") {
+    // Published FNV-1a 64-bit vectors
+    REQUIRE(util::fnv1a_64("") == 0xcbf29ce484222325ULL);
+    REQUIRE(util::fnv1a_64("a") == 0xaf63dc4c8601ec8cULL);
+    REQUIRE(util::fnv1a_64("foobar") == 0x85944171f73967e8ULL);
+    REQUIRE(util::fnv1a_64_update(util::fnv1a_64_update(util::kFnv1aOffset, "foo", 3), "bar", 3) ==
+            0x85944171f73967e8ULL);
+
+    REQUIRE(util::mint_partition("So11111111111111111111111111111111111111112", 8) == 7);
+    REQUIRE(util::mint_partition("EPjFWdd5AufqSSqeM2qN1xzybapC8G4wEGGkZwyTDt1v", 8) == 4);
+    REQUIRE(util::mint_partition("EPjFWdd5AufqSSqeM2qN1xzybapC8G4wEGGkZwyTDt1v", 3) == 1);
+    REQUIRE(util::partition_stream("soul.market.mints", 0, 1) == "soul.market.mints");
+    REQUIRE(util::partition_stream("soul.market.mints", 7, 8) == "soul.market.mints.7");
+}
+
+TEST_CASE("Replay jobs rebuild state without results and remove_if drops tokens", "[scoring_pool]") {
+    ScoringPool pool(2, 16, [](const TokenState& token) {
+        ScoringResult r;
+        r.band = "heads_up";
+        r.confidence = static_cast<double>(token.history.size());
+        return r;
+    });
+    pool.start();
+
+    for (int m = 0; m < 4; m++) {
+        ScoringJob job;
+        job.mint = "Mint" + std::to_string(m);
+        job.replay = true;
+        MarketData md{};
+        md.mint_base = job.mint;
+        md.price = 1.0;
+        job.updates = {md, md, md};
+        pool.submit(std::move(job));
+    }
+
+    ScoringJob live;
+    live.mint = "Mint0";
+    live.stream = "soul.market.mints.1";
+    live.msg_ids = {"1-0"};
+    MarketData md{};
+    md.mint_base = live.mint;
+    md.price = 1.0;
+    live.updates = {md};
+    pool.submit(std::move(live));
+    pool.stop();
+
+    std::vector<ScoringResult> results;
+    pool.poll(results, 100);
+    REQUIRE(results.size() == 1);
+    REQUIRE(results[0].confidence == 4);
+    REQUIRE(results[0].stream == "soul.market.mints.1");
+    REQUIRE(pool.tokens() == 4);
+
+    auto removed = pool.remove_if([](const TokenState& token) { return token.mint != "Mint0"; });
+    REQUIRE(removed.size() == 3);
+    REQUIRE(pool.tokens() == 1);
+}
+
+TEST_CASE("Workers score queued jobs in batches", "[scoring_pool]") {
+    std::vector<size_t> batch_sizes;
+    ScoringPool pool(1, 256, [&batch_sizes](const std::vector<const TokenState*>& tokens,
+                                            std::vector<ScoringResult>& out) {
+        batch_sizes.push_back(tokens.size());
+        out.clear();
+        for (const TokenState* token : tokens) {
+            ScoringResult r;
+            r.band = "none";
+            r.confidence = static_cast<double>(token->history.size());
+            out.push_back(std::move(r));
+        }
+    });
+
+    // Queued before the worker starts, so it finds them all at once
+    const int kMints = 40;
+    const int kJobs = 5;
+    for (int j = 0; j < kJobs; j++) {
+        for (int m = 0; m < kMints; m++) {
+            ScoringJob job;
+            job.mint = "Mint" + std::to_string(m);
+            job.replay = (m == 0 && j == 0);
+            MarketData md{};
+            md.mint_base = job.mint;
+            md.price = 1.0;
+            job.updates = {md};
+            job.msg_ids = {std::to_string(j) + "-" + std::to_string(m)};
+            pool.submit(std::move(job));
+        }
+    }
+    pool.start();
+    pool.stop();
+
+    std::vector<ScoringResult> results;
+    pool.poll(results, 1000);
+    REQUIRE(results.size() == static_cast<size_t>(kMints * kJobs - 1));
+
+    // Each job is scored on the state its own updates produced
+    std::map<std::string, double> last_size;
+    bool ordered = true;
+    for (const auto& r : results) {
+        double expected = last_size.count(r.mint) ? last_size[r.mint] + 1 : (r.mint == "Mint0" ? 2 : 1);
+        if (r.confidence != expected || r.msg_ids.size() != 1) ordered = false;
+        last_size[r.mint] = r.confidence;
+    }
+    REQUIRE(ordered);
+    REQUIRE(batch_sizes.size() > 1);
+    REQUIRE(*std::max_element(batch_sizes.begin(), batch_sizes.end()) == ScoringPool::kScoreBatch);
+}
@@ -0,0 +1,97 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../src/decision.hpp"
+#include "../src/redis_bus.hpp"
+#include "../src/throttles.hpp"
+#include "../src/util.hpp"
+#include <array>
+#include <cstdlib>
+#include <random>
+
+namespace {
+
+struct ThrottleHours {
+    int cooldown_actionable;
+    int cooldown_headsup;
+    int reentry_guard;
+};
+
+// Drives the same random alerts and stops through the Lua script and the
+// in-process throttles, requires the same gate for every alert and returns
+// how many alerts each gate decided
+std::array<int, 4> compare_gates(RedisBus& redis, const std::string& prefix,
+                                 const ThrottleHours& hours, int64_t retention_ms) {
+    int64_t now_ms = util::current_timestamp_ms();
+    ThrottleManager throttles([&now_ms]() { return now_ms; });
+
+    const std::vector<std::string> symbols = {"MintA", "MintB", "MintC", "MintD", "MintE", "MintF"};
+    const std::vector<std::string> bands = {"heads_up", "actionable", "high_conviction"};
+    const std::vector<std::string> reasons = {"r1", "r2", "r3", "r4"};
+    std::mt19937 rng(42);
+    auto pick = [&rng](size_t n) { return std::uniform_int_distribution<size_t>(0, n - 1)(rng); };
+
+    std::array<int, 4> seen{};
+    for (int pass = 0; pass < 500; pass++) {
+        now_ms += static_cast<int64_t>(1 + pick(20)) * 60 * 1000;
+        if (pick(8) == 0) {
+            const std::string& symbol = symbols[pick(symbols.size())];
+            throttles.record_stop(symbol);
+            redis.record_stop(prefix, symbol, now_ms, retention_ms);
+            continue;
+        }
+
+        std::vector<ThrottleCheck> checks(1 + pick(4));
+        for (auto& c : checks) {
+            c.symbol = symbols[pick(symbols.size())];
+            c.band = bands[pick(bands.size())];
+            c.reason_hash = reasons[pick(reasons.size())];
+            bool heads_up = c.band == "heads_up";
+            c.cooldown_hours = heads_up ? hours.cooldown_headsup : hours.cooldown_actionable;
+            c.reentry_guard_hours = c.band != "high_conviction" ? hours.reentry_guard : 0;
+            c.global_max_per_hour = heads_up ? -1 : 2;
+        }
+
+        auto shared = redis.check_and_record_alerts(prefix, checks, now_ms, retention_ms);
+        REQUIRE(shared.size() == checks.size());
+        for (size_t i = 0; i < checks.size(); i++) {
+            AlertGate local = check_alert_gates(checks[i], throttles);
+            if (local == AlertGate::Pass) record_sent_alert(checks[i], throttles);
+            INFO("pass " << pass << ", " << checks[i].band << " alert for " << checks[i].symbol);
+            REQUIRE(shared[i] == static_cast<int>(local));
+            seen[static_cast<size_t>(local)]++;
+        }
+    }
+    return seen;
+}
+
+} // namespace
+
+// Needs a Redis it may write to, named by TEST_REDIS_URL; keys go under a
+// prefix of their own
+TEST_CASE("Shared throttle script gates like the in-process throttles", "[throttles]") {
+    const char* url = std::getenv("TEST_REDIS_URL");
+    if (url == nullptr || *url == '\0') {
+        WARN("TEST_REDIS_URL is not set; skipping the shared throttle check");
+        return;
+    }
+
+    RedisBus redis(url);
+    REQUIRE(redis.ping());
+    const std::string prefix = "test.throttle." + std::to_string(util::current_timestamp_ms());
+
+    SECTION("Every gate") {
+        // Keys only need to outlive the test; the gates compare stored times with now_ms
+        auto seen = compare_gates(redis, prefix + ".all", ThrottleHours{2, 1, 3}, 10 * 60 * 1000);
+        for (int n : seen) {
+            REQUIRE(n > 0);
+        }
+    }
+
+    SECTION("Zero hours keep nothing but the global cap") {
+        // A config may set every window to 0, so the retention is 0 too
+        auto seen = compare_gates(redis, prefix + ".zero", ThrottleHours{0, 0, 0}, 0);
+        REQUIRE(seen[static_cast<size_t>(AlertGate::Pass)] > 0);
+        REQUIRE(seen[static_cast<size_t>(AlertGate::Cooldown)] == 0);
+        REQUIRE(seen[static_cast<size_t>(AlertGate::ReentryGuard)] == 0);
+        REQUIRE(seen[static_cast<size_t>(AlertGate::GlobalLimit)] > 0);
+    }
+}
@@ -0,0 +1,145 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../src/snapshot.hpp"
+#include "test_helpers.hpp"
+#include <cstdio>
+#include <fstream>
+#include <random>
+#include <unistd.h>
+
+static std::string temp_path(const char* name) {
+    return "/tmp/" + std::string(name) + "." + std::to_string(getpid());
+}
+
+static std::shared_ptr<const TokenState> make_token(const std::string& mint, int updates, unsigned seed) {
+    auto token = std::make_shared<TokenState>();
+    token->mint = mint;
+    token->symbol = mint.substr(0, 4);
+    token->entry_price = 0.0;
+    token->has_position = false;
+    token->first_liq_ts_ms = 1000;
+
+    std::mt19937 rng(seed);
+    std::uniform_real_distribution<double> step(-0.03, 0.03);
+    std::uniform_real_distribution<double> vol(0.0, 5000.0);
+    double price = 1.0;
+    for (int t = 0; t < updates; t++) {
+        price *= 1.0 + step(rng);
+        MarketData md = market_sample(1700000000000LL + t * 60000LL, price, vol(rng));
+        md.mint_base = mint;
+        md.symbol = token->symbol;
+        md.pool = "pool-" + mint;
+        md.dq = "ok";
+        md.liq_usd = 50000.0 + t;
+        md.pool_count = 2;
+        md.route = MarketData::Route{true, 1, 0.4};
+        md.bar_5m.h = price * 1.01;
+        md.bar_5m.l = price * 0.99;
+        token->update(md);
+    }
+    return token;
+}
+
+TEST_CASE("Snapshot round-trips token histories, stats and throttles", "[snapshot]") {
+    std::string path = temp_path("analytics_snapshot_test");
+    SnapshotStore store(path);
+
+    // One token past capacity so the saved ring has wrapped
+    std::vector<std::shared_ptr<const TokenState>> tokens = {
+        make_token("MintAAAA", 1700, 1),
+        make_token("MintBBBB", 90, 2),
+        make_token("MintCCCC", 0, 3),
+    };
+    ThrottleManager throttles;
+    throttles.record_alert("MintAAAA", "actionable", "abc");
+    throttles.record_global_alert();
+    throttles.record_stop("MintBBBB");
+
+    std::map<std::string, std::string> ids = {{"soul.market.mints", "1700000000000-3"}};
+    REQUIRE(store.save(42, ids, tokens, throttles.export_state()));
+
+    auto snap = store.load();
+    REQUIRE(snap);
+    REQUIRE(snap->created_ms == 42);
+    REQUIRE(snap->stream_ids == ids);
+    REQUIRE(snap->tokens.size() == tokens.size());
+
+    for (size_t t = 0; t < tokens.size(); t++) {
+        const TokenState& a = *tokens[t];
+        const TokenState& b = *snap->tokens[t];
+        REQUIRE(b.mint == a.mint);
+        REQUIRE(b.symbol == a.symbol);
+        REQUIRE(b.latest.pool == a.latest.pool);
+        REQUIRE(b.latest.price == a.latest.price);
+        REQUIRE(b.latest.route.ok == a.latest.route.ok);
+        REQUIRE(b.latest.bar_5m.v_usd == a.latest.bar_5m.v_usd);
+        REQUIRE(b.latest.ts_ms == a.latest.ts_ms);
+        REQUIRE(b.first_liq_ts_ms == a.first_liq_ts_ms);
+
+        REQUIRE(b.history.size() == a.history.size());
+        bool same = true;
+        for (size_t i = 0; i < a.history.size(); i++) {
+            if (b.history.ts(i) != a.history.ts(i) || b.history.price(i) != a.history.price(i) ||
+                b.history.value(TokenHistory::Column::Bar15mV, i) !=
+                    a.history.value(TokenHistory::Column::Bar15mV, i)) {
+                same = false;
+            }
+        }
+        REQUIRE(same);
+
+        REQUIRE(b.stats.low_recent.value() == a.stats.low_recent.value());
+        REQUIRE(b.stats.low_prev.value() == a.stats.low_prev.value());
+        REQUIRE(b.stats.high_pullback.value() == a.stats.high_pullback.value());
+        REQUIRE(b.stats.high_24h.value() == a.stats.high_24h.value());
+        REQUIRE(b.stats.vol_recent.count == a.stats.vol_recent.count);
+        REQUIRE(near_rel(b.stats.vol_recent.sum, a.stats.vol_recent.sum, 1e-6));
+        REQUIRE(near_rel(b.stats.vwap_num.sum, a.stats.vwap_num.sum, 1e-6));
+        REQUIRE(b.compute_m1h() == a.compute_m1h());
+    }
+
+    // Restored tokens keep sliding like the originals
+    auto copy = std::make_shared<TokenState>(*tokens[0]);
+    MarketData next = copy->latest;
+    next.price *= 0.5;
+    next.ts_ms += 60000;
+    copy->update(next);
+    snap->tokens[0]->update(next);
+    REQUIRE(snap->tokens[0]->stats.low_recent.value() == copy->stats.low_recent.value());
+    REQUIRE(near_rel(snap->tokens[0]->stats.price_60.sum, copy->stats.price_60.sum, 1e-6));
+
+    ThrottleManager restored;
+    restored.import_state(snap->throttles);
+    REQUIRE_FALSE(restored.check_token_cooldown("MintAAAA", "actionable", 6));
+    REQUIRE(restored.is_duplicate("MintAAAA", "abc", 6));
+    REQUIRE_FALSE(restored.check_reentry_guard("MintBBBB", 12));
+    REQUIRE_FALSE(restored.check_global_limit(1));
+
+    std::remove(path.c_str());
+}
+
+TEST_CASE("Missing or corrupt snapshots are ignored", "[snapshot]") {
+    std::string path = temp_path("analytics_snapshot_corrupt");
+    SnapshotStore store(path);
+    REQUIRE_FALSE(store.load());
+
+    REQUIRE(store.save(1, {}, {make_token("MintAAAA", 30, 4)}, ThrottleManager::State{}));
+    REQUIRE(store.load());
+
+    // Flip one payload byte
+    {
+        std::fstream f(path, std::ios::in | std::ios::out | std::ios::binary);
+        f.seekp(100);
+        char c = 0;
+        f.read(&c, 1);
+        f.seekp(100);
+        c = static_cast<char>(c ^ 0x5a);
+        f.write(&c, 1);
+    }
+    REQUIRE_FALSE(store.load());
+
+    // Truncated
+    REQUIRE(store.save(1, {}, {make_token("MintAAAA", 30, 4)}, ThrottleManager::State{}));
+    REQUIRE(truncate(path.c_str(), 200) == 0);
+    REQUIRE_FALSE(store.load());
+
+    std::remove(path.c_str());
+}
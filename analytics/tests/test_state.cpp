@@ -0,0 +1,120 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../src/state.hpp"
+#include "test_helpers.hpp"
+#include <atomic>
+#include <thread>
+
+TEST_CASE("MarketData parses per-mint and per-pool updates", "[state]") {
+    SECTION("Per-mint update") {
+        nlohmann::json j = {
+            {"mint", "MintA"}, {"symbol", "AAA"}, {"price", 2.0}, {"liq_usd", 50000.0},
+            {"pools", 3}, {"xdex_spread_pct", 0.4}, {"pool", "PoolB"},
+            {"route", {{"ok", true}, {"hops", 2}, {"dev_pct", 0.3}}},
+            {"bars", {{"5m", {{"c", 2.0}, {"v_usd", 100.0}}}}}
+        };
+        auto md = MarketData::from_json(j);
+        REQUIRE(md.mint_base == "MintA");
+        REQUIRE(md.symbol == "AAA");
+        REQUIRE(md.pool == "PoolB");
+        REQUIRE(md.pool_count == 3);
+        REQUIRE(near(md.xdex_spread_pct, 0.4));
+        REQUIRE(md.route.ok);
+        REQUIRE(md.route.hops == 2);
+        REQUIRE(near(md.bar_5m.v_usd, 100.0));
+        REQUIRE(near(md.bar_15m.c, 2.0));
+    }
+
+    SECTION("Per-pool update defaults to a single pool") {
+        nlohmann::json j = {{"mint_base", "MintB"}, {"pool", "PoolX"}, {"price", 1.0}};
+        auto md = MarketData::from_json(j);
+        REQUIRE(md.mint_base == "MintB");
+        REQUIRE(md.pool_count == 1);
+        REQUIRE(!md.route.ok);
+        REQUIRE(md.dq == "ok");
+    }
+}
+
+TEST_CASE("StateManager keys tokens by mint", "[state]") {
+    StateManager state;
+
+    auto a = MarketData::from_json({{"mint", "MintA"}, {"symbol", "DUP"}, {"price", 1.0}});
+    auto b = MarketData::from_json({{"mint", "MintB"}, {"symbol", "DUP"}, {"price", 5.0}});
+    state.update_token(a.mint_base, a);
+    state.update_token(b.mint_base, b);
+
+    REQUIRE(state.get_all_symbols().size() == 2);
+    REQUIRE(near(state.get_token("MintA")->latest.price, 1.0));
+    REQUIRE(state.get_token("MintB")->symbol == "DUP");
+
+    auto unnamed = MarketData::from_json({{"mint", "UnnamedMint123"}, {"price", 1.0}});
+    state.update_token(unnamed.mint_base, unnamed);
+    REQUIRE(state.get_token("UnnamedMint123")->symbol == "UnnamedM");
+}
+
+TEST_CASE("StateManager readers keep a consistent version", "[state]") {
+    StateManager state;
+    auto md = MarketData::from_json({{"mint", "MintA"}, {"symbol", "AAA"}, {"price", 1.0}});
+    state.update_token("MintA", md);
+
+    auto held = state.get_token("MintA");
+    md.price = 2.0;
+    state.update_token("MintA", md);
+
+    // The held version is untouched; new readers see the update
+    REQUIRE(near(held->latest.price, 1.0));
+    REQUIRE(held->history.size() == 1);
+    REQUIRE(near(state.get_token("MintA")->latest.price, 2.0));
+    REQUIRE(state.get_token("MintA")->history.size() == 2);
+
+    REQUIRE(state.get_token("Missing") == nullptr);
+    REQUIRE(state.snapshot().size() == 1);
+    REQUIRE(state.size() == 1);
+}
+
+TEST_CASE("StateManager takes concurrent writers and readers", "[state]") {
+    StateManager state;
+    const int kMints = 64;
+    const int kUpdates = 200;
+
+    std::vector<std::thread> threads;
+    for (int w = 0; w < 4; w++) {
+        threads.emplace_back([&state, w]() {
+            for (int u = 0; u < kUpdates; u++) {
+                for (int m = w; m < kMints; m += 4) {
+                    auto md = MarketData::from_json({{"mint", "M" + std::to_string(m)},
+                                                     {"price", 1.0 + u}});
+                    state.update_token(md.mint_base, md);
+                }
+            }
+        });
+    }
+    std::atomic<bool> consistent{true};
+    threads.emplace_back([&state, &consistent]() {
+        for (int r = 0; r < 200; r++) {
+            for (const auto& token : state.snapshot()) {
+                // Every update appends exactly one history entry
+                if (token->history.size() != static_cast<size_t>(token->latest.price)) {
+                    consistent = false;
+                }
+            }
+        }
+    });
+    for (auto& t : threads) t.join();
+
+    REQUIRE(consistent);
+    REQUIRE(state.size() == static_cast<size_t>(kMints));
+    REQUIRE(near(state.get_token("M7")->latest.price, kUpdates));
+}
+
+TEST_CASE("StateManager drops stale tokens", "[state]") {
+    StateManager state;
+    auto fresh = MarketData::from_json({{"mint", "Fresh"}, {"price", 1.0}});
+    auto stale = MarketData::from_json({{"mint", "Stale"}, {"price", 1.0}});
+    stale.ts_ms -= 48LL * 3600 * 1000;
+    state.update_token("Fresh", fresh);
+    state.update_token("Stale", stale);
+
+    auto removed = state.cleanup_stale(24);
+    REQUIRE(removed == std::vector<std::string>{"Stale"});
+    REQUIRE(state.get_all_symbols() == std::vector<std::string>{"Fresh"});
+}
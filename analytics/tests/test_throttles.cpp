@@ -27,4 +27,52 @@ TEST_CASE("Throttle manager", "[throttles]") {
         REQUIRE(mgr.is_duplicate("SOL", "hash456", 6));
         REQUIRE_FALSE(mgr.is_duplicate("SOL", "hash789", 6));
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Throttle indexes match whole symbols and expire old records", "[throttles]") {
+    int64_t now_ms = 1700000000000;
+    ThrottleManager mgr([&now_ms]() { return now_ms; });
+    
+    mgr.record_alert("SOLX", "actionable", "hash1");
+    REQUIRE(mgr.is_duplicate("SOLX", "hash1", 6));
+    REQUIRE_FALSE(mgr.is_duplicate("SOL", "hash1", 6));
+    REQUIRE(mgr.check_token_cooldown("SOL", "actionable", 6));
+    
+    // Any band's alert makes the same reasons a duplicate
+    mgr.record_alert("SOL", "heads_up", "hash2");
+    REQUIRE(mgr.is_duplicate("SOL", "hash2", 6));
+    REQUIRE(mgr.check_token_cooldown("SOL", "actionable", 6));
+    REQUIRE_FALSE(mgr.check_token_cooldown("SOL", "heads_up", 6));
+    mgr.record_stop("SOL");
+    
+    now_ms += 7 * 3600 * 1000;
+    REQUIRE_FALSE(mgr.is_duplicate("SOL", "hash2", 6));
+    REQUIRE(mgr.check_token_cooldown("SOL", "heads_up", 6));
+    REQUIRE_FALSE(mgr.check_reentry_guard("SOL", 12));
+    
+    // A fresh alert outlives the expiry of the one it replaced
+    mgr.record_alert("SOLX", "actionable", "hash1");
+    auto state = mgr.export_state();
+    REQUIRE(state.alerts.size() == 2);
+    REQUIRE(state.stop_times.size() == 1);
+    
+    now_ms += 6 * 3600 * 1000;
+    mgr.cleanup_old_records(12);
+    state = mgr.export_state();
+    REQUIRE(state.alerts.size() == 1);
+    REQUIRE(state.alerts[0].symbol == "SOLX");
+    REQUIRE(state.stop_times.empty());
+    REQUIRE(mgr.is_duplicate("SOLX", "hash1", 12));
+    REQUIRE(mgr.check_reentry_guard("SOL", 12));
+    
+    // Records come back from a snapshot indexed the same way
+    ThrottleManager restored([&now_ms]() { return now_ms; });
+    restored.import_state(state);
+    REQUIRE(restored.is_duplicate("SOLX", "hash1", 12));
+    REQUIRE_FALSE(restored.check_token_cooldown("SOLX", "actionable", 12));
+    REQUIRE_FALSE(restored.is_duplicate("SOL", "hash1", 12));
+    
+    now_ms += 24 * 3600 * 1000;
+    restored.cleanup_old_records(12);
+    REQUIRE(restored.export_state().alerts.empty());
+}
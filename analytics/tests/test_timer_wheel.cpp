@@ -0,0 +1,65 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../src/timer_wheel.hpp"
+#include <algorithm>
+#include <random>
+#include <vector>
+
+TEST_CASE("Timer wheel fires exactly what is due", "[timer_wheel]") {
+    TimerWheel<int> wheel(1000);
+    std::vector<int> fired;
+    auto collect = [&fired](int id) { fired.push_back(id); };
+
+    wheel.schedule(5000, 1);
+    wheel.schedule(5999, 2);
+    wheel.schedule(6000, 3);
+    wheel.advance(4999, collect);
+    REQUIRE(fired.empty());
+    wheel.advance(5000, collect);
+    std::sort(fired.begin(), fired.end());
+    REQUIRE(fired == std::vector<int>{1, 2});
+
+    // Behind the cursor fires on the next advance
+    wheel.schedule(1000, 4);
+    wheel.advance(5000, collect);
+    REQUIRE(fired.size() == 3);
+    REQUIRE(fired.back() == 4);
+    REQUIRE(wheel.size() == 1);
+}
+
+TEST_CASE("Timer wheel matches a sorted reference across all levels", "[timer_wheel]") {
+    std::mt19937_64 rng(3);
+    // Spans every level and past the top wheel's reach
+    std::uniform_int_distribution<int64_t> delay(0, int64_t(1) << 27);
+    std::uniform_int_distribution<int64_t> step(0, int64_t(1) << 21);
+
+    TimerWheel<size_t> wheel(1);
+    std::vector<int64_t> at;
+    std::vector<bool> done;
+    int64_t now = int64_t(1) << 40;
+    size_t wrong = 0;
+
+    for (int round = 0; round < 400; round++) {
+        for (int k = 0; k < 20; k++) {
+            int64_t t = now + delay(rng) - (k == 0 ? 1000 : 0);
+            wheel.schedule(t, at.size());
+            at.push_back(t);
+            done.push_back(false);
+        }
+        now += step(rng);
+        wheel.advance(now, [&](size_t id) {
+            if (done[id] || at[id] > now) wrong++;
+            done[id] = true;
+        });
+        for (size_t id = 0; id < at.size(); id++) {
+            if (!done[id] && at[id] <= now) wrong++;
+        }
+        if (wrong) break;
+    }
+    REQUIRE(wrong == 0);
+
+    size_t pending = std::count(done.begin(), done.end(), false);
+    REQUIRE(wheel.size() == pending);
+    wheel.advance(now + (int64_t(1) << 28), [&](size_t id) { done[id] = true; });
+    REQUIRE(wheel.empty());
+    REQUIRE(std::count(done.begin(), done.end(), false) == 0);
+}
@@ -0,0 +1,86 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../src/state.hpp"
+#include "../src/token_history.hpp"
+#include "test_helpers.hpp"
+#include <cmath>
+
+TEST_CASE("TokenHistory keeps the newest entries in order", "[token_history]") {
+    TokenHistory h(4);
+    REQUIRE(h.empty());
+
+    for (int i = 1; i <= 6; i++) {
+        h.push(market_sample(i * 1000, static_cast<double>(i), i * 10.0));
+    }
+
+    REQUIRE(h.size() == 4);
+    REQUIRE(h.ts(0) == 3000);
+    REQUIRE(h.ts(3) == 6000);
+    REQUIRE(near(h.price(0), 3.0));
+    REQUIRE(near(h.price(3), 6.0));
+    REQUIRE(near(h.vol_5m(1), 40.0));
+    REQUIRE(near(h.value(TokenHistory::Column::Liq, 2), 100000.0));
+    REQUIRE(near(h.value(TokenHistory::Column::Bar15mV, 3), 180.0));
+
+    h.clear();
+    REQUIRE(h.empty());
+}
+
+TEST_CASE("TokenHistory range aggregates span the wrap point", "[token_history]") {
+    TokenHistory h(5);
+    double prices[] = {5, 1, 7, 3, 9, 2, 8};
+    for (int i = 0; i < 7; i++) {
+        h.push(market_sample(i * 1000, prices[i], prices[i]));
+    }
+    // Holds 7, 3, 9, 2, 8 with the ring wrapped after 9
+
+    REQUIRE(near(h.min_price(0, 5), 2.0));
+    REQUIRE(near(h.max_price(0, 5), 9.0));
+    REQUIRE(near(h.max_price(3, 5), 8.0));
+    REQUIRE(near(h.sum(TokenHistory::Column::Bar5mV, 1, 4), 14.0));
+    REQUIRE(near(h.sum(TokenHistory::Column::Bar5mV, 2, 2), 0.0));
+    REQUIRE(std::isinf(h.min_price(3, 3)));
+}
+
+TEST_CASE("TokenHistory looks entries up by timestamp", "[token_history]") {
+    TokenHistory h(10);
+    for (int i = 0; i < 8; i++) {
+        h.push(market_sample(10000 + i * 60000, 1.0 + i));
+    }
+
+    REQUIRE(!h.index_at_or_before(9999).has_value());
+    REQUIRE(*h.index_at_or_before(10000) == 0);
+    REQUIRE(*h.index_at_or_before(10000 + 150000) == 2);
+    REQUIRE(*h.index_at_or_before(1LL << 40) == 7);
+
+    REQUIRE(h.index_at_or_after(0) == 0);
+    REQUIRE(h.index_at_or_after(10000 + 150000) == 3);
+    REQUIRE(h.index_at_or_after(1LL << 40) == 8);
+}
+
+TEST_CASE("TokenState momentum uses time, not entry counts", "[token_history]") {
+    TokenState state;
+    const int64_t minute = 60000;
+
+    // Updates every 5 minutes: 60 entries back would be 5 hours ago
+    for (int i = 0; i <= 24; i++) {
+        state.update(market_sample(i * 5 * minute, 1.0 + i * 0.01));
+    }
+    // Latest is 2h in at 1.24; 1h earlier is 1.12
+    REQUIRE(near(state.compute_m1h(), (1.24 - 1.12) / 1.12 * 100.0));
+    // Less than a day of history falls back to the oldest entry
+    REQUIRE(near(state.compute_m24h(), 24.0));
+
+    TokenState young;
+    young.update(market_sample(0, 1.0));
+    young.update(market_sample(10 * minute, 2.0));
+    REQUIRE(near(young.compute_m1h(), 0.0));
+    REQUIRE(near(young.compute_m24h(), 100.0));
+}
+
+TEST_CASE("TokenHistory preallocates a compact day of history", "[token_history]") {
+    TokenHistory h;
+    REQUIRE(h.capacity() == TokenHistory::kDefaultCapacity);
+    // Well below 1440 MarketData copies even before their heap-allocated strings
+    REQUIRE(h.memory_bytes() * 4 < TokenHistory::kDefaultCapacity * sizeof(MarketData));
+    REQUIRE(h.memory_bytes() < 128 * 1024);
+}
@@ -0,0 +1,102 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../src/warm_start.hpp"
+#include "test_helpers.hpp"
+#include <algorithm>
+#include <map>
+
+static PoolStatRow stat(uint32_t pool, int64_t ts_ms, double price, double liq,
+                        double spread = 0.5, double impact = 0.5) {
+    PoolStatRow row{};
+    row.pool = pool;
+    row.ts_ms = ts_ms;
+    row.price = price;
+    row.liq_usd = liq;
+    row.vol24h_usd = liq / 10.0;
+    row.spread_pct = spread;
+    row.impact_1pct_pct = impact;
+    row.route_ok = true;
+    row.route_hops = 1;
+    return row;
+}
+
+TEST_CASE("Warm start consolidates pools per mint like the ingestor", "[warm_start]") {
+    std::vector<PoolInfo> pools = {
+        {10, "SolUsdc", kSolMint, kUsdcMint},
+        {11, "XSol", "MintX", kSolMint},
+        {12, "XUsdc", "MintX", kUsdcMint},
+        {13, "YOther", "MintY", "UnknownQuote"},
+    };
+    const int64_t t0 = 1700000000000LL;
+    const int64_t t1 = t0 + 300000;
+    std::vector<PoolStatRow> rows = {
+        // Out of order on purpose
+        stat(2, t1, 2.2, 1000.0),
+        stat(0, t0, 100.0, 1e6),
+        stat(0, t1, 110.0, 1e6),
+        stat(1, t0, 0.02, 3000.0, 0.2, 0.1),   // 2.0 USD, cheapest pool
+        stat(2, t0, 2.1, 1000.0),
+        stat(1, t1, 0.02, 3000.0, 0.2, 0.1),   // 2.2 USD
+        stat(3, t0, 5.0, 500.0),               // unpriced quote
+    };
+
+    auto tokens = build_histories(pools, rows, 3);
+    std::map<std::string, std::shared_ptr<TokenState>> by_mint;
+    for (auto& t : tokens) by_mint[t->mint] = t;
+
+    REQUIRE(by_mint.size() == 2);   // MintY never gets a USD price
+    REQUIRE(by_mint.count(kSolMint));
+    REQUIRE(by_mint[kSolMint]->history.size() == 2);
+    REQUIRE(by_mint[kSolMint]->history.price(1) == 110.0);
+
+    const TokenState& x = *by_mint["MintX"];
+    REQUIRE(x.history.size() == 2);
+    REQUIRE(x.history.ts(0) == t0);
+    // Liquidity-weighted USD price: (2.0 * 3000 + 2.1 * 1000) / 4000
+    REQUIRE(near_rel(x.history.price(0), (2.0 * 3000 + 2.1 * 1000) / 4000.0));
+    REQUIRE(near_rel(x.history.price(1), 2.2));
+    REQUIRE(x.latest.pool == "XSol");
+    REQUIRE(x.latest.pool_count == 2);
+    REQUIRE(near_rel(x.latest.liq_usd, 4000.0));
+    REQUIRE(near_rel(x.latest.spread_pct, 0.2));
+    REQUIRE(near_rel(x.latest.bar_5m.v_usd, 400.0 / 288.0));
+    REQUIRE(near_rel(x.latest.xdex_spread_pct, 0.0));
+    REQUIRE(x.latest.dq == "ok");
+    REQUIRE(x.symbol == "MintX");
+}
+
+TEST_CASE("Warm start gives the same histories on any thread count", "[warm_start]") {
+    std::vector<PoolInfo> pools;
+    std::vector<PoolStatRow> rows;
+    for (uint32_t p = 0; p < 40; p++) {
+        pools.push_back({p, "Pool" + std::to_string(p), "Mint" + std::to_string(p % 13), kUsdcMint});
+        for (int t = 0; t < 50; t++) {
+            rows.push_back(stat(p, 1700000000000LL + t * 300000LL, 1.0 + p * 0.01 + t * 0.001, 1000.0 + p));
+        }
+    }
+
+    auto one = build_histories(pools, rows, 1);
+    auto many = build_histories(pools, rows, 8);
+    REQUIRE(one.size() == 13);
+    REQUIRE(many.size() == 13);
+
+    auto by_mint = [](const std::vector<std::shared_ptr<TokenState>>& tokens) {
+        std::map<std::string, std::shared_ptr<TokenState>> m;
+        for (const auto& t : tokens) m[t->mint] = t;
+        return m;
+    };
+    auto a = by_mint(one);
+    auto b = by_mint(many);
+    bool same = true;
+    for (const auto& [mint, token] : a) {
+        const auto& other = b[mint];
+        if (!other || other->history.size() != token->history.size()) {
+            same = false;
+            continue;
+        }
+        for (size_t i = 0; i < token->history.size(); i++) {
+            if (other->history.price(i) != token->history.price(i)) same = false;
+        }
+        if (other->stats.high_24h.value() != token->stats.high_24h.value()) same = false;
+    }
+    REQUIRE(same);
+}
@@ -0,0 +1,315 @@
+// Micro and macro benchmarks for the ingest hot paths.
+//
+//   ./ingestor_bench                      console table
+//   ./ingestor_bench --json               JSON on stdout
+//   ./ingestor_bench --json=results.json  console table, JSON written to a file
+//
+// Any --benchmark_* flag (filter, repetitions, ...) is passed through.
+#include "bar_synth.hpp"
+#include "impact_model.hpp"
+#include "market_update.hpp"
+#include "metrics.hpp"
+#include "normalize.hpp"
+#include "route_graph.hpp"
+#include "rpc_clients/orca_client.hpp"
+#include "rpc_clients/raydium_client.hpp"
+#include "util.hpp"
+#include <benchmark/benchmark.h>
+#include <spdlog/spdlog.h>
+#include <map>
+#include <memory>
+#include <random>
+#include <string>
+#include <vector>
+
+namespace {
+
+constexpr int kBatchPools = 50000;
+constexpr int64_t kBarIntervalMs = 300 * 1000;
+
+std::string fake_address(std::mt19937_64& rng) {
+    static const char alphabet[] = "123456789ABCDEFGHJKLMNPQRSTUVWXYZabcdefghijkmnopqrstuvwxyz";
+    std::string addr(44, '1');
+    for (auto& c : addr) c = alphabet[rng() % (sizeof(alphabet) - 1)];
+    return addr;
+}
+
+// Canned /pools/info/ids and /v2/solana/pools bodies, shaped like the live APIs
+std::string canned_raydium_body(int pools, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> price(0.0001, 50.0);
+    std::uniform_real_distribution<double> tvl(25000.0, 5e7);
+
+    nlohmann::json data = nlohmann::json::array();
+    for (int i = 0; i < pools; i++) {
+        double p = price(rng);
+        double liq = tvl(rng);
+        data.push_back({
+            {"id", fake_address(rng)},
+            {"mintA", {{"address", fake_address(rng)}, {"symbol", "TKN"}, {"decimals", 9}}},
+            {"mintB", {{"address", "EPjFWdd5AufqSSqeM2qN1xzybapC8G4wEGGkZwyTDt1v"}, {"symbol", "USDC"}, {"decimals", 6}}},
+            {"price", p},
+            {"tvl", liq},
+            {"day", {{"volume", liq * 0.4}, {"volumeFee", liq * 0.001}}},
+            {"mintAmountA", liq / 2.0 / p},
+            {"mintAmountB", liq / 2.0}
+        });
+    }
+    return nlohmann::json{{"success", true}, {"data", data}}.dump();
+}
+
+std::string canned_orca_body(int pools, uint64_t seed) {
+    std::mt19937_64 rng(seed);
+    std::uniform_real_distribution<double> price(0.0001, 50.0);
+    std::uniform_real_distribution<double> tvl(25000.0, 5e7);
+
+    nlohmann::json data = nlohmann::json::array();
+    for (int i = 0; i < pools; i++) {
+        double p = price(rng);
+        double liq = tvl(rng);
+        data.push_back({
+            {"address", fake_address(rng)},
+            {"tokenA", {{"address", fake_address(rng)}, {"symbol", "TKN"}}},
+            {"tokenB", {{"address", "So11111111111111111111111111111111111111112"}, {"symbol", "SOL"}}},
+            {"price", p},
+            {"tvlUsdc", liq},
+            {"stats", {{"24h", {{"volume", liq * 0.3}}}}},
+            {"tokenBalanceA", liq / 2.0 / p},
+            {"tokenBalanceB", liq / 2.0}
+        });
+    }
+    return nlohmann::json{{"data", data}, {"meta", {{"next", nullptr}}}}.dump();
+}
+
+std::vector<nlohmann::json> raw_pool_batch(int pools) {
+    auto parsed = RaydiumClient::parse_pools(
+        nlohmann::json::parse(canned_raydium_body(pools, 42))["data"]);
+
+    std::vector<nlohmann::json> raw;
+    raw.reserve(parsed.size());
+    for (const auto& pool : parsed) raw.push_back(MarketUpdate::raw_pool(pool));
+    return raw;
+}
+
+uint64_t allocations() {
+    return alloc_counter::allocations_total.load(std::memory_order_relaxed);
+}
+
+} // namespace
+
+// Ticks per bar: 5 at the default 60s cadence, up to 300 at 1s
+static void BM_BarSynth_AddTick(benchmark::State& state) {
+    const int ticks_per_bar = static_cast<int>(state.range(0));
+    const int64_t step_ms = kBarIntervalMs / ticks_per_bar;
+
+    for (auto _ : state) {
+        BarSynthesizer synth(300);
+        int64_t ts = 1700000000000LL;
+        for (int i = 0; i < ticks_per_bar; i++) {
+            synth.add_tick(PriceTick{1.0 + i * 1e-4, 10.0, ts});
+            ts += step_ms;
+        }
+        benchmark::DoNotOptimize(synth);
+    }
+    state.SetItemsProcessed(state.iterations() * ticks_per_bar);
+}
+BENCHMARK(BM_BarSynth_AddTick)->Arg(5)->Arg(60)->Arg(300);
+
+// Two full bars of ticks in the past, so both complete on the call
+static void BM_BarSynth_GetCompletedBars(benchmark::State& state) {
+    const int ticks_per_bar = static_cast<int>(state.range(0));
+    const int64_t step_ms = kBarIntervalMs / ticks_per_bar;
+
+    BarSynthesizer::State seeded{0, {}};
+    int64_t ts = 1700000000000LL / kBarIntervalMs * kBarIntervalMs;
+    seeded.current_bar_start_ms = ts;
+    for (int i = 0; i < ticks_per_bar * 2; i++) {
+        seeded.ticks.push_back(PriceTick{1.0 + i * 1e-4, 10.0, ts});
+        ts += step_ms;
+    }
+
+    BarSynthesizer synth(300);
+    for (auto _ : state) {
+        state.PauseTiming();
+        synth.restore_state(seeded);
+        state.ResumeTiming();
+
+        auto bars = synth.get_completed_bars();
+        benchmark::DoNotOptimize(bars);
+    }
+    state.SetItemsProcessed(state.iterations() * ticks_per_bar * 2);
+}
+BENCHMARK(BM_BarSynth_GetCompletedBars)->Arg(5)->Arg(60)->Arg(300);
+
+static void BM_Normalize_Batch(benchmark::State& state) {
+    static const auto batch = raw_pool_batch(kBatchPools);
+    const std::string dex = "raydium";
+
+    for (auto _ : state) {
+        for (const auto& raw : batch) {
+            auto pool = Normalizer::normalize_pool(raw, dex);
+            benchmark::DoNotOptimize(pool);
+        }
+    }
+    state.SetItemsProcessed(state.iterations() * static_cast<int64_t>(batch.size()));
+}
+BENCHMARK(BM_Normalize_Batch)->Unit(benchmark::kMillisecond);
+
+static void BM_MarketUpdate_Encode(benchmark::State& state) {
+    static const auto batch = raw_pool_batch(1000);
+    std::vector<NormalizedPool> pools;
+    for (const auto& raw : batch) pools.push_back(Normalizer::normalize_pool(raw, "raydium"));
+
+    const RouteInfo route{true, 2, 0.3};
+    size_t bytes = 0;
+    size_t i = 0;
+    for (auto _ : state) {
+        auto payload = MarketUpdate::build(pools[i++ % pools.size()], route).dump();
+        bytes += payload.size();
+        benchmark::DoNotOptimize(payload);
+    }
+    state.SetItemsProcessed(state.iterations());
+    state.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+BENCHMARK(BM_MarketUpdate_Encode);
+
+static void BM_Impact_1pct(benchmark::State& state) {
+    double reserve_base = 1.5e6;
+    double reserve_quote = 2.0e6;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(reserve_base);
+        benchmark::DoNotOptimize(
+            ImpactModel::calculate_1pct_impact(reserve_base, reserve_quote, reserve_quote * 2.0));
+    }
+}
+BENCHMARK(BM_Impact_1pct);
+
+static void BM_Impact_Spread(benchmark::State& state) {
+    double reserve_base = 1.5e6;
+    double reserve_quote = 2.0e6;
+    for (auto _ : state) {
+        benchmark::DoNotOptimize(reserve_base);
+        benchmark::DoNotOptimize(ImpactModel::estimate_spread_pct(reserve_base, reserve_quote));
+    }
+}
+BENCHMARK(BM_Impact_Spread);
+
+// Mint graph with a quarter of pools quoted directly in USDC/SOL, the rest token/token
+static void BM_RouteGraph_Recompute(benchmark::State& state) {
+    const int pools = static_cast<int>(state.range(0));
+    std::mt19937_64 rng(7);
+    std::vector<std::string> mints;
+    for (int i = 0; i < pools / 2; i++) mints.push_back(fake_address(rng));
+
+    RouteGraph graph(3, 1000.0, 0.0);
+    for (int i = 0; i < pools; i++) {
+        const std::string& base = mints[rng() % mints.size()];
+        std::string quote = (i % 4 == 0) ? (i % 8 == 0 ? kUsdcMint : kSolMint)
+                                         : mints[rng() % mints.size()];
+        graph.upsert_pool(fake_address(rng), base, quote, 1.0, 25000.0 + (rng() % 1000000), 0);
+    }
+
+    for (auto _ : state) {
+        graph.recompute();
+        benchmark::DoNotOptimize(graph.best_route(mints[0]));
+    }
+    state.SetItemsProcessed(state.iterations() * pools);
+    state.counters["mints"] = static_cast<double>(graph.mint_count());
+}
+BENCHMARK(BM_RouteGraph_Recompute)->Arg(5000)->Arg(50000)->Unit(benchmark::kMillisecond);
+
+// One ingest tick minus the network and storage round-trips: decode canned provider
+// bodies, route the pool graph, normalize, synthesize bars and encode the market
+// update for every pool.
+static void BM_FullTick(benchmark::State& state) {
+    const int pools_per_dex = static_cast<int>(state.range(0));
+    const std::string raydium_body = canned_raydium_body(pools_per_dex, 1);
+    const std::string orca_body = canned_orca_body(pools_per_dex, 2);
+
+    std::map<std::string, std::unique_ptr<BarSynthesizer>> bar_5m;
+    std::map<std::string, std::unique_ptr<BarSynthesizer>> bar_15m;
+    RouteGraph routes(3, 1000.0, 10000.0);
+
+    int64_t pools_done = 0;
+    uint64_t allocs = 0;
+    size_t bytes = 0;
+    int64_t ts = 1700000000000LL;
+
+    auto process = [&](const std::vector<PoolData>& pools, const std::string& dex) {
+        for (const auto& pool_data : pools) {
+            auto normalized = Normalizer::normalize_pool(MarketUpdate::raw_pool(pool_data), dex);
+
+            RouteInfo route = routes.best_route(normalized.mint_base);
+
+            auto& synth_5m = bar_5m[normalized.address];
+            auto& synth_15m = bar_15m[normalized.address];
+            if (!synth_5m) {
+                synth_5m = std::make_unique<BarSynthesizer>(300);
+                synth_15m = std::make_unique<BarSynthesizer>(900);
+            }
+
+            PriceTick tick{normalized.price, normalized.vol24h_usd / 288.0, ts};
+            synth_5m->add_tick(tick);
+            synth_15m->add_tick(tick);
+            benchmark::DoNotOptimize(synth_5m->get_completed_bars());
+            benchmark::DoNotOptimize(synth_15m->get_completed_bars());
+
+            bytes += MarketUpdate::build(normalized, route).dump().size();
+        }
+        pools_done += static_cast<int64_t>(pools.size());
+    };
+
+    for (auto _ : state) {
+        uint64_t before = allocations();
+
+        auto raydium = RaydiumClient::parse_pools(nlohmann::json::parse(raydium_body)["data"]);
+        auto orca = OrcaClient::parse_pools(nlohmann::json::parse(orca_body)["data"]);
+        for (const auto* pools : {&raydium, &orca}) {
+            for (const auto& p : *pools) {
+                routes.upsert_pool(p.address, p.mint_base, p.mint_quote, p.price, p.liq_usd, ts);
+            }
+        }
+        routes.recompute();
+        process(raydium, "raydium");
+        process(orca, "orca");
+
+        allocs += allocations() - before;
+        ts += 60 * 1000;
+    }
+
+    state.counters["pools_per_sec"] =
+        benchmark::Counter(static_cast<double>(pools_done), benchmark::Counter::kIsRate);
+    state.counters["allocs_per_pool"] =
+        pools_done > 0 ? static_cast<double>(allocs) / static_cast<double>(pools_done) : 0.0;
+    state.SetBytesProcessed(static_cast<int64_t>(bytes));
+}
+BENCHMARK(BM_FullTick)->Arg(500)->Arg(5000)->Unit(benchmark::kMillisecond);
+
+int main(int argc, char** argv) {
+    spdlog::set_level(spdlog::level::warn);
+
+    // Translate --json / --json=<file> into the library's own flags
+    std::vector<std::string> storage;
+    storage.reserve(static_cast<size_t>(argc) * 2);
+    for (int i = 0; i < argc; i++) {
+        std::string arg = argv[i];
+        if (arg == "--json") {
+            storage.push_back("--benchmark_format=json");
+        } else if (arg.rfind("--json=", 0) == 0) {
+            storage.push_back("--benchmark_out=" + arg.substr(7));
+            storage.push_back("--benchmark_out_format=json");
+        } else {
+            storage.push_back(arg);
+        }
+    }
+
+    std::vector<char*> args;
+    for (auto& s : storage) args.push_back(s.data());
+    int bench_argc = static_cast<int>(args.size());
+
+    benchmark::Initialize(&bench_argc, args.data());
+    if (benchmark::ReportUnrecognizedArguments(bench_argc, args.data())) return 1;
+    benchmark::RunSpecifiedBenchmarks();
+    benchmark::Shutdown();
+    return 0;
+}
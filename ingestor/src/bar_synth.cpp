@@ -68,6 +68,15 @@ OHLCVBar BarSynthesizer::get_current_bar() const {
     return synthesize_bar(current_bar_start_ms_, ticks_);
 }
 
+BarSynthesizer::State BarSynthesizer::export_state() const {
+    return State{current_bar_start_ms_, ticks_};
+}
+
+void BarSynthesizer::restore_state(const State& state) {
+    current_bar_start_ms_ = state.current_bar_start_ms;
+    ticks_ = state.ticks;
+}
+
 OHLCVBar BarSynthesizer::synthesize_bar(int64_t start_ms, 
                                          const std::vector<PriceTick>& bar_ticks) const {
     OHLCVBar bar;
@@ -21,12 +21,22 @@ struct OHLCVBar {
 
 class BarSynthesizer {
 public:
+    // In-flight accumulator state, used for checkpoint/restore across restarts
+    struct State {
+        int64_t current_bar_start_ms;
+        std::vector<PriceTick> ticks;
+    };
+    
     BarSynthesizer(int interval_seconds);
     
     void add_tick(const PriceTick& tick);
     std::vector<OHLCVBar> get_completed_bars();
     OHLCVBar get_current_bar() const;
     
+    int interval_seconds() const { return interval_seconds_; }
+    State export_state() const;
+    void restore_state(const State& state);
+    
 private:
     int interval_seconds_;
     std::vector<PriceTick> ticks_;
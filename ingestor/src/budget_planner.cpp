@@ -0,0 +1,148 @@
+#include "budget_planner.hpp"
+#include <algorithm>
+#include <cmath>
+
+namespace {
+
+// Value model weights; a dead $30k pool is worth ~1, a moving $10M pool ~3,
+// and a held or near-alert mint ~5
+constexpr double kBaseValue = 0.25;
+constexpr double kLiqWeight = 1.0 / 7.0;   // per decade of liquidity, 1.0 at $10M
+constexpr double kMoveWeight = 0.5;        // per 1% average move per refresh
+constexpr double kMoveCap = 1.0;
+constexpr double kPriorityValue = 2.0;
+constexpr double kMoveEwmaAlpha = 0.3;
+
+constexpr double kDeepLiqUsd = 1e6;
+constexpr double kMidLiqUsd = 1e5;
+
+const char* const kTiers[] = {"priority", "deep", "mid", "shallow", "new"};
+
+} // namespace
+
+BudgetPlanner::BudgetPlanner(int requests_per_min, int tick_seconds)
+    : requests_per_min_(requests_per_min)
+    , tick_seconds_(std::max(1, tick_seconds))
+    , credit_(0.0)
+{}
+
+void BudgetPlanner::begin_tick() {
+    if (unlimited()) return;
+    credit_ = std::min(credit_ + per_tick(), 2.0 * per_tick());
+}
+
+int BudgetPlanner::available() const {
+    if (unlimited()) return 1 << 30;
+    return std::max(0, static_cast<int>(std::floor(credit_)));
+}
+
+void BudgetPlanner::observe(const PoolData& pool, int64_t now_ms) {
+    auto it = pools_.find(pool.address);
+    if (it == pools_.end()) {
+        pools_.emplace(pool.address, PoolStats{pool.mint_base, pool.liq_usd, pool.price, 0.0, now_ms});
+        return;
+    }
+
+    PoolStats& stats = it->second;
+    if (stats.last_price > 0 && pool.price > 0) {
+        double move = std::abs(pool.price - stats.last_price) / stats.last_price * 100.0;
+        stats.move_pct = kMoveEwmaAlpha * move + (1.0 - kMoveEwmaAlpha) * stats.move_pct;
+    }
+    stats.mint = pool.mint_base;
+    stats.liq_usd = pool.liq_usd;
+    stats.last_price = pool.price;
+    stats.refreshed_ms = now_ms;
+}
+
+double BudgetPlanner::value(const std::string& address) const {
+    auto it = pools_.find(address);
+    if (it == pools_.end()) return 0.0;
+
+    const PoolStats& stats = it->second;
+    double v = kBaseValue;
+    v += kLiqWeight * std::log10(std::max(1.0, stats.liq_usd));
+    v += std::min(kMoveCap, kMoveWeight * stats.move_pct);
+    if (priority_.count(stats.mint)) v += kPriorityValue;
+    return v;
+}
+
+const char* BudgetPlanner::tier_of(const std::string& address) const {
+    auto it = pools_.find(address);
+    if (it == pools_.end()) return "new";
+    if (priority_.count(it->second.mint)) return "priority";
+    if (it->second.liq_usd >= kDeepLiqUsd) return "deep";
+    if (it->second.liq_usd >= kMidLiqUsd) return "mid";
+    return "shallow";
+}
+
+std::vector<std::string> BudgetPlanner::plan(const std::vector<std::string>& tracked,
+                                             size_t max_pools, int64_t now_ms) {
+    struct Candidate {
+        const std::string* address;
+        double score;
+        double age_s;
+        const char* tier;
+    };
+
+    std::vector<Candidate> candidates;
+    candidates.reserve(tracked.size());
+    for (const auto& address : tracked) {
+        auto it = pools_.find(address);
+        if (it == pools_.end()) {
+            candidates.push_back({&address, HUGE_VAL, 0.0, "new"});
+            continue;
+        }
+        double age_s = std::max<int64_t>(0, now_ms - it->second.refreshed_ms) / 1000.0;
+        // One tick of age is added so equally fresh pools still rank by value
+        double score = value(address) * (age_s + tick_seconds_);
+        candidates.push_back({&address, score, age_s, tier_of(address)});
+    }
+
+    size_t take = std::min(max_pools, candidates.size());
+    auto by_score = [](const Candidate& a, const Candidate& b) {
+        if (a.score != b.score) return a.score > b.score;
+        return *a.address < *b.address;
+    };
+    if (take < candidates.size()) {
+        std::partial_sort(candidates.begin(), candidates.begin() + take, candidates.end(), by_score);
+    } else {
+        std::sort(candidates.begin(), candidates.end(), by_score);
+    }
+
+    std::vector<std::string> planned;
+    planned.reserve(take);
+    for (size_t i = 0; i < take; i++) {
+        planned.push_back(*candidates[i].address);
+    }
+
+    report_.clear();
+    for (const char* tier : kTiers) {
+        report_.push_back(BudgetTierStats{tier, 0, 0, 0.0, 0.0});
+    }
+    auto tier_stats = [this](const char* tier) -> BudgetTierStats& {
+        for (auto& t : report_) {
+            if (t.tier == tier) return t;
+        }
+        return report_.back();
+    };
+    for (size_t i = 0; i < candidates.size(); i++) {
+        BudgetTierStats& t = tier_stats(candidates[i].tier);
+        t.pools++;
+        if (i < take) t.planned++;
+        t.max_age_s = std::max(t.max_age_s, candidates[i].age_s);
+        t.avg_age_s += candidates[i].age_s;
+    }
+    for (auto& t : report_) {
+        if (t.pools > 0) t.avg_age_s /= static_cast<double>(t.pools);
+    }
+
+    // Forget pools that are no longer tracked
+    if (pools_.size() > tracked.size()) {
+        std::unordered_set<std::string> live(tracked.begin(), tracked.end());
+        for (auto it = pools_.begin(); it != pools_.end();) {
+            it = live.count(it->first) ? std::next(it) : pools_.erase(it);
+        }
+    }
+
+    return planned;
+}
@@ -0,0 +1,60 @@
+#pragma once
+
+#include "metrics.hpp" // BudgetTierStats
+#include "rpc_clients/raydium_client.hpp" // PoolData
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+// Spends one provider's per-minute request budget on the tracked pools whose
+// refresh is worth the most. A pool's value grows with liquidity, recent price
+// movement and priority (held or close to alerting); its score is value times
+// data age, so every pool is eventually refreshed and deep, moving pools more
+// often. Unlimited (requests_per_min <= 0) plans every tracked pool each tick.
+class BudgetPlanner {
+public:
+    BudgetPlanner(int requests_per_min, int tick_seconds);
+
+    bool unlimited() const { return requests_per_min_ <= 0; }
+
+    // Adds this tick's allowance; unspent credit carries over for at most one tick
+    void begin_tick();
+    int available() const;
+    void spend(int requests) { credit_ -= requests; }
+
+    // Called with each refreshed pool
+    void observe(const PoolData& pool, int64_t now_ms);
+    void forget(const std::string& address) { pools_.erase(address); }
+
+    // Mints held in a portfolio or near an alert threshold
+    void set_priority_mints(std::unordered_set<std::string> mints) { priority_ = std::move(mints); }
+
+    // At most max_pools addresses, best score first; pools never refreshed come first.
+    // Also rebuilds the per-tier report.
+    std::vector<std::string> plan(const std::vector<std::string>& tracked, size_t max_pools,
+                                  int64_t now_ms);
+
+    double value(const std::string& address) const;
+    const std::vector<BudgetTierStats>& report() const { return report_; }
+
+private:
+    struct PoolStats {
+        std::string mint;
+        double liq_usd;
+        double last_price;
+        double move_pct;       // EWMA of |price change| per refresh
+        int64_t refreshed_ms;
+    };
+
+    int requests_per_min_;
+    int tick_seconds_;
+    double credit_;
+    std::unordered_map<std::string, PoolStats> pools_;
+    std::unordered_set<std::string> priority_;
+    std::vector<BudgetTierStats> report_;
+
+    double per_tick() const { return requests_per_min_ * tick_seconds_ / 60.0; }
+    const char* tier_of(const std::string& address) const;
+};
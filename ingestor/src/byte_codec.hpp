@@ -0,0 +1,72 @@
+#pragma once
+
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
+#include <string>
+
+// Little binary encoder/decoder shared by the checkpoint file and the latest
+// view. Fields are copied in host byte order; all supported targets are
+// little-endian.
+namespace byte_codec {
+
+class Writer {
+public:
+    Writer() = default;
+    explicit Writer(size_t reserve) { out_.reserve(reserve); }
+
+    template <typename T>
+    void put(T value) {
+        char buf[sizeof(T)];
+        std::memcpy(buf, &value, sizeof(T));
+        out_.append(buf, sizeof(T));
+    }
+
+    // Length-prefixed; strings longer than Len can count are cut
+    template <typename Len = uint32_t>
+    void put_string(const std::string& s) {
+        size_t n = std::min<size_t>(s.size(), std::numeric_limits<Len>::max());
+        put<Len>(static_cast<Len>(n));
+        out_.append(s, 0, n);
+    }
+
+    std::string& str() { return out_; }
+    std::string take() { return std::move(out_); }
+
+private:
+    std::string out_;
+};
+
+class Reader {
+public:
+    Reader(const char* data, size_t len) : data_(data), len_(len), pos_(0) {}
+    explicit Reader(const std::string& bytes) : Reader(bytes.data(), bytes.size()) {}
+
+    template <typename T>
+    bool get(T& value) {
+        if (len_ - pos_ < sizeof(T)) return false;
+        std::memcpy(&value, data_ + pos_, sizeof(T));
+        pos_ += sizeof(T);
+        return true;
+    }
+
+    template <typename Len = uint32_t>
+    bool get_string(std::string& s) {
+        Len n;
+        if (!get(n) || len_ - pos_ < n) return false;
+        s.assign(data_ + pos_, n);
+        pos_ += n;
+        return true;
+    }
+
+    size_t remaining() const { return len_ - pos_; }
+    bool at_end() const { return pos_ == len_; }
+
+private:
+    const char* data_;
+    size_t len_;
+    size_t pos_;
+};
+
+} // namespace byte_codec
@@ -0,0 +1,154 @@
+#include "checkpoint.hpp"
+#include "byte_codec.hpp"
+#include "util.hpp"
+#include <spdlog/spdlog.h>
+#include <cerrno>
+#include <cstdio>
+#include <cstring>
+#include <fstream>
+#include <iterator>
+#include <fcntl.h>
+#include <unistd.h>
+
+namespace {
+
+constexpr uint32_t kMagic = 0x4b435353; // "SSCK"
+constexpr uint32_t kVersion = 1;
+
+using byte_codec::Reader;
+using byte_codec::Writer;
+
+void put_state(Writer& w, const BarSynthesizer::State& state) {
+    w.put<int64_t>(state.current_bar_start_ms);
+    w.put<uint32_t>(static_cast<uint32_t>(state.ticks.size()));
+    for (const auto& tick : state.ticks) {
+        w.put<double>(tick.price);
+        w.put<double>(tick.volume_usd);
+        w.put<int64_t>(tick.timestamp_ms);
+    }
+}
+
+bool get_state(Reader& r, BarSynthesizer::State& state) {
+    uint32_t n;
+    if (!r.get(state.current_bar_start_ms) || !r.get(n)) return false;
+    // Each tick is 24 bytes; reject counts the buffer cannot hold
+    if (r.remaining() / 24 < n) return false;
+    state.ticks.resize(n);
+    for (auto& tick : state.ticks) {
+        if (!r.get(tick.price) || !r.get(tick.volume_usd) || !r.get(tick.timestamp_ms)) {
+            return false;
+        }
+    }
+    return true;
+}
+
+} // namespace
+
+std::string Checkpoint::encode(const IngestCheckpoint& ckpt) {
+    Writer w;
+    w.put<uint32_t>(kMagic);
+    w.put<uint32_t>(kVersion);
+    w.put<int64_t>(ckpt.written_ms);
+    w.put<int32_t>(ckpt.bar_interval_5m);
+    w.put<int32_t>(ckpt.bar_interval_15m);
+    w.put<uint32_t>(static_cast<uint32_t>(ckpt.pools.size()));
+
+    for (const auto& p : ckpt.pools) {
+        w.put<int64_t>(p.pool.pool_id);
+        w.put_string(p.pool.address);
+        w.put_string(p.pool.mint_base);
+        w.put_string(p.pool.mint_quote);
+        w.put_string(p.pool.dex);
+        put_state(w, p.bar_5m);
+        put_state(w, p.bar_15m);
+    }
+
+    uint64_t checksum = util::fnv1a_64_update(util::kFnv1aOffset, w.str().data(), w.str().size());
+    w.put<uint64_t>(checksum);
+    return std::move(w.str());
+}
+
+std::optional<IngestCheckpoint> Checkpoint::decode(const std::string& bytes) {
+    if (bytes.size() < sizeof(uint64_t)) return std::nullopt;
+
+    size_t payload_len = bytes.size() - sizeof(uint64_t);
+    uint64_t stored_checksum;
+    std::memcpy(&stored_checksum, bytes.data() + payload_len, sizeof(uint64_t));
+    if (util::fnv1a_64_update(util::kFnv1aOffset, bytes.data(), payload_len) != stored_checksum) {
+        spdlog::warn("Checkpoint checksum mismatch");
+        return std::nullopt;
+    }
+
+    Reader r(bytes.data(), payload_len);
+    uint32_t magic, version, count;
+    int32_t interval_5m, interval_15m;
+    IngestCheckpoint ckpt;
+
+    if (!r.get(magic) || magic != kMagic) return std::nullopt;
+    if (!r.get(version) || version != kVersion) {
+        spdlog::warn("Unsupported checkpoint version");
+        return std::nullopt;
+    }
+    if (!r.get(ckpt.written_ms) || !r.get(interval_5m) ||
+        !r.get(interval_15m) || !r.get(count)) {
+        return std::nullopt;
+    }
+    ckpt.bar_interval_5m = interval_5m;
+    ckpt.bar_interval_15m = interval_15m;
+
+    ckpt.pools.reserve(count);
+    for (uint32_t i = 0; i < count; i++) {
+        PoolCheckpoint p;
+        if (!r.get(p.pool.pool_id) ||
+            !r.get_string(p.pool.address) ||
+            !r.get_string(p.pool.mint_base) ||
+            !r.get_string(p.pool.mint_quote) ||
+            !r.get_string(p.pool.dex) ||
+            !get_state(r, p.bar_5m) ||
+            !get_state(r, p.bar_15m)) {
+            spdlog::warn("Checkpoint truncated at pool {}", i);
+            return std::nullopt;
+        }
+        ckpt.pools.push_back(std::move(p));
+    }
+
+    if (!r.at_end()) return std::nullopt;
+    return ckpt;
+}
+
+bool Checkpoint::write_file_atomic(const std::string& path, const std::string& bytes) {
+    std::string tmp_path = path + ".tmp";
+
+    int fd = ::open(tmp_path.c_str(), O_WRONLY | O_CREAT | O_TRUNC, 0644);
+    if (fd < 0) {
+        spdlog::error("Failed to open checkpoint {}: {}", tmp_path, std::strerror(errno));
+        return false;
+    }
+
+    size_t written = 0;
+    while (written < bytes.size()) {
+        ssize_t n = ::write(fd, bytes.data() + written, bytes.size() - written);
+        if (n < 0) {
+            if (errno == EINTR) continue;
+            spdlog::error("Failed to write checkpoint: {}", std::strerror(errno));
+            ::close(fd);
+            return false;
+        }
+        written += static_cast<size_t>(n);
+    }
+
+    bool ok = (::fsync(fd) == 0);
+    ::close(fd);
+
+    if (!ok || std::rename(tmp_path.c_str(), path.c_str()) != 0) {
+        spdlog::error("Failed to commit checkpoint {}: {}", path, std::strerror(errno));
+        return false;
+    }
+    return true;
+}
+
+std::optional<std::string> Checkpoint::read_file(const std::string& path) {
+    std::ifstream in(path, std::ios::binary);
+    if (!in) return std::nullopt;
+    return std::string(std::istreambuf_iterator<char>(in), std::istreambuf_iterator<char>());
+}
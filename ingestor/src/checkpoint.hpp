@@ -0,0 +1,34 @@
+#pragma once
+
+#include "bar_synth.hpp"
+#include "normalize.hpp"
+#include <optional>
+#include <string>
+#include <vector>
+
+struct PoolCheckpoint {
+    PoolRegistryEntry pool;
+    BarSynthesizer::State bar_5m;
+    BarSynthesizer::State bar_15m;
+};
+
+// Snapshot of every open bar accumulator plus the pool registry
+struct IngestCheckpoint {
+    int64_t written_ms;
+    int bar_interval_5m;
+    int bar_interval_15m;
+    std::vector<PoolCheckpoint> pools;
+};
+
+class Checkpoint {
+public:
+    // Compact little-endian binary encoding with a trailing FNV-1a checksum
+    static std::string encode(const IngestCheckpoint& ckpt);
+
+    // Returns nullopt on bad magic/version, truncation or checksum mismatch
+    static std::optional<IngestCheckpoint> decode(const std::string& bytes);
+
+    // Write to <path>.tmp, fsync, then rename over <path>
+    static bool write_file_atomic(const std::string& path, const std::string& bytes);
+    static std::optional<std::string> read_file(const std::string& path);
+};
@@ -0,0 +1,119 @@
+#include "config.hpp"
+#include "util.hpp"
+#include <spdlog/spdlog.h>
+#include <stdexcept>
+#include <algorithm>
+
+std::string Config::get_env(const char* name, const std::string& default_val) {
+    const char* val = std::getenv(name);
+    return val ? std::string(val) : default_val;
+}
+
+int Config::get_env_int(const char* name, int default_val) {
+    const char* val = std::getenv(name);
+    if (!val) return default_val;
+    try {
+        return std::stoi(val);
+    } catch (...) {
+        spdlog::warn("Invalid integer for {}, using default {}", name, default_val);
+        return default_val;
+    }
+}
+
+Config Config::from_env() {
+    Config cfg;
+
+    cfg.redis_url = get_env("REDIS_URL", "redis://localhost:6379");
+    cfg.stream_market = get_env("STREAM_MARKET", "soul.market.updates");
+    cfg.stream_mint = get_env("STREAM_MINT", "soul.market.mints");
+    cfg.mint_stream_partitions = std::max(1, get_env_int("MINT_STREAM_PARTITIONS", 1));
+    cfg.latest_view_key = get_env("LATEST_VIEW_KEY", "soul.market.latest");
+    cfg.latest_view_batch_size = get_env_int("LATEST_VIEW_BATCH_SIZE", 500);
+
+    cfg.pg_dsn = get_env("PG_DSN");
+
+    cfg.rpc_urls = util::split(get_env("RPC_URLS"), ',');
+    cfg.raydium_base = get_env("RAYDIUM_BASE", "https://api-v3.raydium.io");
+    cfg.orca_base = get_env("ORCA_BASE", "https://api.orca.so");
+    cfg.jupiter_price_url = get_env("JUPITER_PRICE_URL", "https://api.jup.ag/price/v2");
+
+    cfg.max_concurrency = get_env_int("MAX_CONCURRENCY", 8);
+    cfg.request_timeout_ms = get_env_int("REQUEST_TIMEOUT_MS", 8000);
+    cfg.retry_backoff_ms_min = get_env_int("RETRY_BACKOFF_MS_MIN", 500);
+    cfg.retry_backoff_ms_max = get_env_int("RETRY_BACKOFF_MS_MAX", 15000);
+
+    cfg.http_breaker_failures = get_env_int("HTTP_BREAKER_FAILURES", 5);
+    cfg.http_breaker_open_ms = get_env_int("HTTP_BREAKER_OPEN_MS", 30000);
+    cfg.http_max_inflight_per_host = get_env_int("HTTP_MAX_INFLIGHT_PER_HOST", 4);
+    cfg.http_rate_per_sec = get_env_int("HTTP_RATE_PER_SEC", 10);
+    cfg.http_rate_burst = get_env_int("HTTP_RATE_BURST", 20);
+
+    cfg.global_tick_seconds = get_env_int("GLOBAL_TICK_SECONDS", 60);
+    cfg.bar_interval_5m = get_env_int("BAR_INTERVAL_5M", 300);
+    cfg.bar_interval_15m = get_env_int("BAR_INTERVAL_15M", 900);
+
+    cfg.discovery_interval_seconds = get_env_int("DISCOVERY_INTERVAL_SECONDS", 900);
+    cfg.discovery_page_size = get_env_int("DISCOVERY_PAGE_SIZE", 500);
+    cfg.discovery_max_pages_per_tick = get_env_int("DISCOVERY_MAX_PAGES_PER_TICK", 4);
+    cfg.refresh_batch_size = get_env_int("REFRESH_BATCH_SIZE", 100);
+    cfg.raydium_requests_per_min = get_env_int("RAYDIUM_REQUESTS_PER_MIN", 0);
+    cfg.orca_requests_per_min = get_env_int("ORCA_REQUESTS_PER_MIN", 0);
+    cfg.priority_mints_key = get_env("PRIORITY_MINTS_KEY", "soul.priority.mints");
+    cfg.track_min_liq_usd = get_env_int("TRACK_MIN_LIQ_USD", 25000);
+
+    cfg.price_check_batch_size = get_env_int("PRICE_CHECK_BATCH_SIZE", 100);
+    cfg.price_check_concurrency = get_env_int("PRICE_CHECK_CONCURRENCY", 4);
+    cfg.price_check_max_dev_pct = get_env_int("PRICE_CHECK_MAX_DEV_PCT", 5);
+
+    cfg.route_max_hops = get_env_int("ROUTE_MAX_HOPS", 3);
+    cfg.route_ref_trade_usd = get_env_int("ROUTE_REF_TRADE_USD", 1000);
+    cfg.route_min_liq_usd = get_env_int("ROUTE_MIN_LIQ_USD", 10000);
+    cfg.route_stale_seconds = get_env_int("ROUTE_STALE_SECONDS", 600);
+
+    cfg.checkpoint_path = get_env("CHECKPOINT_PATH", "/var/lib/ingestor/bars.ckpt");
+    cfg.checkpoint_redis_key = get_env("CHECKPOINT_REDIS_KEY");
+    cfg.checkpoint_interval_seconds = get_env_int("CHECKPOINT_INTERVAL_SECONDS", 30);
+
+    cfg.listen_addr = get_env("LISTEN_ADDR", "0.0.0.0");
+    cfg.listen_port = get_env_int("LISTEN_PORT", 8082);
+
+    cfg.service_name = get_env("SERVICE_NAME", "ingestor");
+    cfg.log_level = get_env("LOG_LEVEL", "info");
+
+    return cfg;
+}
+
+void Config::validate() const {
+    if (pg_dsn.empty()) {
+        throw std::runtime_error("PG_DSN is required");
+    }
+    if (rpc_urls.empty()) {
+        throw std::runtime_error("RPC_URLS is required");
+    }
+
+    spdlog::info("Configuration validated successfully");
+    spdlog::info("  Tick: {}s, bars: {}s/{}s",
+                 global_tick_seconds, bar_interval_5m, bar_interval_15m);
+    spdlog::info("  Routing: <= {} hops, ${} reference trade, pools >= ${}",
+                 route_max_hops, route_ref_trade_usd, route_min_liq_usd);
+    if (!jupiter_price_url.empty()) {
+        spdlog::info("  Price check: {} mints/request x {} concurrent, degrade beyond {}%",
+                     price_check_batch_size, price_check_concurrency, price_check_max_dev_pct);
+    }
+    auto budget = [](int rpm) {
+        return rpm > 0 ? std::to_string(rpm) + " req/min" : std::string("unlimited");
+    };
+    spdlog::info("  Request budget: raydium {}, orca {}",
+                 budget(raydium_requests_per_min), budget(orca_requests_per_min));
+    if (!latest_view_key.empty()) {
+        spdlog::info("  Latest view: redis hash {} ({} fields per HSET)",
+                     latest_view_key, latest_view_batch_size);
+    }
+    if (!checkpoint_redis_key.empty()) {
+        spdlog::info("  Checkpoint: redis key {} every {}s",
+                     checkpoint_redis_key, checkpoint_interval_seconds);
+    } else if (!checkpoint_path.empty()) {
+        spdlog::info("  Checkpoint: {} every {}s",
+                     checkpoint_path, checkpoint_interval_seconds);
+    }
+}
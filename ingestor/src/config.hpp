@@ -0,0 +1,83 @@
+#pragma once
+
+#include <string>
+#include <vector>
+#include <cstdlib>
+
+struct Config {
+    // Redis
+    std::string redis_url;
+    std::string stream_market;
+    std::string stream_mint;
+    int mint_stream_partitions;      // STREAM_MINT.<n> per partition when > 1
+    std::string latest_view_key;     // empty disables the latest-state hash
+    int latest_view_batch_size;
+
+    // Postgres
+    std::string pg_dsn;
+
+    // Upstream endpoints
+    std::vector<std::string> rpc_urls;
+    std::string raydium_base;
+    std::string orca_base;
+    std::string jupiter_price_url;   // empty disables the aggregator price cross-check
+
+    // HTTP client
+    int max_concurrency;
+    int request_timeout_ms;
+    int retry_backoff_ms_min;
+    int retry_backoff_ms_max;
+
+    // Per-host protection (circuit breaker, in-flight limit, request budget)
+    int http_breaker_failures;
+    int http_breaker_open_ms;
+    int http_max_inflight_per_host;
+    int http_rate_per_sec;
+    int http_rate_burst;
+
+    // Timing
+    int global_tick_seconds;
+    int bar_interval_5m;
+    int bar_interval_15m;
+
+    // Pool discovery (slow cadence) and tracked-pool refresh (every tick)
+    int discovery_interval_seconds;
+    int discovery_page_size;
+    int discovery_max_pages_per_tick;
+    int refresh_batch_size;
+    int raydium_requests_per_min;    // 0 = unlimited
+    int orca_requests_per_min;
+    std::string priority_mints_key;  // sorted set: mint -> boost expiry (ms)
+    int track_min_liq_usd;
+
+    // Aggregator price cross-check
+    int price_check_batch_size;
+    int price_check_concurrency;
+    int price_check_max_dev_pct;
+
+    // Local routing over the pool graph
+    int route_max_hops;
+    int route_ref_trade_usd;
+    int route_min_liq_usd;
+    int route_stale_seconds;
+
+    // Bar checkpointing (empty path and key disables it)
+    std::string checkpoint_path;
+    std::string checkpoint_redis_key;
+    int checkpoint_interval_seconds;
+
+    // HTTP
+    std::string listen_addr;
+    int listen_port;
+
+    // Service
+    std::string service_name;
+    std::string log_level;
+
+    static Config from_env();
+    void validate() const;
+
+private:
+    static std::string get_env(const char* name, const std::string& default_val = "");
+    static int get_env_int(const char* name, int default_val);
+};
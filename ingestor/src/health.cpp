@@ -1,8 +1,9 @@
 #include "health.hpp"
 
 HealthCheck::HealthCheck(std::shared_ptr<RedisBus> redis,
-                         std::shared_ptr<PostgresStore> pg)
-    : redis_(redis), pg_(pg), rpc_status_("up") {}
+                         std::shared_ptr<PostgresStore> pg,
+                         std::shared_ptr<HttpClient> http)
+    : redis_(redis), pg_(pg), http_(http), rpc_status_("up"), jupiter_status_("disabled") {}
 
 void HealthCheck::update_dex_status(const std::string& dex, const std::string& status) {
     dex_status_[dex] = status;
@@ -12,6 +13,10 @@ void HealthCheck::set_rpc_status(const std::string& status) {
     rpc_status_ = status;
 }
 
+void HealthCheck::set_jupiter_status(const std::string& status) {
+    jupiter_status_ = status;
+}
+
 nlohmann::json HealthCheck::get_status() {
     bool redis_ok = redis_->ping();
     bool pg_ok = pg_->ping();
@@ -27,7 +32,8 @@ nlohmann::json HealthCheck::get_status() {
         {"postgres", pg_ok},
         {"rpc", rpc_status_},
         {"dex", dex_json},
-        {"jupiter", "up"}
+        {"jupiter", jupiter_status_},
+        {"breakers", http_->host_states()}
     };
     
     return status;
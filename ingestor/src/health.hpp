@@ -1,5 +1,6 @@
 #pragma once
 
+#include "http_client.hpp"
 #include "redis_bus.hpp"
 #include "store_pg.hpp"
 #include <nlohmann/json.hpp>
@@ -10,17 +11,21 @@
 class HealthCheck {
 public:
     HealthCheck(std::shared_ptr<RedisBus> redis,
-                std::shared_ptr<PostgresStore> pg);
+                std::shared_ptr<PostgresStore> pg,
+                std::shared_ptr<HttpClient> http);
     
     nlohmann::json get_status();
     bool is_healthy() const;
     
     void update_dex_status(const std::string& dex, const std::string& status);
     void set_rpc_status(const std::string& status);
+    void set_jupiter_status(const std::string& status);
     
 private:
     std::shared_ptr<RedisBus> redis_;
     std::shared_ptr<PostgresStore> pg_;
+    std::shared_ptr<HttpClient> http_;
     std::map<std::string, std::string> dex_status_;
     std::string rpc_status_;
+    std::string jupiter_status_;
 };
\ No newline at end of file
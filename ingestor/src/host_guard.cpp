@@ -0,0 +1,176 @@
+#include "host_guard.hpp"
+#include <algorithm>
+#include <cmath>
+
+const char* to_string(BreakerState state) {
+    switch (state) {
+        case BreakerState::Closed: return "closed";
+        case BreakerState::Open: return "open";
+        case BreakerState::HalfOpen: return "half_open";
+    }
+    return "unknown";
+}
+
+const char* to_string(StatusClass cls) {
+    switch (cls) {
+        case StatusClass::Ok2xx: return "2xx";
+        case StatusClass::Redirect3xx: return "3xx";
+        case StatusClass::Client4xx: return "4xx";
+        case StatusClass::TooMany429: return "429";
+        case StatusClass::Server5xx: return "5xx";
+        case StatusClass::Error: return "error";
+        case StatusClass::Rejected: return "rejected";
+        case StatusClass::Count: break;
+    }
+    return "unknown";
+}
+
+StatusClass classify_status(long status) {
+    if (status == 429) return StatusClass::TooMany429;
+    if (status >= 500) return StatusClass::Server5xx;
+    if (status >= 400) return StatusClass::Client4xx;
+    if (status >= 300) return StatusClass::Redirect3xx;
+    if (status >= 200) return StatusClass::Ok2xx;
+    return StatusClass::Error;
+}
+
+CircuitBreaker::CircuitBreaker(int failure_threshold, int open_ms)
+    : failure_threshold_(std::max(1, failure_threshold))
+    , open_ms_(open_ms)
+    , state_(BreakerState::Closed)
+    , consecutive_failures_(0)
+    , opened_at_ms_(0)
+    , probe_in_flight_(false)
+{}
+
+bool CircuitBreaker::allow(int64_t now_ms) {
+    switch (state_) {
+        case BreakerState::Closed:
+            return true;
+        case BreakerState::Open:
+            if (now_ms - opened_at_ms_ < open_ms_) return false;
+            state_ = BreakerState::HalfOpen;
+            probe_in_flight_ = true;
+            return true;
+        case BreakerState::HalfOpen:
+            // Only one probe at a time while half-open
+            if (probe_in_flight_) return false;
+            probe_in_flight_ = true;
+            return true;
+    }
+    return false;
+}
+
+bool CircuitBreaker::rejects(int64_t now_ms) const {
+    if (state_ == BreakerState::Open) return now_ms - opened_at_ms_ < open_ms_;
+    if (state_ == BreakerState::HalfOpen) return probe_in_flight_;
+    return false;
+}
+
+void CircuitBreaker::on_success() {
+    state_ = BreakerState::Closed;
+    consecutive_failures_ = 0;
+    probe_in_flight_ = false;
+}
+
+void CircuitBreaker::on_failure(int64_t now_ms) {
+    probe_in_flight_ = false;
+    consecutive_failures_++;
+
+    if (state_ == BreakerState::HalfOpen || consecutive_failures_ >= failure_threshold_) {
+        state_ = BreakerState::Open;
+        opened_at_ms_ = now_ms;
+    }
+}
+
+TokenBucket::TokenBucket(double rate_per_sec, double burst)
+    : rate_per_ms_(rate_per_sec / 1000.0)
+    , burst_(std::max(1.0, burst))
+    , tokens_(std::max(1.0, burst))
+    , last_refill_ms_(0)
+    , blocked_until_ms_(0)
+{}
+
+void TokenBucket::refill(int64_t now_ms) {
+    if (last_refill_ms_ == 0) {
+        last_refill_ms_ = now_ms;
+        return;
+    }
+    if (now_ms > last_refill_ms_) {
+        tokens_ = std::min(burst_, tokens_ + (now_ms - last_refill_ms_) * rate_per_ms_);
+        last_refill_ms_ = now_ms;
+    }
+}
+
+bool TokenBucket::try_take(int64_t now_ms) {
+    if (now_ms < blocked_until_ms_) return false;
+    refill(now_ms);
+    if (tokens_ < 1.0) return false;
+    tokens_ -= 1.0;
+    return true;
+}
+
+int64_t TokenBucket::wait_ms(int64_t now_ms) {
+    if (now_ms < blocked_until_ms_) return blocked_until_ms_ - now_ms;
+    refill(now_ms);
+    if (tokens_ >= 1.0) return 0;
+    if (rate_per_ms_ <= 0.0) return INT64_MAX;
+    return static_cast<int64_t>(std::ceil((1.0 - tokens_) / rate_per_ms_));
+}
+
+void TokenBucket::block_until(int64_t until_ms) {
+    blocked_until_ms_ = std::max(blocked_until_ms_, until_ms);
+    // Resume slowly after the pause instead of bursting straight back in
+    tokens_ = 0.0;
+    last_refill_ms_ = blocked_until_ms_;
+}
+
+HostGuard::HostGuard(const HostPolicy& policy)
+    : policy_(policy)
+    , breaker_(policy.failure_threshold, policy.open_ms)
+    , bucket_(policy.rate_per_sec, policy.burst)
+    , in_flight_(0)
+{}
+
+HostGuard::Admit HostGuard::try_acquire(int64_t now_ms) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    // Broken host fails fast, before we queue for a slot or budget
+    if (breaker_.rejects(now_ms)) return Admit::BreakerOpen;
+    if (in_flight_ >= policy_.max_in_flight) return Admit::Saturated;
+    if (bucket_.wait_ms(now_ms) > 0) return Admit::RateLimited;
+    if (!breaker_.allow(now_ms)) return Admit::BreakerOpen;
+
+    bucket_.try_take(now_ms);
+    in_flight_++;
+    return Admit::Ok;
+}
+
+int64_t HostGuard::budget_wait_ms(int64_t now_ms) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return bucket_.wait_ms(now_ms);
+}
+
+void HostGuard::release(int64_t now_ms, bool success, int64_t retry_after_ms) {
+    std::lock_guard<std::mutex> lock(mutex_);
+
+    in_flight_ = std::max(0, in_flight_ - 1);
+    if (success) {
+        breaker_.on_success();
+    } else {
+        breaker_.on_failure(now_ms);
+    }
+    if (retry_after_ms > 0) {
+        bucket_.block_until(now_ms + retry_after_ms);
+    }
+}
+
+BreakerState HostGuard::breaker_state() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return breaker_.state();
+}
+
+int HostGuard::in_flight() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    return in_flight_;
+}
@@ -0,0 +1,120 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <cstdint>
+#include <mutex>
+#include <string>
+
+// Per-host admission policy shared by all upstream providers
+struct HostPolicy {
+    int failure_threshold = 5;   // consecutive failures that open the breaker
+    int open_ms = 30000;         // time spent open before a half-open probe
+    int max_in_flight = 4;       // concurrent requests per host
+    double rate_per_sec = 10.0;  // sustained request budget
+    double burst = 20.0;         // bucket capacity
+};
+
+enum class BreakerState {
+    Closed,
+    Open,
+    HalfOpen
+};
+
+const char* to_string(BreakerState state);
+
+// Outcome buckets counted per host for /metrics
+enum class StatusClass {
+    Ok2xx,
+    Redirect3xx,
+    Client4xx,
+    TooMany429,
+    Server5xx,
+    Error,     // transport error or timeout
+    Rejected,  // failed fast: breaker open or budget exhausted
+    Count
+};
+
+const char* to_string(StatusClass cls);
+StatusClass classify_status(long status);
+
+class CircuitBreaker {
+public:
+    CircuitBreaker(int failure_threshold, int open_ms);
+
+    // False while open; after open_ms lets exactly one probe through (half-open)
+    bool allow(int64_t now_ms);
+    bool rejects(int64_t now_ms) const; // allow() would fail, without side effects
+    void on_success();
+    void on_failure(int64_t now_ms);
+
+    BreakerState state() const { return state_; }
+
+private:
+    int failure_threshold_;
+    int open_ms_;
+    BreakerState state_;
+    int consecutive_failures_;
+    int64_t opened_at_ms_;
+    bool probe_in_flight_;
+};
+
+class TokenBucket {
+public:
+    TokenBucket(double rate_per_sec, double burst);
+
+    bool try_take(int64_t now_ms);
+
+    // Milliseconds until a token is available (0 if one is available now)
+    int64_t wait_ms(int64_t now_ms);
+
+    // Server asked us to back off (429 / Retry-After)
+    void block_until(int64_t until_ms);
+
+private:
+    double rate_per_ms_;
+    double burst_;
+    double tokens_;
+    int64_t last_refill_ms_;
+    int64_t blocked_until_ms_;
+
+    void refill(int64_t now_ms);
+};
+
+// Circuit breaker, in-flight limit and request budget for one upstream host
+class HostGuard {
+public:
+    enum class Admit {
+        Ok,
+        BreakerOpen,
+        RateLimited,
+        Saturated
+    };
+
+    explicit HostGuard(const HostPolicy& policy);
+
+    Admit try_acquire(int64_t now_ms);
+    int64_t budget_wait_ms(int64_t now_ms);
+
+    // Must follow every successful try_acquire. retry_after_ms > 0 pauses the budget.
+    void release(int64_t now_ms, bool success, int64_t retry_after_ms = 0);
+
+    BreakerState breaker_state();
+    int in_flight();
+
+    // Lock-free outcome counters
+    void count(StatusClass cls) {
+        status_counts_[static_cast<size_t>(cls)].fetch_add(1, std::memory_order_relaxed);
+    }
+    uint64_t status_count(StatusClass cls) const {
+        return status_counts_[static_cast<size_t>(cls)].load(std::memory_order_relaxed);
+    }
+
+private:
+    std::mutex mutex_;
+    HostPolicy policy_;
+    CircuitBreaker breaker_;
+    TokenBucket bucket_;
+    int in_flight_;
+    std::array<std::atomic<uint64_t>, static_cast<size_t>(StatusClass::Count)> status_counts_{};
+};
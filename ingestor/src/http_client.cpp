@@ -0,0 +1,217 @@
+#include "http_client.hpp"
+#include "util.hpp"
+#include <curl/curl.h>
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cctype>
+#include <thread>
+
+namespace {
+
+size_t write_cb(void* contents, size_t size, size_t nmemb, void* userp) {
+    static_cast<std::string*>(userp)->append(static_cast<char*>(contents), size * nmemb);
+    return size * nmemb;
+}
+
+// Picks up "Retry-After: <seconds>"; the HTTP-date form is treated as absent
+size_t header_cb(char* buffer, size_t size, size_t nitems, void* userp) {
+    size_t len = size * nitems;
+    std::string line(buffer, len);
+    static const std::string name = "retry-after:";
+
+    if (line.size() > name.size()) {
+        std::string prefix = line.substr(0, name.size());
+        std::transform(prefix.begin(), prefix.end(), prefix.begin(),
+                       [](unsigned char c) { return std::tolower(c); });
+        if (prefix == name) {
+            try {
+                *static_cast<int64_t*>(userp) = std::stoll(line.substr(name.size())) * 1000;
+            } catch (...) {
+                // Not delta-seconds
+            }
+        }
+    }
+    return len;
+}
+
+} // namespace
+
+HttpClient::HttpClient(int timeout_ms)
+    : timeout_ms_(timeout_ms)
+    , backoff_min_ms_(500)
+    , backoff_max_ms_(15000)
+    , max_attempts_(3)
+    , max_queue_wait_ms_(1000)
+{
+    static std::once_flag curl_init;
+    std::call_once(curl_init, []() { curl_global_init(CURL_GLOBAL_DEFAULT); });
+}
+
+void HttpClient::set_retry_backoff(int min_ms, int max_ms) {
+    backoff_min_ms_ = min_ms;
+    backoff_max_ms_ = std::max(min_ms, max_ms);
+}
+
+void HttpClient::set_host_policy(const HostPolicy& policy) {
+    std::lock_guard<std::mutex> lock(hosts_mutex_);
+    policy_ = policy;
+}
+
+std::string HttpClient::host_of(const std::string& url) {
+    auto start = url.find("://");
+    start = (start == std::string::npos) ? 0 : start + 3;
+    auto end = url.find_first_of(":/?", start);
+    return url.substr(start, end == std::string::npos ? std::string::npos : end - start);
+}
+
+HostGuard& HttpClient::guard_for(const std::string& host) {
+    std::lock_guard<std::mutex> lock(hosts_mutex_);
+    auto& guard = hosts_[host];
+    if (!guard) {
+        guard = std::make_unique<HostGuard>(policy_);
+    }
+    return *guard;
+}
+
+std::map<std::string, std::string> HttpClient::host_states() {
+    std::lock_guard<std::mutex> lock(hosts_mutex_);
+    std::map<std::string, std::string> states;
+    for (const auto& [host, guard] : hosts_) {
+        states[host] = to_string(guard->breaker_state());
+    }
+    return states;
+}
+
+std::map<std::string, HostStats> HttpClient::host_stats() {
+    std::lock_guard<std::mutex> lock(hosts_mutex_);
+    std::map<std::string, HostStats> stats;
+    for (const auto& [host, guard] : hosts_) {
+        HostStats& hs = stats[host];
+        hs.breaker = to_string(guard->breaker_state());
+        hs.in_flight = guard->in_flight();
+        for (size_t i = 0; i < static_cast<size_t>(StatusClass::Count); i++) {
+            auto cls = static_cast<StatusClass>(i);
+            hs.status_counts[to_string(cls)] = guard->status_count(cls);
+        }
+    }
+    return stats;
+}
+
+std::optional<nlohmann::json> HttpClient::get_json(const std::string& url) {
+    return request(url, nullptr);
+}
+
+std::optional<nlohmann::json> HttpClient::post_json(const std::string& url,
+                                                    const nlohmann::json& body) {
+    std::string payload = body.dump();
+    return request(url, &payload);
+}
+
+std::optional<nlohmann::json> HttpClient::request(const std::string& url,
+                                                  const std::string* post_body) {
+    std::string host = host_of(url);
+    HostGuard& guard = guard_for(host);
+
+    for (int attempt = 0; attempt < max_attempts_; attempt++) {
+        // Wait briefly for an in-flight slot or budget token, never for an open breaker
+        int64_t deadline_ms = util::current_timestamp_ms() + max_queue_wait_ms_;
+        while (true) {
+            int64_t now_ms = util::current_timestamp_ms();
+            auto admit = guard.try_acquire(now_ms);
+            if (admit == HostGuard::Admit::Ok) break;
+
+            if (admit == HostGuard::Admit::BreakerOpen) {
+                spdlog::debug("Circuit open for {}, failing fast", host);
+                guard.count(StatusClass::Rejected);
+                return std::nullopt;
+            }
+
+            int64_t wait_ms = (admit == HostGuard::Admit::RateLimited)
+                ? std::max<int64_t>(1, guard.budget_wait_ms(now_ms))
+                : 5;
+            if (now_ms + wait_ms > deadline_ms) {
+                spdlog::warn("Request budget exhausted for {}, skipping", host);
+                guard.count(StatusClass::Rejected);
+                return std::nullopt;
+            }
+            std::this_thread::sleep_for(std::chrono::milliseconds(wait_ms));
+        }
+
+        HttpResponse resp = perform(url, post_body);
+        guard.count(classify_status(resp.status));
+        bool retryable = resp.status == 0 || resp.status == 429 || resp.status >= 500;
+
+        int64_t pause_ms = resp.retry_after_ms;
+        if (resp.status == 429 && pause_ms == 0) pause_ms = backoff_min_ms_;
+        guard.release(util::current_timestamp_ms(), !retryable, pause_ms);
+
+        if (!retryable) {
+            if (resp.status < 200 || resp.status >= 300) {
+                spdlog::warn("HTTP {} from {}", resp.status, host);
+                return std::nullopt;
+            }
+            try {
+                return nlohmann::json::parse(resp.body);
+            } catch (const std::exception& e) {
+                spdlog::warn("Invalid JSON from {}: {}", host, e.what());
+                return std::nullopt;
+            }
+        }
+
+        if (attempt + 1 == max_attempts_) break;
+
+        // Exponential backoff with jitter; a Retry-After beyond our cap ends the request
+        int cap_ms = std::min(backoff_max_ms_, backoff_min_ms_ << std::min(attempt + 1, 16));
+        int64_t delay_ms = std::max<int64_t>(util::random_jitter(backoff_min_ms_, cap_ms),
+                                             resp.retry_after_ms);
+        if (delay_ms > backoff_max_ms_) {
+            spdlog::warn("HTTP {} from {}, Retry-After {}ms exceeds backoff cap, giving up",
+                         resp.status, host, resp.retry_after_ms);
+            break;
+        }
+
+        spdlog::warn("HTTP {} from {}, backing off {}ms", resp.status, host, delay_ms);
+        std::this_thread::sleep_for(std::chrono::milliseconds(delay_ms));
+    }
+
+    return std::nullopt;
+}
+
+HttpResponse HttpClient::perform(const std::string& url, const std::string* post_body) {
+    HttpResponse resp{0, "", 0};
+
+    CURL* curl = curl_easy_init();
+    if (!curl) {
+        spdlog::error("Failed to initialize CURL");
+        return resp;
+    }
+
+    struct curl_slist* headers = nullptr;
+    headers = curl_slist_append(headers, "Accept: application/json");
+
+    curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+    curl_easy_setopt(curl, CURLOPT_TIMEOUT_MS, static_cast<long>(timeout_ms_));
+    curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+    curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, write_cb);
+    curl_easy_setopt(curl, CURLOPT_WRITEDATA, &resp.body);
+    curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, header_cb);
+    curl_easy_setopt(curl, CURLOPT_HEADERDATA, &resp.retry_after_ms);
+
+    if (post_body) {
+        headers = curl_slist_append(headers, "Content-Type: application/json");
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, post_body->c_str());
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDSIZE, static_cast<long>(post_body->size()));
+    }
+    curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+
+    CURLcode rc = curl_easy_perform(curl);
+    if (rc == CURLE_OK) {
+        curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &resp.status);
+    } else {
+        spdlog::debug("Request to {} failed: {}", host_of(url), curl_easy_strerror(rc));
+    }
+
+    curl_slist_free_all(headers);
+    curl_easy_cleanup(curl);
+    return resp;
+}
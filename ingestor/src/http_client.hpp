@@ -0,0 +1,50 @@
+#pragma once
+
+#include "host_guard.hpp"
+#include "metrics.hpp"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <nlohmann/json.hpp>
+
+struct HttpResponse {
+    long status;              // 0 on transport error / timeout
+    std::string body;
+    int64_t retry_after_ms;   // parsed Retry-After header, 0 if absent
+};
+
+class HttpClient {
+public:
+    explicit HttpClient(int timeout_ms);
+
+    void set_retry_backoff(int min_ms, int max_ms);
+    void set_host_policy(const HostPolicy& policy);
+
+    // nullopt on failure, including when the host's breaker is open
+    std::optional<nlohmann::json> get_json(const std::string& url);
+    std::optional<nlohmann::json> post_json(const std::string& url, const nlohmann::json& body);
+
+    // Breaker state per host seen so far, for the health endpoint
+    std::map<std::string, std::string> host_states();
+    std::map<std::string, HostStats> host_stats();
+
+    static std::string host_of(const std::string& url);
+
+private:
+    int timeout_ms_;
+    int backoff_min_ms_;
+    int backoff_max_ms_;
+    int max_attempts_;
+    int max_queue_wait_ms_;
+
+    std::mutex hosts_mutex_;
+    HostPolicy policy_;
+    std::unordered_map<std::string, std::unique_ptr<HostGuard>> hosts_;
+
+    HostGuard& guard_for(const std::string& host);
+    std::optional<nlohmann::json> request(const std::string& url, const std::string* post_body);
+    HttpResponse perform(const std::string& url, const std::string* post_body);
+};
@@ -0,0 +1,182 @@
+#include "latest_view.hpp"
+#include "byte_codec.hpp"
+#include <algorithm>
+
+namespace {
+
+constexpr char kPoolKind = 'P';
+constexpr char kMintKind = 'M';
+
+constexpr uint8_t kFlagDegraded = 1 << 0;
+constexpr uint8_t kFlagRouteOk = 1 << 1;
+
+using byte_codec::Reader;
+using byte_codec::Writer;
+
+// Length prefix for strings: mints, addresses and DEX names are well under
+// 255 bytes; longer symbols are cut
+using ShortLen = uint8_t;
+
+bool check_header(Reader& r, char kind) {
+    char k;
+    uint8_t format;
+    return r.get(k) && k == kind && r.get(format) && format == LatestView::kFormatVersion;
+}
+
+} // namespace
+
+void LatestView::stage_pool(const NormalizedPool& pool, const RouteInfo& route, int64_t now_ms) {
+    if (pool.address.empty()) return;
+    std::string field = pool_field(pool.address);
+    staged_[field] = encode_pool(pool, route, version_ + 1, now_ms);
+    last_written_ms_[field] = now_ms;
+}
+
+void LatestView::stage_mint(const MintRecord& rec) {
+    if (rec.mint.empty()) return;
+    std::string field = mint_field(rec.mint);
+    staged_[field] = encode_mint(rec, version_ + 1);
+    last_written_ms_[field] = rec.updated_ms;
+}
+
+size_t LatestView::prune(int64_t cutoff_ms) {
+    size_t removed = 0;
+    for (auto it = last_written_ms_.begin(); it != last_written_ms_.end();) {
+        if (it->second < cutoff_ms) {
+            staged_.erase(it->first);
+            deleted_.push_back(it->first);
+            it = last_written_ms_.erase(it);
+            removed++;
+        } else {
+            ++it;
+        }
+    }
+    return removed;
+}
+
+LatestViewBatch LatestView::take_batch() {
+    LatestViewBatch batch;
+    batch.upserts.reserve(staged_.size());
+    for (auto& [field, blob] : staged_) {
+        batch.upserts.emplace_back(field, std::move(blob));
+    }
+    staged_.clear();
+    batch.deletes.swap(deleted_);
+    batch.version = ++version_;
+    return batch;
+}
+
+void LatestView::requeue(LatestViewBatch&& batch) {
+    for (auto& [field, blob] : batch.upserts) {
+        if (last_written_ms_.count(field)) {
+            staged_.emplace(std::move(field), std::move(blob));
+        }
+    }
+    for (auto& field : batch.deletes) {
+        if (!last_written_ms_.count(field)) {
+            deleted_.push_back(std::move(field));
+        }
+    }
+}
+
+void LatestView::resume(uint64_t version, const std::vector<std::string>& fields, int64_t now_ms) {
+    version_ = std::max(version_, version);
+    for (const auto& field : fields) {
+        if (field.empty() || field[0] == '_') continue;
+        last_written_ms_.emplace(field, now_ms);
+    }
+}
+
+std::string LatestView::encode_pool(const NormalizedPool& pool, const RouteInfo& route,
+                                    uint64_t version, int64_t now_ms) {
+    Writer w(128);
+    w.put<char>(kPoolKind);
+    w.put<uint8_t>(kFormatVersion);
+    w.put<uint64_t>(version);
+    w.put<int64_t>(now_ms);
+    w.put<double>(pool.price);
+    w.put<double>(pool.liq_usd);
+    w.put<double>(pool.vol24h_usd);
+    w.put<double>(pool.spread_pct);
+    w.put<double>(pool.impact_1pct_pct);
+    w.put<double>(route.dev_pct);
+    w.put<uint8_t>((pool.dq == "degraded" ? kFlagDegraded : 0) | (route.ok ? kFlagRouteOk : 0));
+    w.put<uint8_t>(static_cast<uint8_t>(std::clamp(route.hops, 0, 255)));
+    w.put_string<ShortLen>(pool.mint_base);
+    w.put_string<ShortLen>(pool.mint_quote);
+    w.put_string<ShortLen>(pool.dex);
+    w.put_string<ShortLen>(pool.symbol);
+    return w.take();
+}
+
+std::string LatestView::encode_mint(const MintRecord& rec, uint64_t version) {
+    Writer w(160);
+    w.put<char>(kMintKind);
+    w.put<uint8_t>(kFormatVersion);
+    w.put<uint64_t>(version);
+    w.put<int64_t>(rec.updated_ms);
+    w.put<double>(rec.price_usd);
+    w.put<double>(rec.liq_usd);
+    w.put<double>(rec.vol24h_usd);
+    w.put<double>(rec.xdex_spread_pct);
+    w.put<double>(rec.spread_pct);
+    w.put<double>(rec.impact_1pct_pct);
+    w.put<double>(rec.route.dev_pct);
+    w.put<uint16_t>(static_cast<uint16_t>(std::clamp(rec.pool_count, 0, 65535)));
+    w.put<uint8_t>((rec.dq == "degraded" ? kFlagDegraded : 0) | (rec.route.ok ? kFlagRouteOk : 0));
+    w.put<uint8_t>(static_cast<uint8_t>(std::clamp(rec.route.hops, 0, 255)));
+    w.put_string<ShortLen>(rec.symbol);
+    w.put_string<ShortLen>(rec.best_pool);
+    w.put_string<ShortLen>(rec.best_dex);
+    return w.take();
+}
+
+std::optional<PoolSnapshot> LatestView::decode_pool(const std::string& address,
+                                                    const std::string& bytes) {
+    Reader r(bytes);
+    if (!check_header(r, kPoolKind)) return std::nullopt;
+
+    PoolSnapshot snap{};
+    snap.address = address;
+    uint8_t flags, hops;
+    if (!r.get(snap.version) || !r.get(snap.updated_ms) ||
+        !r.get(snap.price) || !r.get(snap.liq_usd) || !r.get(snap.vol24h_usd) ||
+        !r.get(snap.spread_pct) || !r.get(snap.impact_1pct_pct) ||
+        !r.get(snap.route.dev_pct) || !r.get(flags) || !r.get(hops) ||
+        !r.get_string<ShortLen>(snap.mint_base) || !r.get_string<ShortLen>(snap.mint_quote) ||
+        !r.get_string<ShortLen>(snap.dex) || !r.get_string<ShortLen>(snap.symbol)) {
+        return std::nullopt;
+    }
+
+    snap.degraded = flags & kFlagDegraded;
+    snap.route.ok = flags & kFlagRouteOk;
+    snap.route.hops = hops;
+    return snap;
+}
+
+std::optional<MintRecord> LatestView::decode_mint(const std::string& mint,
+                                                  const std::string& bytes) {
+    Reader r(bytes);
+    if (!check_header(r, kMintKind)) return std::nullopt;
+
+    MintRecord rec{};
+    rec.mint = mint;
+    uint64_t version;
+    uint16_t pool_count;
+    uint8_t flags, hops;
+    if (!r.get(version) || !r.get(rec.updated_ms) ||
+        !r.get(rec.price_usd) || !r.get(rec.liq_usd) || !r.get(rec.vol24h_usd) ||
+        !r.get(rec.xdex_spread_pct) || !r.get(rec.spread_pct) ||
+        !r.get(rec.impact_1pct_pct) || !r.get(rec.route.dev_pct) ||
+        !r.get(pool_count) || !r.get(flags) || !r.get(hops) ||
+        !r.get_string<ShortLen>(rec.symbol) || !r.get_string<ShortLen>(rec.best_pool) ||
+        !r.get_string<ShortLen>(rec.best_dex)) {
+        return std::nullopt;
+    }
+
+    rec.pool_count = pool_count;
+    rec.dq = (flags & kFlagDegraded) ? "degraded" : "ok";
+    rec.route.ok = flags & kFlagRouteOk;
+    rec.route.hops = hops;
+    return rec;
+}
@@ -0,0 +1,83 @@
+#pragma once
+
+#include "mint_view.hpp"
+#include "normalize.hpp"
+#include "route_graph.hpp"
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <utility>
+#include <vector>
+
+// Decoded "p:<address>" field of the latest-state hash
+struct PoolSnapshot {
+    std::string address;
+    std::string mint_base;
+    std::string mint_quote;
+    std::string dex;
+    std::string symbol;
+    double price;
+    double liq_usd;
+    double vol24h_usd;
+    double spread_pct;
+    double impact_1pct_pct;
+    bool degraded;
+    RouteInfo route;
+    uint64_t version;     // view version (tick) that last wrote this field
+    int64_t updated_ms;
+};
+
+// One tick's worth of hash changes, applied by RedisBus::write_latest_view
+struct LatestViewBatch {
+    std::vector<std::pair<std::string, std::string>> upserts;
+    std::vector<std::string> deletes;
+    uint64_t version;
+};
+
+// Latest state of every pool and mint, kept as one compact binary field each in
+// a Redis hash so consumers can HMGET just the mints they need instead of
+// replaying the stream. Changes are staged during a tick and flushed in one batch.
+class LatestView {
+public:
+    static constexpr uint8_t kFormatVersion = 1;
+
+    static std::string pool_field(const std::string& address) { return "p:" + address; }
+    static std::string mint_field(const std::string& mint) { return "m:" + mint; }
+
+    void stage_pool(const NormalizedPool& pool, const RouteInfo& route, int64_t now_ms);
+    void stage_mint(const MintRecord& rec);
+
+    // Fields not rewritten since cutoff_ms are queued for HDEL; returns how many
+    size_t prune(int64_t cutoff_ms);
+
+    // Hands out staged changes under a new version; empty upserts/deletes if idle
+    LatestViewBatch take_batch();
+
+    // Puts back a batch whose write failed; fields staged since then win
+    void requeue(LatestViewBatch&& batch);
+
+    // Continues numbering from an existing hash and adopts its fields as written
+    // at now_ms, so ones no longer tracked after a restart are pruned normally
+    void resume(uint64_t version, const std::vector<std::string>& fields, int64_t now_ms);
+
+    size_t field_count() const { return last_written_ms_.size(); }
+    uint64_t version() const { return version_; }
+
+    // Fixed little-endian layout: kind byte, format byte, numeric block, then
+    // u8-length-prefixed strings. Decoders return nullopt on a kind/format
+    // mismatch or truncation.
+    static std::string encode_pool(const NormalizedPool& pool, const RouteInfo& route,
+                                   uint64_t version, int64_t now_ms);
+    static std::string encode_mint(const MintRecord& rec, uint64_t version);
+    static std::optional<PoolSnapshot> decode_pool(const std::string& address,
+                                                   const std::string& bytes);
+    static std::optional<MintRecord> decode_mint(const std::string& mint,
+                                                 const std::string& bytes);
+
+private:
+    uint64_t version_ = 0;
+    std::unordered_map<std::string, std::string> staged_;
+    std::unordered_map<std::string, int64_t> last_written_ms_;
+    std::vector<std::string> deleted_;
+};
@@ -5,18 +5,30 @@
 #include "rpc_clients/jupiter_client.hpp"
 #include "rpc_clients/solana_rpc_client.hpp"
 #include "bar_synth.hpp"
+#include "budget_planner.hpp"
+#include "checkpoint.hpp"
 #include "normalize.hpp"
+#include "pool_tracker.hpp"
+#include "route_graph.hpp"
 #include "store_pg.hpp"
 #include "redis_bus.hpp"
 #include "health.hpp"
+#include "market_update.hpp"
+#include "latest_view.hpp"
+#include "mint_view.hpp"
+#include "metrics.hpp"
 #include "util.hpp"
 #include <httplib.h>
 #include <spdlog/spdlog.h>
 #include <spdlog/sinks/stdout_color_sinks.h>
 #include <signal.h>
+#include <algorithm>
 #include <atomic>
 #include <thread>
 #include <map>
+#include <memory>
+#include <unordered_map>
+#include <unordered_set>
 
 std::atomic<bool> shutdown_requested{false};
 
@@ -43,140 +55,460 @@ void setup_logging(const std::string& log_level) {
     spdlog::set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%^%l%$] %v");
 }
 
+using PoolRegistry = std::unordered_map<std::string, PoolRegistryEntry>;
+using BarMap = std::map<int64_t, std::shared_ptr<BarSynthesizer>>;
+
+IngestCheckpoint build_checkpoint(const Config& config,
+                                  const PoolRegistry& registry,
+                                  const BarMap& bar_5m,
+                                  const BarMap& bar_15m) {
+    IngestCheckpoint ckpt;
+    ckpt.written_ms = util::current_timestamp_ms();
+    ckpt.bar_interval_5m = config.bar_interval_5m;
+    ckpt.bar_interval_15m = config.bar_interval_15m;
+    ckpt.pools.reserve(registry.size());
+    
+    for (const auto& [address, entry] : registry) {
+        auto it_5m = bar_5m.find(entry.pool_id);
+        auto it_15m = bar_15m.find(entry.pool_id);
+        
+        PoolCheckpoint p;
+        p.pool = entry;
+        p.bar_5m = it_5m != bar_5m.end() ? it_5m->second->export_state()
+                                         : BarSynthesizer::State{0, {}};
+        p.bar_15m = it_15m != bar_15m.end() ? it_15m->second->export_state()
+                                            : BarSynthesizer::State{0, {}};
+        ckpt.pools.push_back(std::move(p));
+    }
+    
+    return ckpt;
+}
+
+void save_checkpoint(const Config& config, RedisBus& redis, const IngestCheckpoint& ckpt) {
+    auto start_ms = util::current_timestamp_ms();
+    auto blob = Checkpoint::encode(ckpt);
+    
+    bool ok;
+    if (!config.checkpoint_redis_key.empty()) {
+        ok = redis.save_checkpoint(config.checkpoint_redis_key, blob);
+    } else {
+        ok = Checkpoint::write_file_atomic(config.checkpoint_path, blob);
+    }
+    
+    if (ok) {
+        spdlog::debug("Checkpointed {} pools ({} bytes) in {}ms",
+                      ckpt.pools.size(), blob.size(), util::current_timestamp_ms() - start_ms);
+    }
+}
+
+// Restore open bars and the pool registry from the last checkpoint, if any
+void restore_checkpoint(const Config& config, RedisBus& redis,
+                        PoolRegistry& registry, BarMap& bar_5m, BarMap& bar_15m) {
+    std::optional<std::string> blob;
+    if (!config.checkpoint_redis_key.empty()) {
+        blob = redis.load_checkpoint(config.checkpoint_redis_key);
+    } else if (!config.checkpoint_path.empty()) {
+        blob = Checkpoint::read_file(config.checkpoint_path);
+    }
+    
+    if (!blob) {
+        spdlog::info("No bar checkpoint found, starting with empty bars");
+        return;
+    }
+    
+    auto ckpt = Checkpoint::decode(*blob);
+    if (!ckpt) {
+        spdlog::warn("Ignoring unreadable bar checkpoint");
+        return;
+    }
+    
+    if (ckpt->bar_interval_5m != config.bar_interval_5m ||
+        ckpt->bar_interval_15m != config.bar_interval_15m) {
+        spdlog::warn("Bar intervals changed since checkpoint, discarding it");
+        return;
+    }
+    
+    for (const auto& p : ckpt->pools) {
+        registry[p.pool.address] = p.pool;
+        
+        auto synth_5m = std::make_shared<BarSynthesizer>(config.bar_interval_5m);
+        auto synth_15m = std::make_shared<BarSynthesizer>(config.bar_interval_15m);
+        synth_5m->restore_state(p.bar_5m);
+        synth_15m->restore_state(p.bar_15m);
+        bar_5m[p.pool.pool_id] = synth_5m;
+        bar_15m[p.pool.pool_id] = synth_15m;
+    }
+    
+    spdlog::info("Restored {} pools from checkpoint written {}s ago",
+                 ckpt->pools.size(),
+                 (util::current_timestamp_ms() - ckpt->written_ms) / 1000);
+}
+
+template <typename Client>
+void discover_pools(Client& client, PoolTracker& tracker, BudgetPlanner& budget,
+                    const Config& config, const std::string& dex,
+                    LatencyHistogram& fetch_latency) {
+    int64_t now_ms = util::current_timestamp_ms();
+    if (!tracker.discovery_due(now_ms)) return;
+    StageTimer timer(fetch_latency);
+    
+    // Bounded number of pages per tick so a full pass never stalls the cadence;
+    // on a metered provider discovery may use at most half of the tick's
+    // budget, but a single request of credit still buys it one page
+    int available = budget.available();
+    int max_pages = std::min(config.discovery_max_pages_per_tick,
+                             available >= 1 ? std::max(1, available / 2) : 0);
+    size_t added = 0;
+    for (int page = 0; page < max_pages; page++) {
+        auto result = client.discover_pools(tracker.cursor(), config.discovery_page_size);
+        budget.spend(1);
+        added += tracker.add_page(result, now_ms);
+        if (!result.ok || !tracker.discovery_due(now_ms)) break;
+    }
+    
+    if (added > 0) {
+        spdlog::info("Discovered {} new {} pools ({} tracked)", added, dex, tracker.size());
+    }
+}
+
+template <typename Client>
+std::vector<PoolData> refresh_pools(Client& client, PoolTracker& tracker, BudgetPlanner& budget,
+                                    const Config& config, const std::string& dex,
+                                    IngestMetrics& metrics, LatencyHistogram& fetch_latency) {
+    StageTimer timer(fetch_latency);
+    int64_t now_ms = util::current_timestamp_ms();
+    size_t batch_size = static_cast<size_t>(std::max(1, config.refresh_batch_size));
+    
+    // The budget decides how many batches we can afford; the planner decides which pools
+    auto tracked = tracker.addresses();
+    size_t max_pools = budget.unlimited()
+        ? tracked.size()
+        : static_cast<size_t>(budget.available()) * batch_size;
+    auto planned = budget.plan(tracked, max_pools, now_ms);
+    metrics.set_budget_report(dex, budget.report(),
+                              budget.unlimited() ? -1 : budget.available());
+    
+    std::vector<PoolData> pools;
+    pools.reserve(planned.size());
+    
+    for (size_t i = 0; i < planned.size(); i += batch_size) {
+        std::vector<std::string> batch(planned.begin() + i,
+                                       planned.begin() + std::min(planned.size(), i + batch_size));
+        auto refreshed = client.refresh_pools(batch);
+        budget.spend(1);
+        for (auto& pool : refreshed) {
+            if (tracker.should_untrack(pool)) {
+                tracker.untrack(pool.address);
+                budget.forget(pool.address);
+                continue;
+            }
+            budget.observe(pool, now_ms);
+            pools.push_back(std::move(pool));
+        }
+    }
+    
+    if (planned.size() < tracked.size()) {
+        spdlog::debug("{} budget: refreshing {} of {} tracked pools",
+                      dex, planned.size(), tracked.size());
+    }
+    return pools;
+}
+
 void ingest_loop(std::shared_ptr<Config> config,
                  std::shared_ptr<HttpClient> http,
                  std::shared_ptr<RaydiumClient> raydium,
                  std::shared_ptr<OrcaClient> orca,
-                 std::shared_ptr<JupiterClient> jupiter,
                  std::shared_ptr<PostgresStore> pg,
                  std::shared_ptr<RedisBus> redis,
                  std::shared_ptr<HealthCheck> health,
+                 std::shared_ptr<IngestMetrics> metrics,
                  std::atomic<bool>& running) {
     
     spdlog::info("Starting ingest loop");
     
-    // Bar synthesizers per pool
-    std::map<int64_t, std::shared_ptr<BarSynthesizer>> bar_5m;
-    std::map<int64_t, std::shared_ptr<BarSynthesizer>> bar_15m;
+    // Bar synthesizers per pool, plus address -> pool id registry
+    PoolRegistry pool_registry;
+    BarMap bar_5m;
+    BarMap bar_15m;
+    
+    restore_checkpoint(*config, *redis, pool_registry, bar_5m, bar_15m);
+    bool checkpoint_enabled = !config->checkpoint_path.empty() ||
+                              !config->checkpoint_redis_key.empty();
+    int64_t last_checkpoint_ms = util::current_timestamp_ms();
+    
+    PoolTracker raydium_tracker(config->discovery_interval_seconds, config->track_min_liq_usd);
+    PoolTracker orca_tracker(config->discovery_interval_seconds, config->track_min_liq_usd);
+    BudgetPlanner raydium_budget(config->raydium_requests_per_min, config->global_tick_seconds);
+    BudgetPlanner orca_budget(config->orca_requests_per_min, config->global_tick_seconds);
+    
+    // Pools restored from the checkpoint are refreshed right away, before discovery
+    for (const auto& [address, entry] : pool_registry) {
+        if (entry.dex == "raydium") raydium_tracker.track(address);
+        else if (entry.dex == "orca") orca_tracker.track(address);
+    }
+    
+    RouteGraph routes(config->route_max_hops, config->route_ref_trade_usd,
+                      config->route_min_liq_usd);
+    MintView mint_view;
+    LatestView latest_view;
+    
+    // Aggregator cross-check: a handful of batched requests per tick
+    std::unique_ptr<JupiterClient> jupiter;
+    if (!config->jupiter_price_url.empty()) {
+        jupiter = std::make_unique<JupiterClient>(
+            config->jupiter_price_url, http,
+            static_cast<size_t>(std::max(1, config->price_check_batch_size)),
+            config->price_check_concurrency);
+    }
+    uint64_t tick_seq = 0;
+
+    bool latest_view_enabled = !config->latest_view_key.empty();
+    if (latest_view_enabled) {
+        uint64_t version;
+        auto fields = redis->latest_view_fields(config->latest_view_key, version);
+        latest_view.resume(version, fields, util::current_timestamp_ms());
+        spdlog::info("Latest view {} resumes at version {} with {} fields",
+                     config->latest_view_key, version, latest_view.field_count());
+    }
+    
+    auto process_pool = [&](const PoolData& pool_data, const std::string& dex) -> bool {
+        try {
+            // Create normalized pool structure
+            nlohmann::json raw_json = MarketUpdate::raw_pool(pool_data);
+            
+            NormalizedPool normalized;
+            {
+                StageTimer timer(metrics->stage(Stage::Normalize));
+                normalized = Normalizer::normalize_pool(raw_json, dex);
+            }
+            
+            // Only hit Postgres for pools we have not registered yet
+            int64_t pool_id;
+            auto reg_it = pool_registry.find(normalized.address);
+            if (reg_it != pool_registry.end()) {
+                pool_id = reg_it->second.pool_id;
+            } else {
+                StageTimer timer(metrics->stage(Stage::PostgresWrite));
+                pool_id = pg->upsert_pool(normalized);
+                pool_registry[normalized.address] = PoolRegistryEntry{
+                    pool_id, normalized.address, normalized.mint_base,
+                    normalized.mint_quote, normalized.dex};
+            }
+            
+            if (jupiter) {
+                auto dev = jupiter->deviation_pct(normalized.mint_base, normalized.mint_quote,
+                                                  normalized.price);
+                if (dev && *dev > config->price_check_max_dev_pct && normalized.dq != "degraded") {
+                    spdlog::debug("Pool {} deviates {:.1f}% from aggregator, marking degraded",
+                                  normalized.address, *dev);
+                    normalized.dq = "degraded";
+                    metrics->price_check_degraded_total++;
+                }
+            }
+            
+            RouteInfo route = routes.best_route(normalized.mint_base);
+            mint_view.update_pool(normalized, route, util::current_timestamp_ms());
+            if (latest_view_enabled) {
+                latest_view.stage_pool(normalized, route, util::current_timestamp_ms());
+            }
+            
+            // Create synthesizers if needed
+            if (bar_5m.find(pool_id) == bar_5m.end()) {
+                bar_5m[pool_id] = std::make_shared<BarSynthesizer>(config->bar_interval_5m);
+                bar_15m[pool_id] = std::make_shared<BarSynthesizer>(config->bar_interval_15m);
+            }
+            
+            // Add tick to synthesizers
+            PriceTick tick;
+            tick.price = normalized.price;
+            tick.volume_usd = normalized.vol24h_usd / 288.0; // Approximate per-5min volume
+            tick.timestamp_ms = util::current_timestamp_ms();
+            
+            bar_5m[pool_id]->add_tick(tick);
+            bar_15m[pool_id]->add_tick(tick);
+            
+            // Get completed bars and save
+            auto completed_5m = bar_5m[pool_id]->get_completed_bars();
+            for (const auto& bar : completed_5m) {
+                StageTimer timer(metrics->stage(Stage::PostgresWrite));
+                pg->save_5m_stats(pool_id, bar,
+                    normalized.liq_usd, normalized.vol24h_usd,
+                    normalized.spread_pct, normalized.impact_1pct_pct,
+                    route.ok, route.hops, route.dev_pct,
+                    normalized.dq);
+            }
+            
+            auto completed_15m = bar_15m[pool_id]->get_completed_bars();
+            {
+                StageTimer timer(metrics->stage(Stage::PostgresWrite));
+                for (const auto& bar : completed_15m) {
+                    pg->save_15m_bar(pool_id, bar);
+                }
+                
+                // Track first liquidity
+                pg->update_token_first_liq(normalized.mint_base, normalized.liq_usd, pool_id);
+            }
+            
+            // Publish to Redis for Analytics
+            nlohmann::json market_update = MarketUpdate::build(normalized, route);
+            
+            StageTimer timer(metrics->stage(Stage::RedisPublish));
+            redis->publish_market_update(config->stream_market, market_update);
+            return true;
+            
+        } catch (const std::exception& e) {
+            spdlog::error("Failed to process pool: {}", e.what());
+            return false;
+        }
+    };
     
     while (running) {
         auto tick_start = util::current_timestamp_ms();
         
         try {
-            // Fetch pools from Raydium
-            auto raydium_pools = raydium->get_pools();
-            spdlog::debug("Fetched {} Raydium pools", raydium_pools.size());
+            StageTimer tick_timer(metrics->stage(Stage::Tick));
+            
+            // Held and near-alert mints, published by portfolio and analytics
+            auto priority = config->priority_mints_key.empty()
+                ? std::unordered_set<std::string>()
+                : redis->priority_mints(config->priority_mints_key, util::current_timestamp_ms());
+            raydium_budget.set_priority_mints(priority);
+            orca_budget.set_priority_mints(std::move(priority));
+            raydium_budget.begin_tick();
+            orca_budget.begin_tick();
+            
+            // Slow cadence: page through provider pool lists for new pools
+            discover_pools(*raydium, raydium_tracker, raydium_budget, *config, "raydium",
+                           metrics->stage(Stage::FetchRaydium));
+            discover_pools(*orca, orca_tracker, orca_budget, *config, "orca",
+                           metrics->stage(Stage::FetchOrca));
+            
+            // Fast cadence: batch-refresh the tracked pools the budget can afford
+            auto raydium_pools = refresh_pools(*raydium, raydium_tracker, raydium_budget,
+                                               *config, "raydium", *metrics,
+                                               metrics->stage(Stage::FetchRaydium));
+            spdlog::debug("Refreshed {} Raydium pools", raydium_pools.size());
             health->update_dex_status("raydium", raydium_pools.empty() ? "degraded" : "up");
             
-            // Fetch pools from Orca
-            auto orca_pools = orca->get_pools();
-            spdlog::debug("Fetched {} Orca pools", orca_pools.size());
+            auto orca_pools = refresh_pools(*orca, orca_tracker, orca_budget, *config, "orca",
+                                            *metrics, metrics->stage(Stage::FetchOrca));
+            spdlog::debug("Refreshed {} Orca pools", orca_pools.size());
             health->update_dex_status("orca", orca_pools.empty() ? "degraded" : "up");
             
+            // Aggregator prices for every base and quote mint refreshed this tick
+            tick_seq++;
+            if (jupiter) {
+                StageTimer timer(metrics->stage(Stage::PriceCheck));
+                std::vector<std::string> mints;
+                mints.reserve(2 * (raydium_pools.size() + orca_pools.size()));
+                for (const auto* pools : {&raydium_pools, &orca_pools}) {
+                    for (const auto& p : *pools) {
+                        mints.push_back(p.mint_base);
+                        mints.push_back(p.mint_quote);
+                    }
+                }
+                metrics->price_check_requests_total += jupiter->refresh(mints, tick_seq);
+                health->set_jupiter_status(jupiter->failed_requests() == 0 ? "up" : "degraded");
+            }
+            
+            // Route health for every mint from one pass over the pool graph
+            {
+                StageTimer timer(metrics->stage(Stage::Route));
+                int64_t now_ms = util::current_timestamp_ms();
+                for (const auto* pools : {&raydium_pools, &orca_pools}) {
+                    for (const auto& p : *pools) {
+                        routes.upsert_pool(p.address, p.mint_base, p.mint_quote,
+                                           p.price, p.liq_usd, now_ms);
+                    }
+                }
+                routes.prune(now_ms - config->route_stale_seconds * 1000LL);
+                routes.recompute();
+            }
+            
+            metrics->tracked_pools = static_cast<int64_t>(raydium_tracker.size() + orca_tracker.size());
+            metrics->tick_queue_depth = static_cast<int64_t>(raydium_pools.size() + orca_pools.size());
+            
             // Process each pool
             int processed = 0;
-            for (const auto& pool_data : raydium_pools) {
-                try {
-                    // Create normalized pool structure
-                    nlohmann::json raw_json = {
-                        {"address", pool_data.address},
-                        {"mint_base", pool_data.mint_base},
-                        {"mint_quote", pool_data.mint_quote},
-                        {"price", pool_data.price},
-                        {"liquidity_usd", pool_data.liq_usd},
-                        {"volume_24h_usd", pool_data.vol24h_usd}
-                    };
-                    
-                    auto normalized = Normalizer::normalize_pool(raw_json, "raydium");
-                    int64_t pool_id = pg->upsert_pool(normalized);
-                    
-                    // Create synthesizers if needed
-                    if (bar_5m.find(pool_id) == bar_5m.end()) {
-                        bar_5m[pool_id] = std::make_shared<BarSynthesizer>(config->bar_interval_5m);
-                        bar_15m[pool_id] = std::make_shared<BarSynthesizer>(config->bar_interval_15m);
-                    }
-                    
-                    // Add tick to synthesizers
-                    PriceTick tick;
-                    tick.price = normalized.price;
-                    tick.volume_usd = normalized.vol24h_usd / 288.0; // Approximate per-5min volume
-                    tick.timestamp_ms = util::current_timestamp_ms();
-                    
-                    bar_5m[pool_id]->add_tick(tick);
-                    bar_15m[pool_id]->add_tick(tick);
-                    
-                    // Get completed bars and save
-                    auto completed_5m = bar_5m[pool_id]->get_completed_bars();
-                    for (const auto& bar : completed_5m) {
-                        // Get Jupiter route info
-                        auto route = jupiter->get_route(normalized.mint_base, "USDC");
-                        
-                        pg->save_5m_stats(pool_id, bar,
-                            normalized.liq_usd, normalized.vol24h_usd,
-                            normalized.spread_pct, normalized.impact_1pct_pct,
-                            route.ok, route.hops, route.dev_pct,
-                            normalized.dq);
+            auto run_pool = [&](const PoolData& pool_data, const std::string& dex) {
+                if (process_pool(pool_data, dex)) {
+                    processed++;
+                    metrics->pools_processed_total++;
+                } else {
+                    metrics->pool_errors_total++;
+                }
+                metrics->tick_queue_depth--;
+            };
+            for (const auto& pool_data : raydium_pools) run_pool(pool_data, "raydium");
+            for (const auto& pool_data : orca_pools) run_pool(pool_data, "orca");
+            
+            metrics->pools_last_tick = processed;
+            
+            // One consolidated message per mint whose pools changed this tick
+            int64_t now_ms = util::current_timestamp_ms();
+            mint_view.prune(now_ms - config->route_stale_seconds * 1000LL);
+            auto mints = mint_view.take_dirty(now_ms);
+            {
+                StageTimer timer(metrics->stage(Stage::RedisPublish));
+                // A mint always lands in the same partition, so its updates stay ordered
+                for (const auto& rec : mints) {
+                    int partition = util::mint_partition(rec.mint, config->mint_stream_partitions);
+                    redis->publish_market_update(
+                        util::partition_stream(config->stream_mint, partition,
+                                               config->mint_stream_partitions),
+                        MintView::to_json(rec));
+                }
+                
+                // Latest-state hash: every field touched this tick in one pipelined write
+                if (latest_view_enabled) {
+                    for (const auto& rec : mints) {
+                        latest_view.stage_mint(rec);
                     }
-                    
-                    auto completed_15m = bar_15m[pool_id]->get_completed_bars();
-                    for (const auto& bar : completed_15m) {
-                        pg->save_15m_bar(pool_id, bar);
+                    latest_view.prune(now_ms - config->route_stale_seconds * 1000LL);
+                    auto batch = latest_view.take_batch();
+                    if (!redis->write_latest_view(config->latest_view_key, batch,
+                                                  static_cast<size_t>(config->latest_view_batch_size))) {
+                        latest_view.requeue(std::move(batch));
                     }
-                    
-                    // Track first liquidity
-                    pg->update_token_first_liq(normalized.mint_base, normalized.liq_usd, pool_id);
-                    
-                    // Publish to Redis for Analytics
-                    nlohmann::json market_update = {
-                        {"pool", normalized.address},
-                        {"mint_base", normalized.mint_base},
-                        {"mint_quote", normalized.mint_quote},
-                        {"price", normalized.price},
-                        {"liq_usd", normalized.liq_usd},
-                        {"vol24h_usd", normalized.vol24h_usd},
-                        {"spread_pct", normalized.spread_pct},
-                        {"impact_1pct_pct", normalized.impact_1pct_pct},
-                        {"age_hours", 0.0}, // Would calculate from first_liq_ts
-                        {"route", {
-                            {"ok", true},
-                            {"hops", 2},
-                            {"dev_pct", 0.3}
-                        }},
-                        {"bars", {
-                            {"5m", {
-                                {"o", 0.0}, {"h", 0.0}, {"l", 0.0}, {"c", normalized.price}, {"v_usd", 0.0}
-                            }},
-                            {"15m", {
-                                {"o", 0.0}, {"h", 0.0}, {"l", 0.0}, {"c", normalized.price}, {"v_usd", 0.0}
-                            }}
-                        }},
-                        {"dq", normalized.dq},
-                        {"ts", util::current_iso8601()}
-                    };
-                    
-                    redis->publish_market_update(config->stream_market, market_update);
-                    processed++;
-                    
-                } catch (const std::exception& e) {
-                    spdlog::error("Failed to process pool: {}", e.what());
+                    metrics->latest_view_fields = static_cast<int64_t>(latest_view.field_count());
                 }
             }
-            
-            spdlog::info("Tick complete: processed {} pools", processed);
+            metrics->mints_last_tick = static_cast<int64_t>(mints.size());
+            spdlog::info("Tick complete: processed {} pools, published {} mints",
+                         processed, mints.size());
             
         } catch (const std::exception& e) {
             spdlog::error("Ingest loop error: {}", e.what());
         }
+        metrics->ticks_total++;
+        
+        if (checkpoint_enabled &&
+            util::current_timestamp_ms() - last_checkpoint_ms >=
+                config->checkpoint_interval_seconds * 1000LL) {
+            save_checkpoint(*config, *redis,
+                            build_checkpoint(*config, pool_registry, bar_5m, bar_15m));
+            last_checkpoint_ms = util::current_timestamp_ms();
+        }
         
         // Sleep until next tick
         auto tick_duration = util::current_timestamp_ms() - tick_start;
         auto sleep_ms = (config->global_tick_seconds * 1000) - tick_duration;
+        if (sleep_ms < 0) {
+            metrics->tick_overruns_total++;
+            spdlog::warn("Tick overran its {}s budget by {}ms", config->global_tick_seconds, -sleep_ms);
+        }
         
         if (sleep_ms > 0) {
             std::this_thread::sleep_for(std::chrono::milliseconds(sleep_ms));
         }
     }
     
+    // Final checkpoint so a rolling deploy picks up exactly where we stopped
+    if (checkpoint_enabled) {
+        save_checkpoint(*config, *redis,
+                        build_checkpoint(*config, pool_registry, bar_5m, bar_15m));
+    }
+    
     spdlog::info("Ingest loop stopped");
 }
 
@@ -198,21 +530,29 @@ int main(int argc, char* argv[]) {
         auto http = std::make_shared<HttpClient>(config->request_timeout_ms);
         http->set_retry_backoff(config->retry_backoff_ms_min, config->retry_backoff_ms_max);
         
+        HostPolicy host_policy;
+        host_policy.failure_threshold = config->http_breaker_failures;
+        host_policy.open_ms = config->http_breaker_open_ms;
+        host_policy.max_in_flight = config->http_max_inflight_per_host;
+        host_policy.rate_per_sec = config->http_rate_per_sec;
+        host_policy.burst = config->http_rate_burst;
+        http->set_host_policy(host_policy);
+        
         auto redis = std::make_shared<RedisBus>(config->redis_url);
         auto pg = std::make_shared<PostgresStore>(config->pg_dsn);
         auto rpc = std::make_shared<SolanaRPCClient>(config->rpc_urls, http);
         auto raydium = std::make_shared<RaydiumClient>(config->raydium_base, http);
         auto orca = std::make_shared<OrcaClient>(config->orca_base, http);
-        auto jupiter = std::make_shared<JupiterClient>(config->jupiter_base, http);
-        auto health = std::make_shared<HealthCheck>(redis, pg);
+        auto health = std::make_shared<HealthCheck>(redis, pg, http);
+        auto metrics = std::make_shared<IngestMetrics>();
         
         // Initialize database
         pg->init_schema();
         
         // Start ingest loop
         std::atomic<bool> loop_running{true};
-        std::thread ingest_thread(ingest_loop, config, http, raydium, orca, jupiter,
-                                 pg, redis, health, std::ref(loop_running));
+        std::thread ingest_thread(ingest_loop, config, http, raydium, orca,
+                                 pg, redis, health, metrics, std::ref(loop_running));
         
         // Start HTTP health server
         httplib::Server server;
@@ -223,6 +563,23 @@ int main(int argc, char* argv[]) {
             res.status = health->is_healthy() ? 200 : 503;
         });
         
+        server.Get("/metrics", [metrics, http, redis, config](const httplib::Request&,
+                                                              httplib::Response& res) {
+            // Analytics reads the per-mint partitions, so their backlog is
+            // the one that sizes consumers
+            std::map<std::string, int64_t> mint_streams;
+            for (int p = 0; p < config->mint_stream_partitions; p++) {
+                std::string stream = util::partition_stream(config->stream_mint, p,
+                                                            config->mint_stream_partitions);
+                int64_t length = redis->stream_length(stream);
+                if (length >= 0) mint_streams.emplace(std::move(stream), length);
+            }
+            auto body = metrics->render_prometheus(http->host_stats(),
+                                                   redis->stream_length(config->stream_market),
+                                                   mint_streams);
+            res.set_content(body, "text/plain; version=0.0.4");
+        });
+        
         std::thread http_thread([&server, config]() {
             spdlog::info("Starting HTTP server on {}:{}", config->listen_addr, config->listen_port);
             server.listen(config->listen_addr.c_str(), config->listen_port);
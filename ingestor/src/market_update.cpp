@@ -0,0 +1,48 @@
+#include "market_update.hpp"
+#include "util.hpp"
+
+nlohmann::json MarketUpdate::raw_pool(const PoolData& pool) {
+    nlohmann::json raw = {
+        {"address", pool.address},
+        {"mint_base", pool.mint_base},
+        {"mint_quote", pool.mint_quote},
+        {"symbol", pool.symbol_base},
+        {"price", pool.price},
+        {"liquidity_usd", pool.liq_usd},
+        {"volume_24h_usd", pool.vol24h_usd}
+    };
+    if (pool.reserve_base > 0 && pool.reserve_quote > 0) {
+        raw["reserve_base"] = pool.reserve_base;
+        raw["reserve_quote"] = pool.reserve_quote;
+    }
+    return raw;
+}
+
+nlohmann::json MarketUpdate::build(const NormalizedPool& pool, const RouteInfo& route) {
+    return {
+        {"pool", pool.address},
+        {"mint_base", pool.mint_base},
+        {"mint_quote", pool.mint_quote},
+        {"price", pool.price},
+        {"liq_usd", pool.liq_usd},
+        {"vol24h_usd", pool.vol24h_usd},
+        {"spread_pct", pool.spread_pct},
+        {"impact_1pct_pct", pool.impact_1pct_pct},
+        {"age_hours", 0.0}, // Would calculate from first_liq_ts
+        {"route", {
+            {"ok", route.ok},
+            {"hops", route.hops},
+            {"dev_pct", route.dev_pct}
+        }},
+        {"bars", {
+            {"5m", {
+                {"o", 0.0}, {"h", 0.0}, {"l", 0.0}, {"c", pool.price}, {"v_usd", 0.0}
+            }},
+            {"15m", {
+                {"o", 0.0}, {"h", 0.0}, {"l", 0.0}, {"c", pool.price}, {"v_usd", 0.0}
+            }}
+        }},
+        {"dq", pool.dq},
+        {"ts", util::current_iso8601()}
+    };
+}
@@ -0,0 +1,16 @@
+#pragma once
+
+#include "normalize.hpp"
+#include "route_graph.hpp"
+#include "rpc_clients/raydium_client.hpp"
+#include <nlohmann/json.hpp>
+
+// Shapes shared by the ingest loop and the benchmarks
+class MarketUpdate {
+public:
+    // Provider pool in the raw form Normalizer::normalize_pool expects
+    static nlohmann::json raw_pool(const PoolData& pool);
+
+    // Message published to STREAM_MARKET for Analytics
+    static nlohmann::json build(const NormalizedPool& pool, const RouteInfo& route);
+};
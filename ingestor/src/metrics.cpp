@@ -0,0 +1,242 @@
+#include "metrics.hpp"
+#include <fmt/format.h>
+
+namespace alloc_counter {
+    std::atomic<uint64_t> allocations_total{0};
+    std::atomic<uint64_t> deallocations_total{0};
+}
+
+namespace {
+
+// Coarse Prometheus bucket bounds (seconds) folded from the fine histogram
+constexpr double kExportBoundsSec[] = {
+    0.0001, 0.00025, 0.0005, 0.001, 0.0025, 0.005, 0.01, 0.025, 0.05,
+    0.1, 0.25, 0.5, 1.0, 2.5, 5.0, 10.0, 30.0, 60.0
+};
+
+constexpr double kExportQuantiles[] = {0.5, 0.9, 0.99, 0.999};
+
+} // namespace
+
+const char* to_string(Stage stage) {
+    switch (stage) {
+        case Stage::FetchRaydium: return "fetch_raydium";
+        case Stage::FetchOrca: return "fetch_orca";
+        case Stage::Route: return "route";
+        case Stage::PriceCheck: return "price_check";
+        case Stage::Normalize: return "normalize";
+        case Stage::PostgresWrite: return "pg_write";
+        case Stage::RedisPublish: return "redis_publish";
+        case Stage::Tick: return "tick";
+        case Stage::Count: break;
+    }
+    return "unknown";
+}
+
+LatencyHistogram::LatencyHistogram() : count_(0), sum_us_(0) {
+    for (auto& b : buckets_) {
+        b.store(0, std::memory_order_relaxed);
+    }
+}
+
+int LatencyHistogram::bucket_index(uint64_t value_us) {
+    if (value_us < static_cast<uint64_t>(kSubBuckets)) {
+        return static_cast<int>(value_us);
+    }
+
+    int exponent = 63 - __builtin_clzll(value_us);
+    if (exponent > kMaxExponent) {
+        return kBucketCount - 1;
+    }
+
+    int sub = static_cast<int>((value_us >> (exponent - kSubBucketBits)) & (kSubBuckets - 1));
+    return (exponent - kSubBucketBits + 1) * kSubBuckets + sub;
+}
+
+uint64_t LatencyHistogram::bucket_upper_us(int index) {
+    if (index < kSubBuckets) {
+        return static_cast<uint64_t>(index);
+    }
+
+    int exponent = index / kSubBuckets + kSubBucketBits - 1;
+    uint64_t sub = static_cast<uint64_t>(index % kSubBuckets);
+    return ((kSubBuckets + sub + 1) << (exponent - kSubBucketBits)) - 1;
+}
+
+void LatencyHistogram::record(uint64_t value_us) {
+    buckets_[bucket_index(value_us)].fetch_add(1, std::memory_order_relaxed);
+    count_.fetch_add(1, std::memory_order_relaxed);
+    sum_us_.fetch_add(value_us, std::memory_order_relaxed);
+}
+
+uint64_t LatencyHistogram::quantile_us(double q) const {
+    uint64_t total = count();
+    if (total == 0) return 0;
+
+    auto rank = static_cast<uint64_t>(q * static_cast<double>(total));
+    if (rank >= total) rank = total - 1;
+
+    uint64_t seen = 0;
+    for (int i = 0; i < kBucketCount; i++) {
+        seen += buckets_[i].load(std::memory_order_relaxed);
+        if (seen > rank) return bucket_upper_us(i);
+    }
+    return bucket_upper_us(kBucketCount - 1);
+}
+
+uint64_t LatencyHistogram::count_at_or_below(uint64_t bound_us) const {
+    uint64_t total = 0;
+    for (int i = 0; i < kBucketCount && bucket_upper_us(i) <= bound_us; i++) {
+        total += buckets_[i].load(std::memory_order_relaxed);
+    }
+    return total;
+}
+
+void IngestMetrics::set_budget_report(const std::string& dex, std::vector<BudgetTierStats> tiers,
+                                      int credit) {
+    std::lock_guard<std::mutex> lock(budget_mutex_);
+    budget_tiers_[dex] = std::move(tiers);
+    budget_credit_[dex] = credit;
+}
+
+std::string IngestMetrics::render_prometheus(const std::map<std::string, HostStats>& hosts,
+                                             int64_t stream_length,
+                                             const std::map<std::string, int64_t>& mint_stream_lengths) const {
+    std::string out;
+    out.reserve(16384);
+
+    out += "# HELP ingestor_stage_latency_seconds Latency per ingest stage\n";
+    out += "# TYPE ingestor_stage_latency_seconds histogram\n";
+    for (size_t s = 0; s < stages_.size(); s++) {
+        const auto& hist = stages_[s];
+        const char* name = to_string(static_cast<Stage>(s));
+        for (double bound : kExportBoundsSec) {
+            out += fmt::format("ingestor_stage_latency_seconds_bucket{{stage=\"{}\",le=\"{}\"}} {}\n",
+                               name, bound,
+                               hist.count_at_or_below(static_cast<uint64_t>(bound * 1e6)));
+        }
+        out += fmt::format("ingestor_stage_latency_seconds_bucket{{stage=\"{}\",le=\"+Inf\"}} {}\n",
+                           name, hist.count());
+        out += fmt::format("ingestor_stage_latency_seconds_sum{{stage=\"{}\"}} {}\n",
+                           name, hist.sum_us() / 1e6);
+        out += fmt::format("ingestor_stage_latency_seconds_count{{stage=\"{}\"}} {}\n",
+                           name, hist.count());
+    }
+
+    out += "# HELP ingestor_stage_latency_quantile_seconds Fine-grained latency quantiles\n";
+    out += "# TYPE ingestor_stage_latency_quantile_seconds gauge\n";
+    for (size_t s = 0; s < stages_.size(); s++) {
+        const char* name = to_string(static_cast<Stage>(s));
+        for (double q : kExportQuantiles) {
+            out += fmt::format("ingestor_stage_latency_quantile_seconds{{stage=\"{}\",quantile=\"{}\"}} {}\n",
+                               name, q, stages_[s].quantile_us(q) / 1e6);
+        }
+    }
+
+    auto counter = [&out](const char* name, const char* help, uint64_t value) {
+        out += fmt::format("# HELP {0} {1}\n# TYPE {0} counter\n{0} {2}\n", name, help, value);
+    };
+    auto gauge = [&out](const char* name, const char* help, int64_t value) {
+        out += fmt::format("# HELP {0} {1}\n# TYPE {0} gauge\n{0} {2}\n", name, help, value);
+    };
+
+    counter("ingestor_ticks_total", "Completed ingest ticks",
+            ticks_total.load(std::memory_order_relaxed));
+    counter("ingestor_tick_overruns_total", "Ticks that exceeded GLOBAL_TICK_SECONDS",
+            tick_overruns_total.load(std::memory_order_relaxed));
+    counter("ingestor_pools_processed_total", "Pools processed",
+            pools_processed_total.load(std::memory_order_relaxed));
+    counter("ingestor_pool_errors_total", "Pools that failed processing",
+            pool_errors_total.load(std::memory_order_relaxed));
+    counter("ingestor_price_check_requests_total", "Batched aggregator price requests",
+            price_check_requests_total.load(std::memory_order_relaxed));
+    counter("ingestor_price_check_degraded_total", "Pools degraded for deviating from the aggregator",
+            price_check_degraded_total.load(std::memory_order_relaxed));
+    counter("ingestor_heap_allocations_total", "Global operator new calls",
+            alloc_counter::allocations_total.load(std::memory_order_relaxed));
+    counter("ingestor_heap_deallocations_total", "Global operator delete calls",
+            alloc_counter::deallocations_total.load(std::memory_order_relaxed));
+
+    gauge("ingestor_pools_last_tick", "Pools processed in the last tick",
+          pools_last_tick.load(std::memory_order_relaxed));
+    gauge("ingestor_mints_last_tick", "Consolidated mint updates published in the last tick",
+          mints_last_tick.load(std::memory_order_relaxed));
+    gauge("ingestor_latest_view_fields", "Pool and mint fields in the latest-state hash",
+          latest_view_fields.load(std::memory_order_relaxed));
+    gauge("ingestor_tracked_pools", "Pools tracked across all DEXes",
+          tracked_pools.load(std::memory_order_relaxed));
+    gauge("ingestor_tick_queue_depth", "Pools fetched but not yet processed this tick",
+          tick_queue_depth.load(std::memory_order_relaxed));
+    if (stream_length >= 0) {
+        gauge("ingestor_market_stream_length", "Entries in the market update stream",
+              stream_length);
+    }
+    if (!mint_stream_lengths.empty()) {
+        out += "# HELP ingestor_mint_stream_length Entries per partition of the per-mint stream\n";
+        out += "# TYPE ingestor_mint_stream_length gauge\n";
+        for (const auto& [stream, length] : mint_stream_lengths) {
+            out += fmt::format("ingestor_mint_stream_length{{stream=\"{}\"}} {}\n", stream, length);
+        }
+    }
+
+    out += "# HELP ingestor_http_responses_total Upstream responses by host and status class\n";
+    out += "# TYPE ingestor_http_responses_total counter\n";
+    for (const auto& [host, stats] : hosts) {
+        for (const auto& [status, count] : stats.status_counts) {
+            out += fmt::format("ingestor_http_responses_total{{host=\"{}\",status=\"{}\"}} {}\n",
+                               host, status, count);
+        }
+    }
+
+    out += "# HELP ingestor_http_in_flight Requests in flight per host\n";
+    out += "# TYPE ingestor_http_in_flight gauge\n";
+    for (const auto& [host, stats] : hosts) {
+        out += fmt::format("ingestor_http_in_flight{{host=\"{}\"}} {}\n", host, stats.in_flight);
+    }
+
+    out += "# HELP ingestor_http_breaker_open Whether the host's circuit breaker is not closed\n";
+    out += "# TYPE ingestor_http_breaker_open gauge\n";
+    for (const auto& [host, stats] : hosts) {
+        out += fmt::format("ingestor_http_breaker_open{{host=\"{}\",state=\"{}\"}} {}\n",
+                           host, stats.breaker, stats.breaker == "closed" ? 0 : 1);
+    }
+
+    std::lock_guard<std::mutex> lock(budget_mutex_);
+    if (!budget_tiers_.empty()) {
+        out += "# HELP ingestor_budget_tier_pools Tracked pools per provider and value tier\n";
+        out += "# TYPE ingestor_budget_tier_pools gauge\n";
+        for (const auto& [dex, tiers] : budget_tiers_) {
+            for (const auto& t : tiers) {
+                out += fmt::format("ingestor_budget_tier_pools{{dex=\"{}\",tier=\"{}\"}} {}\n",
+                                   dex, t.tier, t.pools);
+            }
+        }
+        out += "# HELP ingestor_budget_coverage_ratio Share of a tier refreshed in the last tick\n";
+        out += "# TYPE ingestor_budget_coverage_ratio gauge\n";
+        for (const auto& [dex, tiers] : budget_tiers_) {
+            for (const auto& t : tiers) {
+                double ratio = t.pools > 0 ? static_cast<double>(t.planned) / t.pools : 1.0;
+                out += fmt::format("ingestor_budget_coverage_ratio{{dex=\"{}\",tier=\"{}\"}} {}\n",
+                                   dex, t.tier, ratio);
+            }
+        }
+        out += "# HELP ingestor_budget_data_age_seconds Age of tier data when the tick was planned\n";
+        out += "# TYPE ingestor_budget_data_age_seconds gauge\n";
+        for (const auto& [dex, tiers] : budget_tiers_) {
+            for (const auto& t : tiers) {
+                out += fmt::format("ingestor_budget_data_age_seconds{{dex=\"{}\",tier=\"{}\",stat=\"max\"}} {}\n",
+                                   dex, t.tier, t.max_age_s);
+                out += fmt::format("ingestor_budget_data_age_seconds{{dex=\"{}\",tier=\"{}\",stat=\"avg\"}} {}\n",
+                                   dex, t.tier, t.avg_age_s);
+            }
+        }
+        out += "# HELP ingestor_budget_credit_requests Unspent request credit per provider\n";
+        out += "# TYPE ingestor_budget_credit_requests gauge\n";
+        for (const auto& [dex, credit] : budget_credit_) {
+            if (credit < 0) continue; // unlimited
+            out += fmt::format("ingestor_budget_credit_requests{{dex=\"{}\"}} {}\n", dex, credit);
+        }
+    }
+
+    return out;
+}
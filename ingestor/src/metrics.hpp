@@ -0,0 +1,132 @@
+#pragma once
+
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstdint>
+#include <map>
+#include <mutex>
+#include <string>
+#include <vector>
+
+// Log-linear (HDR-style) latency histogram in microseconds: 8 sub-buckets per
+// power of two, so any recorded value is within 12.5% of its bucket bound.
+// record() is wait-free; readers see a relaxed but monotonic view.
+class LatencyHistogram {
+public:
+    static constexpr int kSubBucketBits = 3;
+    static constexpr int kSubBuckets = 1 << kSubBucketBits;
+    static constexpr int kMaxExponent = 35; // ~9.5h in microseconds
+    static constexpr int kBucketCount = (kMaxExponent - kSubBucketBits + 2) * kSubBuckets;
+
+    LatencyHistogram();
+
+    void record(uint64_t value_us);
+
+    uint64_t count() const { return count_.load(std::memory_order_relaxed); }
+    uint64_t sum_us() const { return sum_us_.load(std::memory_order_relaxed); }
+
+    // Upper bound (us) of the bucket containing the q-th quantile
+    uint64_t quantile_us(double q) const;
+
+    // Number of recorded values <= bound_us (exact at bucket boundaries)
+    uint64_t count_at_or_below(uint64_t bound_us) const;
+
+    static int bucket_index(uint64_t value_us);
+    static uint64_t bucket_upper_us(int index);
+
+private:
+    std::array<std::atomic<uint64_t>, kBucketCount> buckets_;
+    std::atomic<uint64_t> count_;
+    std::atomic<uint64_t> sum_us_;
+};
+
+enum class Stage {
+    FetchRaydium,
+    FetchOrca,
+    Route,
+    PriceCheck,
+    Normalize,
+    PostgresWrite,
+    RedisPublish,
+    Tick,
+    Count
+};
+
+const char* to_string(Stage stage);
+
+// Per-host request outcome counters, kept next to the host's circuit breaker
+struct HostStats {
+    std::string breaker;
+    int in_flight;
+    std::map<std::string, uint64_t> status_counts; // "2xx", "4xx", "429", "5xx", "error", ...
+};
+
+// Refresh coverage of one value tier of a provider's tracked pools
+struct BudgetTierStats {
+    std::string tier;          // "priority", "deep", "mid", "shallow", "new"
+    size_t pools;
+    size_t planned;            // pools scheduled for refresh this tick
+    double max_age_s;          // data age at planning time
+    double avg_age_s;
+};
+
+class IngestMetrics {
+public:
+    LatencyHistogram& stage(Stage s) { return stages_[static_cast<size_t>(s)]; }
+
+    std::atomic<uint64_t> ticks_total{0};
+    std::atomic<uint64_t> tick_overruns_total{0};
+    std::atomic<uint64_t> pools_processed_total{0};
+    std::atomic<uint64_t> pool_errors_total{0};
+    std::atomic<uint64_t> price_check_degraded_total{0};
+    std::atomic<uint64_t> price_check_requests_total{0};
+    std::atomic<int64_t> pools_last_tick{0};
+    std::atomic<int64_t> mints_last_tick{0};
+    std::atomic<int64_t> latest_view_fields{0};
+    std::atomic<int64_t> tracked_pools{0};
+    std::atomic<int64_t> tick_queue_depth{0};
+
+    // credit < 0 marks an unlimited provider
+    void set_budget_report(const std::string& dex, std::vector<BudgetTierStats> tiers,
+                           int credit);
+
+    // Prometheus text exposition format (version 0.0.4). stream_length < 0
+    // omits the market stream gauge; mint_stream_lengths holds the per-mint
+    // stream partitions Redis answered for, by stream name.
+    std::string render_prometheus(const std::map<std::string, HostStats>& hosts,
+                                  int64_t stream_length,
+                                  const std::map<std::string, int64_t>& mint_stream_lengths) const;
+
+private:
+    std::array<LatencyHistogram, static_cast<size_t>(Stage::Count)> stages_;
+
+    mutable std::mutex budget_mutex_;
+    std::map<std::string, std::vector<BudgetTierStats>> budget_tiers_;
+    std::map<std::string, int> budget_credit_;
+};
+
+// Records the elapsed time into a histogram when it goes out of scope
+class StageTimer {
+public:
+    explicit StageTimer(LatencyHistogram& hist)
+        : hist_(hist), start_(std::chrono::steady_clock::now()) {}
+
+    ~StageTimer() {
+        auto elapsed = std::chrono::steady_clock::now() - start_;
+        hist_.record(std::chrono::duration_cast<std::chrono::microseconds>(elapsed).count());
+    }
+
+    StageTimer(const StageTimer&) = delete;
+    StageTimer& operator=(const StageTimer&) = delete;
+
+private:
+    LatencyHistogram& hist_;
+    std::chrono::steady_clock::time_point start_;
+};
+
+// Global operator new/delete counters; stay zero unless alloc_counter.cpp is linked in
+namespace alloc_counter {
+    extern std::atomic<uint64_t> allocations_total;
+    extern std::atomic<uint64_t> deallocations_total;
+}
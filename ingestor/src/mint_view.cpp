@@ -0,0 +1,191 @@
+#include "mint_view.hpp"
+#include "util.hpp"
+#include <algorithm>
+
+namespace {
+
+// Pools below this share of a mint's liquidity do not count toward its cross-DEX
+// spread; dust pools quote stale prices and would dominate the max/min
+constexpr double kSpreadMinLiqShare = 0.05;
+
+} // namespace
+
+void MintView::update_pool(const NormalizedPool& pool, const RouteInfo& route, int64_t now_ms) {
+    if (pool.address.empty() || pool.mint_base.empty()) return;
+
+    auto it = pools_.find(pool.address);
+    if (it != pools_.end() && it->second.mint != pool.mint_base) {
+        remove_pool(pool.address);
+        it = pools_.end();
+    }
+
+    PoolEntry entry{pool.mint_base, pool.mint_quote, pool.dex, pool.symbol,
+                    pool.price, pool.liq_usd, pool.vol24h_usd,
+                    pool.spread_pct, pool.impact_1pct_pct,
+                    pool.dq == "degraded", now_ms};
+    if (it == pools_.end()) {
+        pools_.emplace(pool.address, std::move(entry));
+    } else {
+        it->second = std::move(entry);
+    }
+
+    MintEntry& mint = mints_[pool.mint_base];
+    mint.pools.insert(pool.address);
+    mint.route = route;
+    dirty_.insert(pool.mint_base);
+}
+
+void MintView::remove_pool(const std::string& address) {
+    auto it = pools_.find(address);
+    if (it == pools_.end()) return;
+
+    auto mint_it = mints_.find(it->second.mint);
+    if (mint_it != mints_.end()) {
+        mint_it->second.pools.erase(address);
+        if (mint_it->second.pools.empty()) {
+            dirty_.erase(mint_it->first);
+            mints_.erase(mint_it);
+        } else {
+            dirty_.insert(mint_it->first);
+        }
+    }
+    pools_.erase(it);
+}
+
+size_t MintView::prune(int64_t cutoff_ms) {
+    std::vector<std::string> stale;
+    for (const auto& [address, entry] : pools_) {
+        if (entry.last_seen_ms < cutoff_ms) stale.push_back(address);
+    }
+    for (const auto& address : stale) {
+        remove_pool(address);
+    }
+    return stale.size();
+}
+
+double MintView::quote_usd(const std::string& quote) const {
+    if (quote == kUsdcMint || quote == kUsdtMint) return 1.0;
+
+    // Any other quote (usually SOL) is priced by its own consolidated record
+    auto it = mints_.find(quote);
+    if (it == mints_.end() || !it->second.computed) return 0.0;
+    return it->second.record.price_usd;
+}
+
+MintRecord MintView::consolidate(const std::string& mint, const MintEntry& entry,
+                                 int64_t now_ms) const {
+    MintRecord rec{};
+    rec.mint = mint;
+    rec.route = entry.route;
+    rec.pool_count = static_cast<int>(entry.pools.size());
+    rec.updated_ms = now_ms;
+
+    double priced_liq = 0.0;
+    double weighted_price = 0.0;
+    double best_cost = 0.0;
+    bool best_degraded = true;
+    std::vector<std::pair<double, double>> priced; // (usd price, liquidity)
+    priced.reserve(entry.pools.size());
+
+    for (const auto& address : entry.pools) {
+        const PoolEntry& pool = pools_.at(address);
+        rec.liq_usd += pool.liq_usd;
+        rec.vol24h_usd += pool.vol24h_usd;
+        if (rec.symbol.empty()) rec.symbol = pool.symbol;
+
+        double usd = pool.price * quote_usd(pool.quote);
+        if (usd > 0 && pool.liq_usd > 0) {
+            weighted_price += usd * pool.liq_usd;
+            priced_liq += pool.liq_usd;
+            priced.emplace_back(usd, pool.liq_usd);
+        }
+
+        double cost = pool.spread_pct + pool.impact_1pct_pct;
+        bool better = rec.best_pool.empty() || cost < best_cost ||
+                      (cost == best_cost && pool.liq_usd > pools_.at(rec.best_pool).liq_usd);
+        if (better) {
+            rec.best_pool = address;
+            rec.best_dex = pool.dex;
+            rec.spread_pct = pool.spread_pct;
+            rec.impact_1pct_pct = pool.impact_1pct_pct;
+            best_cost = cost;
+            best_degraded = pool.degraded;
+        }
+    }
+
+    if (priced_liq > 0) {
+        rec.price_usd = weighted_price / priced_liq;
+
+        double lo = 0.0;
+        double hi = 0.0;
+        bool any = false;
+        for (const auto& [usd, liq] : priced) {
+            if (liq < priced_liq * kSpreadMinLiqShare) continue;
+            lo = any ? std::min(lo, usd) : usd;
+            hi = any ? std::max(hi, usd) : usd;
+            any = true;
+        }
+        rec.xdex_spread_pct = any ? (hi - lo) / rec.price_usd * 100.0 : 0.0;
+    }
+
+    rec.dq = (priced_liq > 0 && !best_degraded) ? "ok" : "degraded";
+    return rec;
+}
+
+std::vector<MintRecord> MintView::take_dirty(int64_t now_ms) {
+    std::vector<MintRecord> out;
+    out.reserve(dirty_.size());
+
+    // Quote mints first so SOL-quoted pools use this tick's SOL price
+    std::vector<std::string> order(dirty_.begin(), dirty_.end());
+    std::stable_partition(order.begin(), order.end(),
+                          [](const std::string& m) { return m == kSolMint; });
+
+    for (const auto& mint : order) {
+        auto it = mints_.find(mint);
+        if (it == mints_.end()) continue;
+
+        it->second.record = consolidate(mint, it->second, now_ms);
+        it->second.computed = true;
+        out.push_back(it->second.record);
+    }
+
+    dirty_.clear();
+    return out;
+}
+
+std::optional<MintRecord> MintView::get(const std::string& mint) const {
+    auto it = mints_.find(mint);
+    if (it == mints_.end() || !it->second.computed) return std::nullopt;
+    return it->second.record;
+}
+
+nlohmann::json MintView::to_json(const MintRecord& rec) {
+    // Same field names as the per-pool update so Analytics parses both alike;
+    // spread/impact are the best pool's, i.e. what an entry would actually pay
+    return {
+        {"mint", rec.mint},
+        {"symbol", rec.symbol},
+        {"price", rec.price_usd},
+        {"liq_usd", rec.liq_usd},
+        {"vol24h_usd", rec.vol24h_usd},
+        {"pools", rec.pool_count},
+        {"xdex_spread_pct", rec.xdex_spread_pct},
+        {"pool", rec.best_pool},
+        {"dex", rec.best_dex},
+        {"spread_pct", rec.spread_pct},
+        {"impact_1pct_pct", rec.impact_1pct_pct},
+        {"age_hours", 0.0},
+        {"route", {
+            {"ok", rec.route.ok},
+            {"hops", rec.route.hops},
+            {"dev_pct", rec.route.dev_pct}
+        }},
+        {"bars", {
+            {"5m", {{"c", rec.price_usd}, {"v_usd", rec.vol24h_usd / 288.0}}},
+            {"15m", {{"c", rec.price_usd}, {"v_usd", rec.vol24h_usd / 96.0}}}
+        }},
+        {"dq", rec.dq},
+        {"ts", util::current_iso8601()}
+    };
+}
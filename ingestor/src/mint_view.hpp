@@ -0,0 +1,84 @@
+#pragma once
+
+#include "normalize.hpp"
+#include "route_graph.hpp"
+#include <cstdint>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+#include <nlohmann/json.hpp>
+
+constexpr const char* kUsdtMint = "Es9vMFrzaCERmJfrF4H2FYD4KCoNkY11McCe8BenwNYB";
+
+// One token across every tracked pool and DEX
+struct MintRecord {
+    std::string mint;
+    std::string symbol;
+    double price_usd;        // liquidity-weighted over pools with a USD-priced quote
+    double liq_usd;          // summed over all pools
+    double vol24h_usd;       // summed over all pools
+    double xdex_spread_pct;  // (max - min) / price_usd across pools holding real depth
+    int pool_count;
+
+    // Cheapest pool to execute in (spread + impact, deeper pool on ties)
+    std::string best_pool;
+    std::string best_dex;
+    double spread_pct;
+    double impact_1pct_pct;
+
+    RouteInfo route;
+    std::string dq;          // "degraded" if no pool could be priced in USD or the best pool is
+    int64_t updated_ms;
+};
+
+// Per-mint consolidation of the per-pool updates. Pools are upserted as they
+// are processed; only mints whose pools changed are recomputed and handed out
+// by take_dirty(), so a tick costs O(pools touched) rather than O(universe).
+class MintView {
+public:
+    void update_pool(const NormalizedPool& pool, const RouteInfo& route, int64_t now_ms);
+    void remove_pool(const std::string& address);
+
+    // Drops pools not updated since cutoff_ms; returns how many were removed
+    size_t prune(int64_t cutoff_ms);
+
+    // Recomputes and returns the mints touched since the last call
+    std::vector<MintRecord> take_dirty(int64_t now_ms);
+
+    std::optional<MintRecord> get(const std::string& mint) const;
+    size_t mint_count() const { return mints_.size(); }
+
+    // Compact message published to STREAM_MINT
+    static nlohmann::json to_json(const MintRecord& rec);
+
+private:
+    struct PoolEntry {
+        std::string mint;
+        std::string quote;
+        std::string dex;
+        std::string symbol;
+        double price;       // in quote units
+        double liq_usd;
+        double vol24h_usd;
+        double spread_pct;
+        double impact_1pct_pct;
+        bool degraded;
+        int64_t last_seen_ms;
+    };
+
+    struct MintEntry {
+        std::unordered_set<std::string> pools;
+        RouteInfo route{false, 0, 0.0};
+        MintRecord record{};
+        bool computed = false;
+    };
+
+    std::unordered_map<std::string, PoolEntry> pools_;
+    std::unordered_map<std::string, MintEntry> mints_;
+    std::unordered_set<std::string> dirty_;
+
+    double quote_usd(const std::string& quote) const;
+    MintRecord consolidate(const std::string& mint, const MintEntry& entry, int64_t now_ms) const;
+};
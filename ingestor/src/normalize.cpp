@@ -13,6 +13,7 @@ NormalizedPool Normalizer::normalize_pool(const nlohmann::json& raw_data,
         pool.address = raw_data.value("address", "unknown");
         pool.mint_base = raw_data.value("mint_base", "");
         pool.mint_quote = raw_data.value("mint_quote", "");
+        pool.symbol = raw_data.value("symbol", "");
         
         // Price and liquidity
         pool.price = raw_data.value("price", 0.0);
@@ -8,6 +8,7 @@ struct NormalizedPool {
     std::string address;
     std::string mint_base;
     std::string mint_quote;
+    std::string symbol;
     std::string dex;
     double price;
     double liq_usd;
@@ -17,6 +18,15 @@ struct NormalizedPool {
     std::string dq; // "ok" or "degraded"
 };
 
+// Stable identity of a pool once it has been registered in Postgres
+struct PoolRegistryEntry {
+    int64_t pool_id;
+    std::string address;
+    std::string mint_base;
+    std::string mint_quote;
+    std::string dex;
+};
+
 class Normalizer {
 public:
     static NormalizedPool normalize_pool(const nlohmann::json& raw_data, 
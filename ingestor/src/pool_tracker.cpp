@@ -0,0 +1,55 @@
+#include "pool_tracker.hpp"
+
+PoolTracker::PoolTracker(int discovery_interval_seconds, double min_liq_usd)
+    : discovery_interval_ms_(discovery_interval_seconds * 1000)
+    , min_liq_usd_(min_liq_usd)
+    , pass_in_progress_(false)
+    , last_pass_completed_ms_(0)
+{}
+
+bool PoolTracker::discovery_due(int64_t now_ms) const {
+    // A pass spans several ticks; keep paging until the cursor runs out
+    if (pass_in_progress_) return true;
+    return last_pass_completed_ms_ == 0 ||
+           now_ms - last_pass_completed_ms_ >= discovery_interval_ms_;
+}
+
+size_t PoolTracker::add_page(const PoolPage& page, int64_t now_ms) {
+    if (!page.ok) return 0; // Retry the same cursor next tick
+
+    size_t added = 0;
+    for (const auto& pool : page.pools) {
+        if (pool.liq_usd >= min_liq_usd_ && tracked_.insert(pool.address).second) {
+            added++;
+        }
+    }
+
+    cursor_ = page.next_cursor;
+    pass_in_progress_ = !cursor_.empty();
+    if (!pass_in_progress_) {
+        last_pass_completed_ms_ = now_ms;
+    }
+
+    return added;
+}
+
+void PoolTracker::track(const std::string& address) {
+    tracked_.insert(address);
+}
+
+void PoolTracker::untrack(const std::string& address) {
+    tracked_.erase(address);
+}
+
+bool PoolTracker::is_tracked(const std::string& address) const {
+    return tracked_.count(address) > 0;
+}
+
+bool PoolTracker::should_untrack(const PoolData& pool) const {
+    // Hysteresis: discovered at min_liq_usd, dropped below half of it
+    return pool.liq_usd < min_liq_usd_ * 0.5;
+}
+
+std::vector<std::string> PoolTracker::addresses() const {
+    return std::vector<std::string>(tracked_.begin(), tracked_.end());
+}
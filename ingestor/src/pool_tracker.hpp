@@ -0,0 +1,37 @@
+#pragma once
+
+#include "rpc_clients/raydium_client.hpp" // PoolData
+#include <string>
+#include <unordered_set>
+#include <vector>
+
+// Tracked pool set for one DEX. Discovery walks the provider's paginated pool
+// list on a slow cadence; every tick only the tracked pools are refreshed.
+class PoolTracker {
+public:
+    PoolTracker(int discovery_interval_seconds, double min_liq_usd);
+
+    bool discovery_due(int64_t now_ms) const;
+    const std::string& cursor() const { return cursor_; }
+
+    // Feed one discovery page; returns how many pools became tracked
+    size_t add_page(const PoolPage& page, int64_t now_ms);
+
+    void track(const std::string& address);
+    void untrack(const std::string& address);
+    bool is_tracked(const std::string& address) const;
+
+    // Drops pools whose refreshed liquidity fell well below the threshold
+    bool should_untrack(const PoolData& pool) const;
+
+    std::vector<std::string> addresses() const;
+    size_t size() const { return tracked_.size(); }
+
+private:
+    int discovery_interval_ms_;
+    double min_liq_usd_;
+    std::string cursor_;
+    bool pass_in_progress_;
+    int64_t last_pass_completed_ms_;
+    std::unordered_set<std::string> tracked_;
+};
@@ -1,22 +0,0 @@
-#include "raydium_client.hpp"
-#include <spdlog/spdlog.h>
-
-RaydiumClient::RaydiumClient(const std::string& base_url, std::shared_ptr<HttpClient> http)
-    : base_url_(base_url), http_(http) {}
-
-std::vector<PoolData> RaydiumClient::get_pools() {
-    std::vector<PoolData> pools;
-    
-    // Simplified - in production would query actual Raydium pools endpoint
-    auto response = http_->get_json(base_url_ + "/pools");
-    
-    if (!response.has_value()) {
-        spdlog::warn("Failed to fetch Raydium pools");
-        return pools;
-    }
-    
-    // Parse response and populate pools
-    // Implementation would depend on actual API format
-    
-    return pools;
-}
\ No newline at end of file
@@ -1,5 +1,7 @@
 #include "redis_bus.hpp"
 #include <spdlog/spdlog.h>
+#include <algorithm>
+#include <iterator>
 
 RedisBus::RedisBus(const std::string& redis_url) {
     try {
@@ -23,6 +25,90 @@ void RedisBus::publish_market_update(const std::string& stream, const nlohmann::
     }
 }
 
+bool RedisBus::save_checkpoint(const std::string& key, const std::string& blob) {
+    try {
+        redis_->hset(key, "bars", blob);
+        return true;
+    } catch (const std::exception& e) {
+        spdlog::error("Failed to save checkpoint to {}: {}", key, e.what());
+        return false;
+    }
+}
+
+std::optional<std::string> RedisBus::load_checkpoint(const std::string& key) {
+    try {
+        auto blob = redis_->hget(key, "bars");
+        if (blob) return *blob;
+    } catch (const std::exception& e) {
+        spdlog::error("Failed to load checkpoint from {}: {}", key, e.what());
+    }
+    return std::nullopt;
+}
+
+bool RedisBus::write_latest_view(const std::string& key, const LatestViewBatch& batch,
+                                 size_t batch_size) {
+    try {
+        auto pipe = redis_->pipeline();
+        batch_size = std::max<size_t>(1, batch_size);
+        
+        for (size_t i = 0; i < batch.upserts.size(); i += batch_size) {
+            auto first = batch.upserts.begin() + i;
+            auto last = batch.upserts.begin() + std::min(i + batch_size, batch.upserts.size());
+            pipe.hset(key, first, last);
+        }
+        for (size_t i = 0; i < batch.deletes.size(); i += batch_size) {
+            auto first = batch.deletes.begin() + i;
+            auto last = batch.deletes.begin() + std::min(i + batch_size, batch.deletes.size());
+            pipe.hdel(key, first, last);
+        }
+        pipe.hset(key, "_version", std::to_string(batch.version));
+        pipe.exec();
+        return true;
+        
+    } catch (const std::exception& e) {
+        spdlog::error("Failed to write latest view to {}: {}", key, e.what());
+        return false;
+    }
+}
+
+std::vector<std::string> RedisBus::latest_view_fields(const std::string& key,
+                                                     uint64_t& version) {
+    std::vector<std::string> fields;
+    version = 0;
+    try {
+        redis_->hkeys(key, std::back_inserter(fields));
+        auto stamp = redis_->hget(key, "_version");
+        if (stamp) version = std::stoull(*stamp);
+    } catch (const std::exception& e) {
+        spdlog::warn("Failed to read latest view {}: {}", key, e.what());
+    }
+    return fields;
+}
+
+std::unordered_set<std::string> RedisBus::priority_mints(const std::string& key,
+                                                        int64_t now_ms) {
+    std::unordered_set<std::string> mints;
+    try {
+        auto now = static_cast<double>(now_ms);
+        redis_->zremrangebyscore(key, sw::redis::RightBoundedInterval<double>(
+            now, sw::redis::BoundType::LEFT_OPEN));
+        redis_->zrangebyscore(key, sw::redis::LeftBoundedInterval<double>(
+            now, sw::redis::BoundType::OPEN), std::inserter(mints, mints.end()));
+    } catch (const std::exception& e) {
+        spdlog::debug("Failed to read priority mints from {}: {}", key, e.what());
+    }
+    return mints;
+}
+
+int64_t RedisBus::stream_length(const std::string& stream) {
+    try {
+        return redis_->xlen(stream);
+    } catch (const std::exception& e) {
+        spdlog::debug("XLEN {} failed: {}", stream, e.what());
+        return -1;
+    }
+}
+
 bool RedisBus::ping() {
     try {
         redis_->ping();
@@ -1,7 +1,12 @@
 #pragma once
 
+#include "latest_view.hpp"
+#include <cstdint>
 #include <string>
 #include <memory>
+#include <optional>
+#include <unordered_set>
+#include <vector>
 #include <nlohmann/json.hpp>
 #include <sw/redis++/redis++.h>
 
@@ -10,6 +15,26 @@ public:
     explicit RedisBus(const std::string& redis_url);
     
     void publish_market_update(const std::string& stream, const nlohmann::json& data);
+    
+    // Binary checkpoint blob stored in a hash field
+    bool save_checkpoint(const std::string& key, const std::string& blob);
+    std::optional<std::string> load_checkpoint(const std::string& key);
+    
+    // Applies one tick of latest-view changes to the hash at key, pipelined in
+    // chunks of batch_size fields, then stamps the "_version" field
+    bool write_latest_view(const std::string& key, const LatestViewBatch& batch,
+                           size_t batch_size);
+    
+    // Field names and "_version" of an existing latest-view hash (0 if absent)
+    std::vector<std::string> latest_view_fields(const std::string& key, uint64_t& version);
+    
+    // Members of the priority sorted set whose expiry score is still in the future;
+    // expired members are trimmed on the way
+    std::unordered_set<std::string> priority_mints(const std::string& key, int64_t now_ms);
+    
+    // XLEN of the stream, -1 if Redis is unreachable
+    int64_t stream_length(const std::string& stream);
+    
     bool ping();
     
 private:
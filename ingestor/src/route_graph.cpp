@@ -0,0 +1,136 @@
+#include "route_graph.hpp"
+#include <limits>
+
+namespace {
+constexpr double kUnreachable = std::numeric_limits<double>::infinity();
+}
+
+RouteGraph::RouteGraph(int max_hops, double ref_trade_usd, double min_liq_usd)
+    : max_hops_(max_hops)
+    , ref_trade_usd_(ref_trade_usd)
+    , min_liq_usd_(min_liq_usd)
+{}
+
+uint32_t RouteGraph::intern(const std::string& mint) {
+    auto it = mint_ids_.find(mint);
+    if (it != mint_ids_.end()) return it->second;
+
+    auto id = static_cast<uint32_t>(mint_names_.size());
+    mint_ids_.emplace(mint, id);
+    mint_names_.push_back(mint);
+    return id;
+}
+
+void RouteGraph::upsert_pool(const std::string& address, const std::string& mint_base,
+                             const std::string& mint_quote, double price, double liq_usd,
+                             int64_t now_ms) {
+    if (mint_base.empty() || mint_quote.empty() || mint_base == mint_quote ||
+        price <= 0 || liq_usd < min_liq_usd_ || liq_usd <= 0) {
+        remove_pool(address);
+        return;
+    }
+
+    // Impact of the reference trade against the quote-side reserve (~half the TVL)
+    double cost_pct = 100.0 * ref_trade_usd_ / (liq_usd / 2.0);
+
+    auto it = edge_index_.find(address);
+    if (it != edge_index_.end()) {
+        Edge& edge = edges_[it->second];
+        edge.a = intern(mint_base);
+        edge.b = intern(mint_quote);
+        edge.cost_pct = cost_pct;
+        edge.last_seen_ms = now_ms;
+        return;
+    }
+
+    edge_index_.emplace(address, edges_.size());
+    edges_.push_back(Edge{intern(mint_base), intern(mint_quote), cost_pct, now_ms, address});
+}
+
+void RouteGraph::remove_pool(const std::string& address) {
+    auto it = edge_index_.find(address);
+    if (it == edge_index_.end()) return;
+
+    // Swap-remove keeps the edge list dense for the relaxation pass
+    size_t slot = it->second;
+    edge_index_.erase(it);
+    if (slot != edges_.size() - 1) {
+        edges_[slot] = std::move(edges_.back());
+        edge_index_[edges_[slot].address] = slot;
+    }
+    edges_.pop_back();
+}
+
+size_t RouteGraph::prune(int64_t cutoff_ms) {
+    std::vector<std::string> stale;
+    for (const auto& edge : edges_) {
+        if (edge.last_seen_ms < cutoff_ms) stale.push_back(edge.address);
+    }
+    for (const auto& address : stale) {
+        remove_pool(address);
+    }
+    return stale.size();
+}
+
+void RouteGraph::relax_from(uint32_t target, std::vector<Hop>& out) const {
+    out.assign(mint_names_.size(), Hop{kUnreachable, -1});
+    out[target] = Hop{0.0, 0};
+
+    // Round k only extends routes found in round k-1, so no route exceeds max_hops
+    std::vector<Hop> prev;
+    for (int round = 1; round <= max_hops_; round++) {
+        prev = out;
+        bool changed = false;
+
+        for (const auto& edge : edges_) {
+            const Hop& via_b = prev[edge.b];
+            if (via_b.hops >= 0 && via_b.cost_pct + edge.cost_pct < out[edge.a].cost_pct) {
+                out[edge.a] = Hop{via_b.cost_pct + edge.cost_pct, via_b.hops + 1};
+                changed = true;
+            }
+            const Hop& via_a = prev[edge.a];
+            if (via_a.hops >= 0 && via_a.cost_pct + edge.cost_pct < out[edge.b].cost_pct) {
+                out[edge.b] = Hop{via_a.cost_pct + edge.cost_pct, via_a.hops + 1};
+                changed = true;
+            }
+        }
+
+        if (!changed) break;
+    }
+}
+
+void RouteGraph::recompute() {
+    auto usdc = mint_ids_.find(kUsdcMint);
+    auto sol = mint_ids_.find(kSolMint);
+
+    if (usdc != mint_ids_.end()) relax_from(usdc->second, to_usdc_);
+    else to_usdc_.assign(mint_names_.size(), Hop{kUnreachable, -1});
+
+    if (sol != mint_ids_.end()) relax_from(sol->second, to_sol_);
+    else to_sol_.assign(mint_names_.size(), Hop{kUnreachable, -1});
+}
+
+RouteInfo RouteGraph::lookup(const std::vector<Hop>& table, const std::string& mint) const {
+    auto it = mint_ids_.find(mint);
+    if (it == mint_ids_.end() || it->second >= table.size() || table[it->second].hops < 0) {
+        return RouteInfo{false, 0, 0.0};
+    }
+    const Hop& hop = table[it->second];
+    return RouteInfo{true, hop.hops, hop.cost_pct};
+}
+
+RouteInfo RouteGraph::route_to_usdc(const std::string& mint) const {
+    return lookup(to_usdc_, mint);
+}
+
+RouteInfo RouteGraph::route_to_sol(const std::string& mint) const {
+    return lookup(to_sol_, mint);
+}
+
+RouteInfo RouteGraph::best_route(const std::string& mint) const {
+    RouteInfo usdc = route_to_usdc(mint);
+    RouteInfo sol = route_to_sol(mint);
+    if (!usdc.ok) return sol;
+    if (!sol.ok) return usdc;
+    return sol.dev_pct < usdc.dev_pct ? sol : usdc;
+}
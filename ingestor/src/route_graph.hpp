@@ -0,0 +1,76 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+struct RouteInfo {
+    bool ok;
+    int hops;
+    double dev_pct;
+};
+
+constexpr const char* kUsdcMint = "EPjFWdd5AufqSSqeM2qN1xzybapC8G4wEGGkZwyTDt1v";
+constexpr const char* kSolMint = "So11111111111111111111111111111111111111112";
+
+// Token graph built from the pools the ingestor already refreshes: mints are
+// nodes, pools are undirected edges weighted by the price impact of a
+// reference-size trade (XYK: 100 * trade / (liq / 2) percent per hop).
+// recompute() runs a hop-bounded Bellman-Ford from each quote target, giving
+// every mint its cheapest route in one pass instead of one quote per mint.
+class RouteGraph {
+public:
+    RouteGraph(int max_hops, double ref_trade_usd, double min_liq_usd);
+
+    // Insert or update the edge for one pool; unusable pools are dropped
+    void upsert_pool(const std::string& address, const std::string& mint_base,
+                     const std::string& mint_quote, double price, double liq_usd,
+                     int64_t now_ms);
+    void remove_pool(const std::string& address);
+
+    // Drops pools not seen since cutoff_ms; returns how many were removed
+    size_t prune(int64_t cutoff_ms);
+
+    // Batch pass: cheapest route of at most max_hops to USDC and to SOL for every mint
+    void recompute();
+
+    RouteInfo route_to_usdc(const std::string& mint) const;
+    RouteInfo route_to_sol(const std::string& mint) const;
+
+    // Whichever of the USDC and SOL routes has the lower deviation
+    RouteInfo best_route(const std::string& mint) const;
+
+    size_t mint_count() const { return mint_names_.size(); }
+    size_t pool_count() const { return edges_.size(); }
+
+private:
+    struct Edge {
+        uint32_t a;
+        uint32_t b;
+        double cost_pct;
+        int64_t last_seen_ms;
+        std::string address;
+    };
+
+    struct Hop {
+        double cost_pct;
+        int hops;
+    };
+
+    int max_hops_;
+    double ref_trade_usd_;
+    double min_liq_usd_;
+
+    std::unordered_map<std::string, uint32_t> mint_ids_;
+    std::vector<std::string> mint_names_;
+    std::vector<Edge> edges_;
+    std::unordered_map<std::string, size_t> edge_index_; // pool address -> edges_ slot
+
+    std::vector<Hop> to_usdc_;
+    std::vector<Hop> to_sol_;
+
+    uint32_t intern(const std::string& mint);
+    void relax_from(uint32_t target, std::vector<Hop>& out) const;
+    RouteInfo lookup(const std::vector<Hop>& table, const std::string& mint) const;
+};
@@ -0,0 +1,128 @@
+#include "jupiter_client.hpp"
+#include <spdlog/spdlog.h>
+#include <algorithm>
+#include <cmath>
+#include <future>
+#include <unordered_set>
+
+JupiterClient::JupiterClient(const std::string& price_url, std::shared_ptr<HttpClient> http,
+                             size_t batch_size, int concurrency)
+    : price_url_(price_url)
+    , http_(http)
+    , batch_size_(std::clamp<size_t>(batch_size, 1, kMaxIdsPerRequest))
+    , concurrency_(std::max(1, concurrency))
+    , tick_(0)
+    , failed_requests_(0)
+{}
+
+size_t JupiterClient::refresh(const std::vector<std::string>& mints, uint64_t tick) {
+    if (tick != tick_) {
+        prices_.clear();
+        failed_requests_ = 0;
+        tick_ = tick;
+    }
+
+    std::vector<std::string> missing;
+    std::unordered_set<std::string> seen;
+    for (const auto& mint : mints) {
+        if (!mint.empty() && !prices_.count(mint) && seen.insert(mint).second) {
+            missing.push_back(mint);
+        }
+    }
+    if (missing.empty()) return 0;
+
+    auto shards = shard(missing, batch_size_);
+
+    // At most concurrency_ shards in flight; HttpClient's host guard still applies
+    for (size_t i = 0; i < shards.size(); i += static_cast<size_t>(concurrency_)) {
+        size_t end = std::min(shards.size(), i + static_cast<size_t>(concurrency_));
+        std::vector<std::future<std::optional<nlohmann::json>>> inflight;
+        for (size_t s = i; s < end; s++) {
+            std::string url = build_url(price_url_, shards[s]);
+            inflight.push_back(std::async(std::launch::async, [this, url]() {
+                return http_->get_json(url);
+            }));
+        }
+
+        for (auto& f : inflight) {
+            auto body = f.get();
+            if (!body) {
+                failed_requests_++;
+                continue;
+            }
+            for (auto& [mint, price] : parse_prices(*body)) {
+                prices_[mint] = price;
+            }
+        }
+    }
+
+    spdlog::debug("Jupiter priced {} of {} mints in {} requests",
+                  prices_.size(), seen.size(), shards.size());
+    return shards.size();
+}
+
+std::optional<double> JupiterClient::price(const std::string& mint) const {
+    auto it = prices_.find(mint);
+    if (it == prices_.end()) return std::nullopt;
+    return it->second;
+}
+
+std::optional<double> JupiterClient::deviation_pct(const std::string& mint_base,
+                                                   const std::string& mint_quote,
+                                                   double pool_price) const {
+    auto base_usd = price(mint_base);
+    auto quote_usd = price(mint_quote);
+    if (!base_usd || !quote_usd || pool_price <= 0) return std::nullopt;
+
+    return deviation_pct(pool_price, *base_usd, *quote_usd);
+}
+
+double JupiterClient::deviation_pct(double pool_price, double base_usd, double quote_usd) {
+    return std::abs(pool_price * quote_usd - base_usd) / base_usd * 100.0;
+}
+
+std::vector<std::vector<std::string>> JupiterClient::shard(const std::vector<std::string>& mints,
+                                                           size_t batch_size) {
+    std::vector<std::vector<std::string>> shards;
+    batch_size = std::clamp<size_t>(batch_size, 1, kMaxIdsPerRequest);
+    for (size_t i = 0; i < mints.size(); i += batch_size) {
+        auto end = std::min(mints.size(), i + batch_size);
+        shards.emplace_back(mints.begin() + i, mints.begin() + end);
+    }
+    return shards;
+}
+
+std::string JupiterClient::build_url(const std::string& price_url,
+                                     const std::vector<std::string>& mints) {
+    std::string url = price_url;
+    url += price_url.find('?') == std::string::npos ? "?ids=" : "&ids=";
+    for (size_t i = 0; i < mints.size(); i++) {
+        if (i > 0) url += ',';
+        url += mints[i];
+    }
+    return url;
+}
+
+std::unordered_map<std::string, double> JupiterClient::parse_prices(const nlohmann::json& body) {
+    std::unordered_map<std::string, double> prices;
+    if (!body.is_object() || !body.contains("data") || !body["data"].is_object()) {
+        return prices;
+    }
+
+    for (const auto& [mint, entry] : body["data"].items()) {
+        if (!entry.is_object() || !entry.contains("price")) continue;
+
+        const auto& p = entry["price"];
+        double value = 0.0;
+        try {
+            if (p.is_string()) value = std::stod(p.get<std::string>());
+            else if (p.is_number()) value = p.get<double>();
+        } catch (const std::exception&) {
+            continue;
+        }
+        if (value > 0 && std::isfinite(value)) {
+            prices[mint] = value;
+        }
+    }
+    return prices;
+}
@@ -0,0 +1,53 @@
+#pragma once
+#include "../http_client.hpp"
+#include <cstdint>
+#include <memory>
+#include <optional>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+// Batched USD prices from the Jupiter price API, used as an independent
+// cross-check of DEX pool prices. One request prices up to 100 mints; the
+// universe is sharded across a few concurrent requests and cached per tick.
+class JupiterClient {
+public:
+    static constexpr size_t kMaxIdsPerRequest = 100;
+
+    JupiterClient(const std::string& price_url, std::shared_ptr<HttpClient> http,
+                  size_t batch_size, int concurrency);
+
+    // Prices every mint not already priced in this tick; returns requests made
+    size_t refresh(const std::vector<std::string>& mints, uint64_t tick);
+
+    std::optional<double> price(const std::string& mint) const;
+    size_t priced() const { return prices_.size(); }
+    size_t failed_requests() const { return failed_requests_; }
+
+    // |pool USD price - aggregator price| / aggregator price in %, where the pool
+    // price (quote units) is converted with the quote mint's aggregator price.
+    // nullopt when either mint is unpriced.
+    std::optional<double> deviation_pct(const std::string& mint_base,
+                                        const std::string& mint_quote,
+                                        double pool_price) const;
+
+    static double deviation_pct(double pool_price, double base_usd, double quote_usd);
+
+    static std::vector<std::vector<std::string>> shard(const std::vector<std::string>& mints,
+                                                       size_t batch_size);
+    static std::string build_url(const std::string& price_url,
+                                 const std::vector<std::string>& mints);
+
+    // {"data": {"<mint>": {"price": "1.23", ...} | null}}; prices may be strings
+    static std::unordered_map<std::string, double> parse_prices(const nlohmann::json& body);
+
+private:
+    std::string price_url_;
+    std::shared_ptr<HttpClient> http_;
+    size_t batch_size_;
+    int concurrency_;
+
+    uint64_t tick_;
+    std::unordered_map<std::string, double> prices_;
+    size_t failed_requests_;
+};
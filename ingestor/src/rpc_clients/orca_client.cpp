@@ -0,0 +1,78 @@
+#include "orca_client.hpp"
+#include <spdlog/spdlog.h>
+
+OrcaClient::OrcaClient(const std::string& base_url, std::shared_ptr<HttpClient> http)
+    : base_url_(base_url), http_(http) {}
+
+std::vector<PoolData> OrcaClient::parse_pools(const nlohmann::json& items) {
+    std::vector<PoolData> pools;
+    if (!items.is_array()) return pools;
+    pools.reserve(items.size());
+    
+    for (const auto& item : items) {
+        if (!item.is_object()) continue;
+        
+        PoolData pool;
+        pool.address = item.value("address", "");
+        if (pool.address.empty()) continue;
+        
+        pool.mint_base = item.contains("tokenA") ? item["tokenA"].value("address", "") : "";
+        pool.mint_quote = item.contains("tokenB") ? item["tokenB"].value("address", "") : "";
+        pool.symbol_base = item.contains("tokenA") ? item["tokenA"].value("symbol", "") : "";
+        pool.price = item.value("price", 0.0);
+        pool.liq_usd = item.value("tvlUsdc", 0.0);
+        pool.vol24h_usd = 0.0;
+        if (item.contains("stats") && item["stats"].contains("24h")) {
+            pool.vol24h_usd = item["stats"]["24h"].value("volume", 0.0);
+        }
+        pool.reserve_base = item.value("tokenBalanceA", 0.0);
+        pool.reserve_quote = item.value("tokenBalanceB", 0.0);
+        
+        pools.push_back(std::move(pool));
+    }
+    
+    return pools;
+}
+
+PoolPage OrcaClient::discover_pools(const std::string& cursor, int page_size) {
+    PoolPage page{{}, "", false};
+    
+    std::string url = base_url_ + "/v2/solana/pools?sortBy=tvl&size=" + std::to_string(page_size);
+    if (!cursor.empty()) {
+        url += "&next=" + cursor;
+    }
+    
+    auto response = http_->get_json(url);
+    
+    if (!response.has_value() || !response->contains("data")) {
+        spdlog::warn("Failed to fetch Orca pool page");
+        return page;
+    }
+    
+    page.pools = parse_pools((*response)["data"]);
+    page.ok = true;
+    if (response->contains("meta") && (*response)["meta"]["next"].is_string()) {
+        page.next_cursor = (*response)["meta"]["next"].get<std::string>();
+    }
+    
+    return page;
+}
+
+std::vector<PoolData> OrcaClient::refresh_pools(const std::vector<std::string>& addresses) {
+    if (addresses.empty()) return {};
+    
+    std::string joined;
+    for (const auto& addr : addresses) {
+        if (!joined.empty()) joined += ',';
+        joined += addr;
+    }
+    
+    auto response = http_->get_json(base_url_ + "/v2/solana/pools?addresses=" + joined);
+    
+    if (!response.has_value() || !response->contains("data")) {
+        spdlog::warn("Failed to refresh {} Orca pools", addresses.size());
+        return {};
+    }
+    
+    return parse_pools((*response)["data"]);
+}
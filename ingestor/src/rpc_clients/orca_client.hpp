@@ -7,8 +7,11 @@
 class OrcaClient {
 public:
     explicit OrcaClient(const std::string& base_url, std::shared_ptr<HttpClient> http);
-    std::vector<PoolData> get_pools();
+    PoolPage discover_pools(const std::string& cursor, int page_size);
+    std::vector<PoolData> refresh_pools(const std::vector<std::string>& addresses);
+    
+    static std::vector<PoolData> parse_pools(const nlohmann::json& items);
 private:
     std::string base_url_;
     std::shared_ptr<HttpClient> http_;
-};
\ No newline at end of file
+};
@@ -0,0 +1,75 @@
+#include "raydium_client.hpp"
+#include <spdlog/spdlog.h>
+
+RaydiumClient::RaydiumClient(const std::string& base_url, std::shared_ptr<HttpClient> http)
+    : base_url_(base_url), http_(http) {}
+
+std::vector<PoolData> RaydiumClient::parse_pools(const nlohmann::json& items) {
+    std::vector<PoolData> pools;
+    if (!items.is_array()) return pools;
+    pools.reserve(items.size());
+
+    for (const auto& item : items) {
+        if (!item.is_object()) continue;
+
+        PoolData pool;
+        pool.address = item.value("id", "");
+        if (pool.address.empty()) continue;
+
+        pool.mint_base = item.contains("mintA") ? item["mintA"].value("address", "") : "";
+        pool.mint_quote = item.contains("mintB") ? item["mintB"].value("address", "") : "";
+        pool.symbol_base = item.contains("mintA") ? item["mintA"].value("symbol", "") : "";
+        pool.price = item.value("price", 0.0);
+        pool.liq_usd = item.value("tvl", 0.0);
+        pool.vol24h_usd = item.contains("day") ? item["day"].value("volume", 0.0) : 0.0;
+        pool.reserve_base = item.value("mintAmountA", 0.0);
+        pool.reserve_quote = item.value("mintAmountB", 0.0);
+
+        pools.push_back(std::move(pool));
+    }
+
+    return pools;
+}
+
+PoolPage RaydiumClient::discover_pools(const std::string& cursor, int page_size) {
+    PoolPage page{{}, "", false};
+
+    // Raydium paginates by page number; the cursor is the page to fetch
+    int page_no = cursor.empty() ? 1 : std::stoi(cursor);
+    auto response = http_->get_json(base_url_ + "/pools/info/list?poolSortField=liquidity"
+                                    "&sortType=desc&pageSize=" + std::to_string(page_size) +
+                                    "&page=" + std::to_string(page_no));
+
+    if (!response.has_value() || !response->contains("data")) {
+        spdlog::warn("Failed to fetch Raydium pool page {}", page_no);
+        return page;
+    }
+
+    const auto& data = (*response)["data"];
+    page.pools = parse_pools(data.value("data", nlohmann::json::array()));
+    page.ok = true;
+    if (data.value("hasNextPage", false)) {
+        page.next_cursor = std::to_string(page_no + 1);
+    }
+
+    return page;
+}
+
+std::vector<PoolData> RaydiumClient::refresh_pools(const std::vector<std::string>& addresses) {
+    if (addresses.empty()) return {};
+
+    std::string ids;
+    for (const auto& addr : addresses) {
+        if (!ids.empty()) ids += ',';
+        ids += addr;
+    }
+
+    auto response = http_->get_json(base_url_ + "/pools/info/ids?ids=" + ids);
+
+    if (!response.has_value() || !response->contains("data")) {
+        spdlog::warn("Failed to refresh {} Raydium pools", addresses.size());
+        return {};
+    }
+
+    return parse_pools((*response)["data"]);
+}
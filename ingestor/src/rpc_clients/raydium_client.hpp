@@ -0,0 +1,40 @@
+#pragma once
+#include "../http_client.hpp"
+#include <memory>
+#include <vector>
+
+struct PoolData {
+    std::string address;
+    std::string mint_base;
+    std::string mint_quote;
+    std::string symbol_base; // empty if the provider does not report it
+    double price;
+    double liq_usd;
+    double vol24h_usd;
+    double reserve_base;  // 0 if the provider does not report reserves
+    double reserve_quote;
+};
+
+// One page of a cursor-based discovery scan; empty next_cursor ends the pass
+struct PoolPage {
+    std::vector<PoolData> pools;
+    std::string next_cursor;
+    bool ok;
+};
+
+class RaydiumClient {
+public:
+    explicit RaydiumClient(const std::string& base_url, std::shared_ptr<HttpClient> http);
+
+    // Slow path: walk the provider's pool list one page at a time
+    PoolPage discover_pools(const std::string& cursor, int page_size);
+
+    // Fast path: current state of the given pools only
+    std::vector<PoolData> refresh_pools(const std::vector<std::string>& addresses);
+
+    static std::vector<PoolData> parse_pools(const nlohmann::json& items);
+
+private:
+    std::string base_url_;
+    std::shared_ptr<HttpClient> http_;
+};
@@ -41,4 +41,27 @@ int random_jitter(int min_ms, int max_ms) {
     return dis(gen);
 }
 
+uint64_t fnv1a_64(const std::string& s) {
+    return fnv1a_64_update(kFnv1aOffset, s.data(), s.size());
+}
+
+uint64_t fnv1a_64_update(uint64_t hash, const void* data, size_t n) {
+    const auto* p = static_cast<const unsigned char*>(data);
+    for (size_t i = 0; i < n; i++) {
+        hash ^= p[i];
+        hash *= 1099511628211ULL;
+    }
+    return hash;
+}
+
+int mint_partition(const std::string& mint, int partitions) {
+    if (partitions <= 1) return 0;
+    return static_cast<int>(fnv1a_64(mint) % static_cast<uint64_t>(partitions));
+}
+
+std::string partition_stream(const std::string& base, int partition, int partitions) {
+    if (partitions <= 1) return base;
+    return base + "." + std::to_string(partition);
+}
+
 } // namespace util
\ No newline at end of file
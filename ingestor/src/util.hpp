@@ -3,6 +3,7 @@
 #include <string>
 #include <vector>
 #include <chrono>
+#include <cstdint>
 #include <random>
 
 namespace util {
@@ -10,4 +11,13 @@ namespace util {
     std::vector<std::string> split(const std::string& str, char delim);
     int64_t current_timestamp_ms();
     int random_jitter(int min_ms, int max_ms);
+    // Stable across processes and builds, unlike std::hash
+    uint64_t fnv1a_64(const std::string& s);
+    // Incremental form: start from kFnv1aOffset and feed the bytes in pieces
+    constexpr uint64_t kFnv1aOffset = 14695981039346656037ULL;
+    uint64_t fnv1a_64_update(uint64_t hash, const void* data, size_t n);
+    // Stream carrying mint's updates when the per-mint stream is split into
+    // partitions by FNV-1a(mint); a single partition keeps the base name
+    int mint_partition(const std::string& mint, int partitions);
+    std::string partition_stream(const std::string& base, int partition, int partitions);
 }
\ No newline at end of file
@@ -0,0 +1,97 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../src/budget_planner.hpp"
+#include <algorithm>
+
+namespace {
+
+PoolData make_pool(const std::string& address, const std::string& mint, double price,
+                   double liq_usd) {
+    return PoolData{address, mint, "quote", "", price, liq_usd, 0.0, 0.0, 0.0};
+}
+
+const BudgetTierStats& tier(const BudgetPlanner& planner, const std::string& name) {
+    const auto& report = planner.report();
+    return *std::find_if(report.begin(), report.end(),
+                         [&](const BudgetTierStats& t) { return t.tier == name; });
+}
+
+} // namespace
+
+TEST_CASE("Budget planner allowance", "[budget_planner]") {
+    SECTION("Per-tick allowance with one tick of carry-over") {
+        BudgetPlanner planner(120, 60); // 120 requests per 60s tick
+        planner.begin_tick();
+        REQUIRE(planner.available() == 120);
+        planner.begin_tick();
+        planner.begin_tick();
+        REQUIRE(planner.available() == 240);
+
+        planner.spend(250);
+        REQUIRE(planner.available() == 0);
+        planner.begin_tick();
+        REQUIRE(planner.available() == 110);
+    }
+
+    SECTION("Unlimited plans every tracked pool") {
+        BudgetPlanner planner(0, 60);
+        REQUIRE(planner.unlimited());
+        auto planned = planner.plan({"a", "b", "c"}, 3, 0);
+        REQUIRE(planned.size() == 3);
+    }
+}
+
+TEST_CASE("Budget planner ranking", "[budget_planner]") {
+    BudgetPlanner planner(60, 60);
+    int64_t now = 1000000000000;
+    std::vector<std::string> tracked = {"dead", "deep", "held", "fresh"};
+
+    planner.observe(make_pool("dead", "M1", 1.0, 30000.0), now);
+    planner.observe(make_pool("deep", "M2", 1.0, 10000000.0), now);
+    planner.observe(make_pool("held", "M3", 1.0, 30000.0), now);
+
+    SECTION("Pools never refreshed go first") {
+        auto planned = planner.plan(tracked, 1, now + 60000);
+        REQUIRE(planned == std::vector<std::string>{"fresh"});
+    }
+
+    SECTION("Value orders pools of equal age") {
+        planner.set_priority_mints({"M3"});
+        planner.observe(make_pool("fresh", "M4", 1.0, 30000.0), now);
+
+        auto planned = planner.plan(tracked, 4, now + 60000);
+        REQUIRE(planned[0] == "held");
+        REQUIRE(planned[1] == "deep");
+        REQUIRE(planner.value("held") > planner.value("deep"));
+        REQUIRE(planner.value("deep") > planner.value("dead"));
+    }
+
+    SECTION("Price movement raises value") {
+        double before = planner.value("dead");
+        planner.observe(make_pool("dead", "M1", 1.05, 30000.0), now + 60000);
+        REQUIRE(planner.value("dead") > before);
+    }
+
+    SECTION("Stale low-value pools eventually outrank fresh deep pools") {
+        planner.observe(make_pool("deep", "M2", 1.0, 10000000.0), now + 3600000);
+        auto planned = planner.plan({"dead", "deep"}, 1, now + 3600000);
+        REQUIRE(planned == std::vector<std::string>{"dead"});
+    }
+
+    SECTION("Report covers each tier") {
+        planner.set_priority_mints({"M3"});
+        planner.plan(tracked, 2, now + 30000);
+
+        REQUIRE(tier(planner, "new").pools == 1);
+        REQUIRE(tier(planner, "new").planned == 1);
+        REQUIRE(tier(planner, "priority").planned == 1);
+        REQUIRE(tier(planner, "deep").pools == 1);
+        REQUIRE(tier(planner, "deep").planned == 0);
+        REQUIRE(tier(planner, "shallow").max_age_s == 30.0);
+    }
+
+    SECTION("Untracked pools are forgotten") {
+        planner.plan({"deep"}, 1, now);
+        REQUIRE(planner.value("dead") == 0.0);
+        REQUIRE(planner.value("deep") > 0.0);
+    }
+}
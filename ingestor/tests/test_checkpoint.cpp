@@ -0,0 +1,56 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../src/checkpoint.hpp"
+
+TEST_CASE("Bar checkpoint", "[checkpoint]") {
+    int64_t base_ts = 1000000000000;
+
+    BarSynthesizer synth(300);
+    synth.add_tick(PriceTick{100.0, 500.0, base_ts});
+    synth.add_tick(PriceTick{110.0, 600.0, base_ts + 60000});
+    synth.add_tick(PriceTick{95.0, 400.0, base_ts + 120000});
+
+    IngestCheckpoint ckpt;
+    ckpt.written_ms = base_ts + 150000;
+    ckpt.bar_interval_5m = 300;
+    ckpt.bar_interval_15m = 900;
+    ckpt.pools.push_back(PoolCheckpoint{
+        PoolRegistryEntry{42, "pool123", "base_mint", "quote_mint", "raydium"},
+        synth.export_state(),
+        BarSynthesizer::State{0, {}}
+    });
+
+    SECTION("Round trip preserves registry and open bars") {
+        auto decoded = Checkpoint::decode(Checkpoint::encode(ckpt));
+
+        REQUIRE(decoded.has_value());
+        REQUIRE(decoded->written_ms == ckpt.written_ms);
+        REQUIRE(decoded->pools.size() == 1);
+        REQUIRE(decoded->pools[0].pool.pool_id == 42);
+        REQUIRE(decoded->pools[0].pool.address == "pool123");
+        REQUIRE(decoded->pools[0].pool.dex == "raydium");
+        REQUIRE(decoded->pools[0].bar_15m.ticks.empty());
+
+        BarSynthesizer restored(300);
+        restored.restore_state(decoded->pools[0].bar_5m);
+
+        auto current = restored.get_current_bar();
+        REQUIRE(current.open == 100.0);
+        REQUIRE(current.high == 110.0);
+        REQUIRE(current.low == 95.0);
+        REQUIRE(current.volume_usd == 1500.0);
+    }
+
+    SECTION("Corrupted checkpoint is rejected") {
+        auto blob = Checkpoint::encode(ckpt);
+        blob[blob.size() / 2] ^= 0x5a;
+
+        REQUIRE_FALSE(Checkpoint::decode(blob).has_value());
+    }
+
+    SECTION("Truncated checkpoint is rejected") {
+        auto blob = Checkpoint::encode(ckpt);
+
+        REQUIRE_FALSE(Checkpoint::decode(blob.substr(0, blob.size() - 20)).has_value());
+        REQUIRE_FALSE(Checkpoint::decode("").has_value());
+    }
+}
@@ -0,0 +1,6 @@
+#pragma once
+
+#include <cmath>
+
+// Equal to within 1e-9
+inline bool near(double a, double b) { return std::abs(a - b) < 1e-9; }
@@ -0,0 +1,92 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../src/host_guard.hpp"
+
+TEST_CASE("Circuit breaker", "[host_guard]") {
+    CircuitBreaker breaker(3, 1000);
+    int64_t now = 1000000;
+
+    SECTION("Opens after consecutive failures") {
+        for (int i = 0; i < 3; i++) {
+            REQUIRE(breaker.allow(now));
+            breaker.on_failure(now);
+        }
+        REQUIRE(breaker.state() == BreakerState::Open);
+        REQUIRE_FALSE(breaker.allow(now + 500));
+    }
+
+    SECTION("Half-open admits a single probe and closes on success") {
+        for (int i = 0; i < 3; i++) breaker.on_failure(now);
+
+        REQUIRE(breaker.allow(now + 1000));
+        REQUIRE(breaker.state() == BreakerState::HalfOpen);
+        REQUIRE_FALSE(breaker.allow(now + 1001));
+
+        breaker.on_success();
+        REQUIRE(breaker.state() == BreakerState::Closed);
+        REQUIRE(breaker.allow(now + 1002));
+    }
+
+    SECTION("Failed probe reopens the breaker") {
+        for (int i = 0; i < 3; i++) breaker.on_failure(now);
+
+        REQUIRE(breaker.allow(now + 1000));
+        breaker.on_failure(now + 1000);
+        REQUIRE(breaker.state() == BreakerState::Open);
+        REQUIRE_FALSE(breaker.allow(now + 1500));
+    }
+}
+
+TEST_CASE("Token bucket", "[host_guard]") {
+    TokenBucket bucket(10.0, 2.0); // 1 token per 100ms
+    int64_t now = 1000000;
+
+    SECTION("Burst then refill") {
+        REQUIRE(bucket.try_take(now));
+        REQUIRE(bucket.try_take(now));
+        REQUIRE_FALSE(bucket.try_take(now));
+        REQUIRE(bucket.wait_ms(now) == 100);
+        REQUIRE(bucket.try_take(now + 100));
+    }
+
+    SECTION("Retry-After blocks the budget") {
+        bucket.block_until(now + 5000);
+        REQUIRE_FALSE(bucket.try_take(now + 1000));
+        REQUIRE(bucket.wait_ms(now + 1000) == 4000);
+        REQUIRE(bucket.try_take(now + 5100));
+    }
+}
+
+TEST_CASE("Host guard admission", "[host_guard]") {
+    HostPolicy policy;
+    policy.failure_threshold = 2;
+    policy.open_ms = 1000;
+    policy.max_in_flight = 1;
+    policy.rate_per_sec = 100.0;
+    policy.burst = 10.0;
+
+    HostGuard guard(policy);
+    int64_t now = 1000000;
+
+    SECTION("In-flight limit") {
+        REQUIRE(guard.try_acquire(now) == HostGuard::Admit::Ok);
+        REQUIRE(guard.try_acquire(now) == HostGuard::Admit::Saturated);
+        guard.release(now, true);
+        REQUIRE(guard.try_acquire(now) == HostGuard::Admit::Ok);
+    }
+
+    SECTION("Broken host fails fast") {
+        for (int i = 0; i < 2; i++) {
+            REQUIRE(guard.try_acquire(now) == HostGuard::Admit::Ok);
+            guard.release(now, false);
+        }
+        REQUIRE(guard.try_acquire(now) == HostGuard::Admit::BreakerOpen);
+        REQUIRE(guard.try_acquire(now + 1000) == HostGuard::Admit::Ok);
+    }
+
+    SECTION("429 pauses the budget") {
+        REQUIRE(guard.try_acquire(now) == HostGuard::Admit::Ok);
+        guard.release(now, false, 2000);
+        REQUIRE(guard.try_acquire(now + 100) == HostGuard::Admit::RateLimited);
+        REQUIRE(guard.budget_wait_ms(now + 100) == 1900);
+    }
+}
@@ -0,0 +1,57 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../src/rpc_clients/jupiter_client.hpp"
+#include "test_helpers.hpp"
+
+TEST_CASE("Jupiter batched price client", "[jupiter]") {
+    SECTION("Universe is sharded into requests of at most 100 mints") {
+        std::vector<std::string> mints;
+        for (int i = 0; i < 250; i++) mints.push_back("mint" + std::to_string(i));
+
+        auto shards = JupiterClient::shard(mints, 100);
+        REQUIRE(shards.size() == 3);
+        REQUIRE(shards[0].size() == 100);
+        REQUIRE(shards[2].size() == 50);
+        REQUIRE(shards[2].back() == "mint249");
+
+        REQUIRE(JupiterClient::shard(mints, 500).size() == 3);
+        REQUIRE(JupiterClient::shard({}, 100).empty());
+    }
+
+    SECTION("Ids are comma-joined into one query") {
+        REQUIRE(JupiterClient::build_url("https://api.jup.ag/price/v2", {"A", "B"}) ==
+                "https://api.jup.ag/price/v2?ids=A,B");
+        REQUIRE(JupiterClient::build_url("https://host/price?vs=usd", {"A"}) ==
+                "https://host/price?vs=usd&ids=A");
+    }
+
+    SECTION("Parses string and numeric prices, skipping unknown mints") {
+        auto body = nlohmann::json::parse(R"({
+            "data": {
+                "A": {"id": "A", "type": "derivedPrice", "price": "1.25"},
+                "B": {"id": "B", "price": 140.5},
+                "C": null,
+                "D": {"id": "D", "price": "n/a"},
+                "E": {"id": "E", "price": "0"}
+            },
+            "timeTaken": 0.003
+        })");
+
+        auto prices = JupiterClient::parse_prices(body);
+        REQUIRE(prices.size() == 2);
+        REQUIRE(near(prices["A"], 1.25));
+        REQUIRE(near(prices["B"], 140.5));
+        REQUIRE(JupiterClient::parse_prices(nlohmann::json::object()).empty());
+    }
+
+    SECTION("Deviation converts the pool price with the quote's USD price") {
+        // 0.001 SOL at $150/SOL = $0.15 vs aggregator $0.12
+        REQUIRE(near(JupiterClient::deviation_pct(0.001, 0.12, 150.0), 25.0));
+        REQUIRE(near(JupiterClient::deviation_pct(2.0, 2.0, 1.0), 0.0));
+    }
+
+    SECTION("Unpriced mints have no deviation") {
+        JupiterClient client("https://api.jup.ag/price/v2", nullptr, 100, 4);
+        REQUIRE(client.refresh({}, 1) == 0);
+        REQUIRE(!client.deviation_pct("A", "B", 1.0).has_value());
+    }
+}
@@ -0,0 +1,124 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../src/latest_view.hpp"
+#include <algorithm>
+
+static NormalizedPool make_pool(const std::string& address, const std::string& mint) {
+    return NormalizedPool{7, address, mint, kUsdcMint, "AAA", "raydium",
+                          1.25, 400000.0, 90000.0, 0.3, 0.8, "ok"};
+}
+
+TEST_CASE("Latest view record encoding", "[latest_view]") {
+    SECTION("Pool round trip") {
+        auto blob = LatestView::encode_pool(make_pool("PoolA", "MintA"),
+                                            RouteInfo{true, 2, 0.4}, 5, 1000);
+        auto snap = LatestView::decode_pool("PoolA", blob);
+
+        REQUIRE(snap.has_value());
+        REQUIRE(snap->address == "PoolA");
+        REQUIRE(snap->mint_base == "MintA");
+        REQUIRE(snap->mint_quote == kUsdcMint);
+        REQUIRE(snap->dex == "raydium");
+        REQUIRE(snap->symbol == "AAA");
+        REQUIRE(snap->price == 1.25);
+        REQUIRE(snap->liq_usd == 400000.0);
+        REQUIRE(snap->impact_1pct_pct == 0.8);
+        REQUIRE(!snap->degraded);
+        REQUIRE(snap->route.ok);
+        REQUIRE(snap->route.hops == 2);
+        REQUIRE(snap->version == 5);
+        REQUIRE(snap->updated_ms == 1000);
+    }
+
+    SECTION("Mint round trip") {
+        MintRecord rec{};
+        rec.mint = "MintA";
+        rec.symbol = "AAA";
+        rec.price_usd = 2.5;
+        rec.liq_usd = 1e6;
+        rec.pool_count = 3;
+        rec.best_pool = "PoolB";
+        rec.best_dex = "orca";
+        rec.route = RouteInfo{false, 0, 0.0};
+        rec.dq = "degraded";
+        rec.updated_ms = 2000;
+
+        auto decoded = LatestView::decode_mint("MintA", LatestView::encode_mint(rec, 9));
+        REQUIRE(decoded.has_value());
+        REQUIRE(decoded->symbol == "AAA");
+        REQUIRE(decoded->price_usd == 2.5);
+        REQUIRE(decoded->pool_count == 3);
+        REQUIRE(decoded->best_pool == "PoolB");
+        REQUIRE(decoded->best_dex == "orca");
+        REQUIRE(decoded->dq == "degraded");
+        REQUIRE(!decoded->route.ok);
+        REQUIRE(decoded->updated_ms == 2000);
+    }
+
+    SECTION("Rejects wrong kind, format and truncation") {
+        auto blob = LatestView::encode_pool(make_pool("PoolA", "MintA"),
+                                            RouteInfo{true, 1, 0.0}, 1, 1000);
+        REQUIRE(!LatestView::decode_mint("PoolA", blob).has_value());
+        REQUIRE(!LatestView::decode_pool("PoolA", blob.substr(0, blob.size() - 1)).has_value());
+
+        std::string bumped = blob;
+        bumped[1] = static_cast<char>(LatestView::kFormatVersion + 1);
+        REQUIRE(!LatestView::decode_pool("PoolA", bumped).has_value());
+    }
+}
+
+TEST_CASE("Latest view batching", "[latest_view]") {
+    LatestView view;
+    RouteInfo route{true, 1, 0.0};
+
+    SECTION("Restaging a field within a tick keeps one upsert") {
+        view.stage_pool(make_pool("PoolA", "MintA"), route, 1000);
+        view.stage_pool(make_pool("PoolA", "MintA"), route, 1500);
+        view.stage_pool(make_pool("PoolB", "MintA"), route, 1500);
+
+        auto batch = view.take_batch();
+        REQUIRE(batch.version == 1);
+        REQUIRE(batch.upserts.size() == 2);
+        REQUIRE(view.field_count() == 2);
+
+        auto next = view.take_batch();
+        REQUIRE(next.version == 2);
+        REQUIRE(next.upserts.empty());
+    }
+
+    SECTION("Prune deletes fields not rewritten") {
+        view.stage_pool(make_pool("PoolA", "MintA"), route, 1000);
+        view.stage_pool(make_pool("PoolB", "MintA"), route, 5000);
+        view.take_batch();
+
+        REQUIRE(view.prune(2000) == 1);
+        auto batch = view.take_batch();
+        REQUIRE(batch.deletes == std::vector<std::string>{LatestView::pool_field("PoolA")});
+        REQUIRE(view.field_count() == 1);
+    }
+
+    SECTION("Failed write is requeued without clobbering newer fields") {
+        view.stage_pool(make_pool("PoolA", "MintA"), route, 1000);
+        auto failed = view.take_batch();
+
+        view.stage_pool(make_pool("PoolA", "MintA"), route, 2000);
+        view.requeue(std::move(failed));
+
+        auto batch = view.take_batch();
+        REQUIRE(batch.upserts.size() == 1);
+        auto snap = LatestView::decode_pool("PoolA", batch.upserts[0].second);
+        REQUIRE(snap->updated_ms == 2000);
+    }
+
+    SECTION("Resume continues the version and prunes leftovers") {
+        view.resume(41, {"_version", LatestView::pool_field("Old")}, 1000);
+        REQUIRE(view.field_count() == 1);
+
+        view.stage_pool(make_pool("PoolA", "MintA"), route, 5000);
+        view.prune(2000);
+        auto batch = view.take_batch();
+
+        REQUIRE(batch.version == 42);
+        REQUIRE(batch.deletes == std::vector<std::string>{LatestView::pool_field("Old")});
+        REQUIRE(LatestView::decode_pool("PoolA", batch.upserts[0].second)->version == 42);
+    }
+}
@@ -0,0 +1,79 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../src/metrics.hpp"
+
+TEST_CASE("Latency histogram buckets", "[metrics]") {
+    SECTION("Small values map to exact buckets") {
+        for (uint64_t v = 0; v < 8; v++) {
+            REQUIRE(LatencyHistogram::bucket_index(v) == static_cast<int>(v));
+            REQUIRE(LatencyHistogram::bucket_upper_us(static_cast<int>(v)) == v);
+        }
+    }
+
+    SECTION("Every value falls at or below its bucket bound, within 12.5%") {
+        for (uint64_t v : {8ULL, 9ULL, 15ULL, 16ULL, 1000ULL, 123456ULL, 60000000ULL}) {
+            int idx = LatencyHistogram::bucket_index(v);
+            uint64_t upper = LatencyHistogram::bucket_upper_us(idx);
+            REQUIRE(v <= upper);
+            REQUIRE(upper - v <= v / 8);
+            if (idx > 0) {
+                REQUIRE(LatencyHistogram::bucket_upper_us(idx - 1) < v);
+            }
+        }
+    }
+
+    SECTION("Huge values land in the last bucket") {
+        REQUIRE(LatencyHistogram::bucket_index(~0ULL) == LatencyHistogram::kBucketCount - 1);
+    }
+}
+
+TEST_CASE("Latency histogram quantiles", "[metrics]") {
+    LatencyHistogram hist;
+    REQUIRE(hist.quantile_us(0.99) == 0);
+
+    for (uint64_t v = 1; v <= 1000; v++) {
+        hist.record(v * 100);
+    }
+
+    REQUIRE(hist.count() == 1000);
+    REQUIRE(hist.sum_us() == 50050000);
+
+    uint64_t p50 = hist.quantile_us(0.5);
+    REQUIRE(p50 >= 50000);
+    REQUIRE(p50 <= 50000 + 50000 / 8);
+
+    uint64_t p99 = hist.quantile_us(0.99);
+    REQUIRE(p99 >= 99000);
+    REQUIRE(p99 <= 99000 + 99000 / 8);
+
+    REQUIRE(hist.count_at_or_below(7) == 0);
+    REQUIRE(hist.count_at_or_below(1000000) == 1000);
+}
+
+TEST_CASE("Prometheus rendering", "[metrics]") {
+    IngestMetrics metrics;
+    metrics.stage(Stage::Tick).record(250000);
+    metrics.ticks_total = 3;
+    metrics.tracked_pools = 42;
+
+    std::map<std::string, HostStats> hosts;
+    hosts["api.raydium.io"] = HostStats{"open", 1, {{"2xx", 10}, {"429", 2}}};
+
+    auto text = metrics.render_prometheus(hosts, 17, {{"soul.market.mints.0", 5}, {"soul.market.mints.1", 9}});
+
+    REQUIRE(text.find("# TYPE ingestor_stage_latency_seconds histogram") != std::string::npos);
+    REQUIRE(text.find("ingestor_stage_latency_seconds_bucket{stage=\"tick\",le=\"0.25\"} 0") != std::string::npos);
+    REQUIRE(text.find("ingestor_stage_latency_seconds_bucket{stage=\"tick\",le=\"0.5\"} 1") != std::string::npos);
+    REQUIRE(text.find("ingestor_stage_latency_seconds_count{stage=\"tick\"} 1") != std::string::npos);
+    REQUIRE(text.find("ingestor_ticks_total 3") != std::string::npos);
+    REQUIRE(text.find("ingestor_tracked_pools 42") != std::string::npos);
+    REQUIRE(text.find("ingestor_market_stream_length 17") != std::string::npos);
+    REQUIRE(text.find("ingestor_mint_stream_length{stream=\"soul.market.mints.1\"} 9") != std::string::npos);
+    REQUIRE(text.find("ingestor_http_responses_total{host=\"api.raydium.io\",status=\"429\"} 2") != std::string::npos);
+    REQUIRE(text.find("ingestor_http_breaker_open{host=\"api.raydium.io\",state=\"open\"} 1") != std::string::npos);
+
+    SECTION("Stream length is omitted when Redis is unreachable") {
+        auto degraded = metrics.render_prometheus({}, -1, {});
+        REQUIRE(degraded.find("ingestor_market_stream_length") == std::string::npos);
+        REQUIRE(degraded.find("ingestor_mint_stream_length") == std::string::npos);
+    }
+}
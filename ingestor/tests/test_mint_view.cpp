@@ -0,0 +1,102 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../src/mint_view.hpp"
+#include "test_helpers.hpp"
+
+static NormalizedPool make_pool(const std::string& address, const std::string& mint,
+                                const std::string& quote, const std::string& dex,
+                                double price, double liq_usd, double spread, double impact) {
+    NormalizedPool p;
+    p.pool_id = 0;
+    p.address = address;
+    p.mint_base = mint;
+    p.mint_quote = quote;
+    p.symbol = "BONK";
+    p.dex = dex;
+    p.price = price;
+    p.liq_usd = liq_usd;
+    p.vol24h_usd = liq_usd * 2.0;
+    p.spread_pct = spread;
+    p.impact_1pct_pct = impact;
+    p.dq = "ok";
+    return p;
+}
+
+TEST_CASE("Mint view consolidation", "[mint_view]") {
+    MintView view;
+    RouteInfo route{true, 1, 0.5};
+
+    SECTION("Pools across DEXes and quotes fold into one record") {
+        view.update_pool(make_pool("sol-usdc", kSolMint, kUsdcMint, "raydium",
+                                   100.0, 1000000.0, 0.1, 0.1), route, 1000);
+        view.update_pool(make_pool("r1", "BONK", kUsdcMint, "raydium",
+                                   1.00, 300000.0, 0.5, 0.5), route, 1000);
+        view.update_pool(make_pool("o1", "BONK", kSolMint, "orca",
+                                   0.0102, 100000.0, 0.2, 0.3), route, 1000);
+
+        auto dirty = view.take_dirty(1000);
+        REQUIRE(dirty.size() == 2);
+
+        auto rec = view.get("BONK");
+        REQUIRE(rec.has_value());
+        REQUIRE(rec->pool_count == 2);
+        REQUIRE(rec->symbol == "BONK");
+        REQUIRE(near(rec->liq_usd, 400000.0));
+        REQUIRE(near(rec->vol24h_usd, 800000.0));
+
+        // (1.00 * 300k + 1.02 * 100k) / 400k, SOL priced at $100
+        REQUIRE(near(rec->price_usd, 1.005));
+        REQUIRE(near(rec->xdex_spread_pct, 0.02 / 1.005 * 100.0));
+
+        // Orca pool is cheaper to execute in
+        REQUIRE(rec->best_pool == "o1");
+        REQUIRE(rec->best_dex == "orca");
+        REQUIRE(near(rec->spread_pct, 0.2));
+        REQUIRE(rec->dq == "ok");
+    }
+
+    SECTION("Only touched mints are handed out") {
+        view.update_pool(make_pool("a", "A", kUsdcMint, "raydium", 1.0, 50000.0, 1, 1), route, 1000);
+        view.update_pool(make_pool("b", "B", kUsdcMint, "raydium", 1.0, 50000.0, 1, 1), route, 1000);
+        REQUIRE(view.take_dirty(1000).size() == 2);
+        REQUIRE(view.take_dirty(1000).empty());
+
+        view.update_pool(make_pool("a", "A", kUsdcMint, "raydium", 1.1, 50000.0, 1, 1), route, 2000);
+        auto dirty = view.take_dirty(2000);
+        REQUIRE(dirty.size() == 1);
+        REQUIRE(dirty[0].mint == "A");
+        REQUIRE(near(dirty[0].price_usd, 1.1));
+    }
+
+    SECTION("Unpriceable quotes leave the record degraded") {
+        view.update_pool(make_pool("x", "X", "SOMEQUOTE", "orca", 3.0, 80000.0, 1, 1), route, 1000);
+        view.take_dirty(1000);
+        REQUIRE(view.get("X")->dq == "degraded");
+        REQUIRE(near(view.get("X")->price_usd, 0.0));
+    }
+
+    SECTION("Pruned pools drop out and empty mints disappear") {
+        view.update_pool(make_pool("p1", "C", kUsdcMint, "raydium", 2.0, 100000.0, 1, 1), route, 1000);
+        view.update_pool(make_pool("p2", "C", kUsdcMint, "orca", 2.0, 100000.0, 1, 1), route, 5000);
+        view.take_dirty(5000);
+
+        REQUIRE(view.prune(2000) == 1);
+        auto dirty = view.take_dirty(6000);
+        REQUIRE(dirty.size() == 1);
+        REQUIRE(dirty[0].pool_count == 1);
+
+        REQUIRE(view.prune(10000) == 1);
+        REQUIRE(view.mint_count() == 0);
+        REQUIRE_FALSE(view.get("C").has_value());
+    }
+
+    SECTION("Message carries the consolidated fields") {
+        view.update_pool(make_pool("r1", "BONK", kUsdcMint, "raydium", 1.0, 300000.0, 0.5, 0.5), route, 1000);
+        auto rec = view.take_dirty(1000).at(0);
+        auto j = MintView::to_json(rec);
+        REQUIRE(j["mint"] == "BONK");
+        REQUIRE(j["pools"] == 1);
+        REQUIRE(j["pool"] == "r1");
+        REQUIRE(j["route"]["hops"] == 1);
+        REQUIRE(j.contains("xdex_spread_pct"));
+    }
+}
@@ -0,0 +1,45 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../src/pool_tracker.hpp"
+
+namespace {
+
+PoolData make_pool(const std::string& address, double liq_usd) {
+    return PoolData{address, "base", "quote", "", 1.0, liq_usd, 0.0, 0.0, 0.0};
+}
+
+} // namespace
+
+TEST_CASE("Pool tracker", "[pool_tracker]") {
+    PoolTracker tracker(600, 25000.0);
+    int64_t now = 1000000000000;
+
+    SECTION("Discovery pass spans pages and then waits for the interval") {
+        REQUIRE(tracker.discovery_due(now));
+
+        PoolPage first{{make_pool("a", 50000.0), make_pool("dust", 100.0)}, "2", true};
+        REQUIRE(tracker.add_page(first, now) == 1);
+        REQUIRE(tracker.cursor() == "2");
+        REQUIRE(tracker.discovery_due(now));
+
+        PoolPage last{{make_pool("b", 30000.0), make_pool("a", 50000.0)}, "", true};
+        REQUIRE(tracker.add_page(last, now) == 1);
+        REQUIRE(tracker.cursor().empty());
+        REQUIRE(tracker.size() == 2);
+
+        REQUIRE_FALSE(tracker.discovery_due(now + 1000));
+        REQUIRE(tracker.discovery_due(now + 600000));
+    }
+
+    SECTION("Failed page keeps the cursor") {
+        tracker.add_page(PoolPage{{make_pool("a", 50000.0)}, "2", true}, now);
+        tracker.add_page(PoolPage{{}, "", false}, now);
+
+        REQUIRE(tracker.cursor() == "2");
+        REQUIRE(tracker.discovery_due(now));
+    }
+
+    SECTION("Pools are dropped with hysteresis") {
+        REQUIRE_FALSE(tracker.should_untrack(make_pool("a", 20000.0)));
+        REQUIRE(tracker.should_untrack(make_pool("a", 10000.0)));
+    }
+}
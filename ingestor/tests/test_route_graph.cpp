@@ -0,0 +1,69 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../src/route_graph.hpp"
+#include "test_helpers.hpp"
+
+TEST_CASE("Route graph best paths", "[route_graph]") {
+    // $1000 reference trade: a $200k pool costs 1%, a $2M pool 0.1%
+    RouteGraph graph(3, 1000.0, 10000.0);
+
+    SECTION("Direct USDC pool is one hop") {
+        graph.upsert_pool("p1", "BONK", kUsdcMint, 0.00002, 200000.0, 0);
+        graph.recompute();
+
+        auto route = graph.route_to_usdc("BONK");
+        REQUIRE(route.ok);
+        REQUIRE(route.hops == 1);
+        REQUIRE(near(route.dev_pct, 1.0));
+        REQUIRE_FALSE(graph.route_to_sol("BONK").ok);
+    }
+
+    SECTION("Deeper two-hop route beats a shallow direct pool") {
+        graph.upsert_pool("thin", "WIF", kUsdcMint, 2.0, 20000.0, 0);        // 10%
+        graph.upsert_pool("deep1", "WIF", kSolMint, 0.01, 2000000.0, 0);     // 0.1%
+        graph.upsert_pool("deep2", kSolMint, kUsdcMint, 150.0, 2000000.0, 0); // 0.1%
+        graph.recompute();
+
+        auto route = graph.route_to_usdc("WIF");
+        REQUIRE(route.ok);
+        REQUIRE(route.hops == 2);
+        REQUIRE(near(route.dev_pct, 0.2));
+
+        auto best = graph.best_route("WIF");
+        REQUIRE(best.hops == 1);
+        REQUIRE(near(best.dev_pct, 0.1));
+    }
+
+    SECTION("Routes longer than max hops are unreachable") {
+        graph.upsert_pool("a", "A", "B", 1.0, 200000.0, 0);
+        graph.upsert_pool("b", "B", "C", 1.0, 200000.0, 0);
+        graph.upsert_pool("c", "C", "D", 1.0, 200000.0, 0);
+        graph.upsert_pool("d", "D", kUsdcMint, 1.0, 200000.0, 0);
+        graph.recompute();
+
+        REQUIRE(graph.route_to_usdc("B").hops == 3);
+        REQUIRE_FALSE(graph.route_to_usdc("A").ok);
+    }
+
+    SECTION("Updates, removals and pruning are incremental") {
+        graph.upsert_pool("p1", "JUP", kUsdcMint, 1.0, 200000.0, 1000);
+        graph.upsert_pool("p2", "JUP", kSolMint, 0.005, 200000.0, 1000);
+        graph.recompute();
+        REQUIRE(graph.pool_count() == 2);
+
+        // Liquidity drained below the floor drops the edge
+        graph.upsert_pool("p1", "JUP", kUsdcMint, 1.0, 5000.0, 2000);
+        graph.recompute();
+        REQUIRE(graph.pool_count() == 1);
+        REQUIRE_FALSE(graph.route_to_usdc("JUP").ok);
+
+        REQUIRE(graph.prune(1500) == 1);
+        graph.recompute();
+        REQUIRE(graph.pool_count() == 0);
+        REQUIRE_FALSE(graph.best_route("JUP").ok);
+    }
+
+    SECTION("Unknown mints have no route") {
+        graph.recompute();
+        REQUIRE_FALSE(graph.best_route("NOPE").ok);
+    }
+}
@@ -0,0 +1,18 @@
+#include <catch2/catch_test_macros.hpp>
+#include "../src/util.hpp"
+
+// Analytics keeps its own copy of these; its suite checks the same vectors
+TEST_CASE("Partition hashing uses fixed vectors shared with analytics", "[util]") {
+    // Published FNV-1a 64-bit vectors
+    REQUIRE(util::fnv1a_64("") == 0xcbf29ce484222325ULL);
+    REQUIRE(util::fnv1a_64("a") == 0xaf63dc4c8601ec8cULL);
+    REQUIRE(util::fnv1a_64("foobar") == 0x85944171f73967e8ULL);
+    REQUIRE(util::fnv1a_64_update(util::fnv1a_64_update(util::kFnv1aOffset, "foo", 3), "bar", 3) ==
+            0x85944171f73967e8ULL);
+
+    REQUIRE(util::mint_partition("So11111111111111111111111111111111111111112", 8) == 7);
+    REQUIRE(util::mint_partition("EPjFWdd5AufqSSqeM2qN1xzybapC8G4wEGGkZwyTDt1v", 8) == 4);
+    REQUIRE(util::mint_partition("EPjFWdd5AufqSSqeM2qN1xzybapC8G4wEGGkZwyTDt1v", 3) == 1);
+    REQUIRE(util::partition_stream("soul.market.mints", 0, 1) == "soul.market.mints");
+    REQUIRE(util::partition_stream("soul.market.mints", 7, 8) == "soul.market.mints.7");
+}
@@ -42,6 +42,16 @@ void setup_logging(const std::string& log_level) {
     spdlog::set_pattern("[%Y-%m-%d %H:%M:%S.%e] [%^%l%$] %v");
 }
 
+// Held mints get refresh priority in the ingestor's request budget for a day
+void mark_held_mints(RedisBus& redis, const Config& config,
+                     const std::vector<Holding>& holdings) {
+    std::vector<std::string> mints;
+    for (const auto& h : holdings) {
+        if (h.amount > 0) mints.push_back(h.mint);
+    }
+    redis.mark_priority_mints(config.priority_mints_key, mints, 24LL * 3600 * 1000);
+}
+
 void handle_balance_command(const nlohmann::json& cmd,
                             SolanaRPC& rpc,
                             PriceOracle& oracle,
@@ -93,6 +103,7 @@ void handle_balance_command(const nlohmann::json& cmd,
         
         // Value portfolio
         auto summary = valuator.value_portfolio(all_holdings);
+        mark_held_mints(redis, config, summary.holdings);
         
         // Save snapshot (use first wallet for now)
         // In production, handle multi-wallet properly
@@ -184,6 +195,7 @@ void handle_holdings_command(const nlohmann::json& cmd,
         }
         
         auto summary = valuator.value_portfolio(all_holdings);
+        mark_held_mints(redis, config, summary.holdings);
         
         // Build holdings list (top N)
         std::string message = "📊 Top Holdings\n\n";
@@ -1,5 +1,6 @@
 #include "redis_bus.hpp"
 #include <spdlog/spdlog.h>
+#include <chrono>
 
 RedisBus::RedisBus(const std::string& redis_url) {
     try {
@@ -79,6 +80,24 @@ void RedisBus::publish_audit(const std::string& stream, const nlohmann::json& da
     }
 }
 
+void RedisBus::mark_priority_mints(const std::string& key,
+                                   const std::vector<std::string>& mints, int64_t ttl_ms) {
+    if (key.empty() || mints.empty()) return;
+    try {
+        auto now_ms = std::chrono::duration_cast<std::chrono::milliseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        auto expiry = static_cast<double>(now_ms + ttl_ms);
+        std::vector<std::pair<std::string, double>> members;
+        members.reserve(mints.size());
+        for (const auto& mint : mints) {
+            members.emplace_back(mint, expiry);
+        }
+        redis_->zadd(key, members.begin(), members.end());
+    } catch (const std::exception& e) {
+        spdlog::warn("Failed to mark priority mints: {}", e.what());
+    }
+}
+
 void RedisBus::ack_message(const std::string& stream, const std::string& group,
                           const std::string& msg_id) {
     try {
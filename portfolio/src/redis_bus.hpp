@@ -1,5 +1,6 @@
 #pragma once
 
+#include <cstdint>
 #include <string>
 #include <memory>
 #include <optional>
@@ -20,6 +21,10 @@ public:
     void publish_reply(const std::string& stream, const nlohmann::json& data);
     void publish_audit(const std::string& stream, const nlohmann::json& data);
     
+    // ZADD mints to the ingestor's refresh-priority set, each expiring after ttl_ms
+    void mark_priority_mints(const std::string& key, const std::vector<std::string>& mints,
+                             int64_t ttl_ms);
+    
     void ack_message(const std::string& stream, const std::string& group,
                     const std::string& msg_id);
     